@@ -0,0 +1,145 @@
+#include "Benchmark.h"
+#include "HeadlessUI.h"
+#include "BuildQueue.h"
+#include "Threading.h"
+#include "FileSystem.h"
+#include "JsonStream.h"
+#include "Windows.h"
+
+#include <cstdio>
+#include <fstream>
+
+//NOTE(CSH): fails when an idle frame of the main window or a config load/save cycle allocates more than the
+//checked in counts plus the headroom so allocations that sneak into them are noticed. The counts depend on the
+//standard library and the build, the file says what they were measured with and another toolchain only prints
+//its counts. -update measures this build and writes its counts into the file
+
+struct AllocationBudget {
+    s32 configEntries = 1000;
+    s32 warmUpFrames = 60;
+    s32 frames = 600;
+    s32 headroomPercent = 10;
+    std::string measuredWith;
+    u64 frameAllocations = 0;
+    u64 configLoadAllocations = 0;
+    u64 configSaveAllocations = 0;
+};
+
+const JsonField<AllocationBudget> allocationBudgetFields[] = {
+    JsonMember<&AllocationBudget::configEntries>("Config Entries"),
+    JsonMember<&AllocationBudget::configLoadAllocations>("Config Load Allocations"),
+    JsonMember<&AllocationBudget::configSaveAllocations>("Config Save Allocations"),
+    JsonMember<&AllocationBudget::frameAllocations>("Frame Allocations"),
+    JsonMember<&AllocationBudget::frames>("Frames"),
+    JsonMember<&AllocationBudget::headroomPercent>("Headroom Percent"),
+    JsonMember<&AllocationBudget::measuredWith>("Measured With"),
+    JsonMember<&AllocationBudget::warmUpFrames>("Warm Up Frames"),
+};
+
+//Compiler, version and configuration, allocation counts are only comparable between identical ones
+std::string BuildToolchain()
+{
+#if defined(_MSC_VER)
+    std::string toolchain = ToString("MSVC %i", _MSC_VER);
+#elif defined(__clang__)
+    std::string toolchain = ToString("Clang %i", __clang_major__);
+#elif defined(__GNUC__)
+    std::string toolchain = ToString("GCC %i", __GNUC__);
+#else
+    std::string toolchain = "Unknown";
+#endif
+#if defined(DEBUG)
+    return toolchain + " Debug";
+#elif defined(TRACY_ENABLE)
+    return toolchain + " Profile";
+#else
+    return toolchain + " Release";
+#endif
+}
+
+bool CheckBudget(const char* name, u64 allocations, u64 measured, s32 headroomPercent)
+{
+    u64 budget = measured + measured * Max(headroomPercent, 0) / 100;
+    bool within = allocations <= budget;
+    printf("%-24s %10llu allocations %10llu budget %s\n", name, (unsigned long long)allocations, (unsigned long long)budget, within ? "" : "OVER BUDGET");
+    return within;
+}
+
+s32 RunAllocationBudget(const char* budgetFile, bool update)
+{
+    std::string budgetText;
+    if (!ReadEntireFile(budgetFile, budgetText))
+    {
+        printf("couldn't read %s\n", budgetFile);
+        return 1;
+    }
+    AllocationBudget budget;
+    JsonReader r(budgetText);
+    if (!JsonReadObject(r, budget, allocationBudgetFields))
+    {
+        printf("%s isn't valid json\n", budgetFile);
+        return 1;
+    }
+
+    //idle frames of the main window with a config loaded
+    Threading& threading = Threading::GetInstance();
+    BuildQueue buildQueue;
+    AppSettings appSettings;
+    Settings settings = GenerateConfig(100);
+    UIState ui;
+    HeadlessInit();
+    HeadlessWarmUp(ui, settings, appSettings, buildQueue, threading, budget.warmUpFrames);
+    u64 worstFrame = 0;
+    for (s32 i = 0; i < budget.frames; i++)
+    {
+        AllocationCounts before = GetThreadAllocations();
+        HeadlessFrame(ui, settings, appSettings, buildQueue, threading);
+        worstFrame = Max(worstFrame, (GetThreadAllocations() - before).allocations);
+    }
+    HeadlessShutdown();
+
+    //the first cycle interns the names, the ones after it are what every load and save costs
+    Settings config = GenerateConfig(budget.configEntries);
+    std::string configText = WriteConfigText(config);
+    Settings loaded;
+    ReadConfigText(configText, loaded);
+    BenchmarkResult load = Measure(1, [&]() { ReadConfigText(configText, loaded); });
+    BenchmarkResult save = Measure(1, [&]() { configText = WriteConfigText(loaded); });
+
+    std::string toolchain = BuildToolchain();
+    if (update)
+    {
+        budget.measuredWith = toolchain;
+        budget.frameAllocations = worstFrame;
+        budget.configLoadAllocations = load.allocations;
+        budget.configSaveAllocations = save.allocations;
+        JsonWriter w;
+        JsonWriteObject(w, budget, allocationBudgetFields);
+        w.m_out += '\n';
+        std::ofstream o(budgetFile);
+        o << w.m_out;
+        if (o.fail())
+        {
+            printf("couldn't write %s\n", budgetFile);
+            return 1;
+        }
+        printf("%s measured with %s: frame %llu, config load %llu, config save %llu\n", budgetFile, toolchain.c_str(),
+            (unsigned long long)worstFrame, (unsigned long long)load.allocations, (unsigned long long)save.allocations);
+        return 0;
+    }
+
+    //counts from another standard library or configuration say nothing about this one, they are printed but not checked
+    if (budget.measuredWith != toolchain)
+    {
+        printf("frame (worst) %llu, config load %llu, config save %llu allocations\n",
+            (unsigned long long)worstFrame, (unsigned long long)load.allocations, (unsigned long long)save.allocations);
+        printf("NOT CHECKED: %s was measured with \"%s\" but this is \"%s\", run \"UATHelperBench allocations %s -update\" on this build and commit the file\n",
+            budgetFile, budget.measuredWith.c_str(), toolchain.c_str(), budgetFile);
+        return 0;
+    }
+    bool passed = true;
+    passed &= CheckBudget("frame (worst)", worstFrame, budget.frameAllocations, budget.headroomPercent);
+    passed &= CheckBudget("config load", load.allocations, budget.configLoadAllocations, budget.headroomPercent);
+    passed &= CheckBudget("config save", save.allocations, budget.configSaveAllocations, budget.headroomPercent);
+    return passed ? 0 : 1;
+}
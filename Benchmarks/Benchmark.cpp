@@ -0,0 +1,81 @@
+#include "Benchmark.h"
+#include "Windows.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+Settings GenerateConfig(s32 entryCount)
+{
+    Settings settings;
+    settings.rootPath = "D:\\UnrealEngine\\Engine";
+    settings.projectPath = "D:\\Projects\\Benchmark\\Benchmark.uproject";
+    for (s32 i = 0; i < entryCount / 10; i++)
+        settings.versionOptions.push_back(ToString("Version%i", i));
+    for (s32 i = 0; i < entryCount * 7 / 10; i++)
+        settings.switchOptions.push_back(ToString("AdditionalCookerOptions=\"-ddc=noshared -option%i\"", i));
+    for (s32 i = 0; i < entryCount / 10; i++)
+    {
+        settings.preBuildEvents.Add(ToString("@copy \"{Project}\\Saved\\StagedBuilds\\%i\" \"D:\\Out\\%i\"", i, i));
+        BuildEvent* be = settings.postBuildEvents.Add(ToString("C:\\Tools\\post_build_%i.bat", i));
+        if (i % 4 == 0)
+            be->process.priority = ProcessPriority_BelowNormal;
+    }
+    for (s32 i = 0; i < 8; i++)
+        settings.fatalPatterns.push_back({ ToString("Error: pattern %i", i), i + 1 });
+    settings.uatProcess.useJobObject = true;
+    settings.uatProcess.memoryLimitMB = 32000;
+
+    //the platforms grow with the rest of the config
+    const s32 platformCount = Max(entryCount / 32, 4);
+    for (s32 p = 0; p < platformCount; p++)
+    {
+        PlatformSettings& platform = settings.platformOptions.emplace_back();
+        platform.name = ToString("Platform%02i", p);
+        for (s32 i = p; i < settings.versionOptions.size(); i += platformCount)
+            platform.enabledVersions.push_back(i);
+        for (s32 i = p; i < settings.switchOptions.size(); i += platformCount / 4)
+            platform.enabledSwitches.push_back(i);
+        for (s32 i = p; i < settings.preBuildEvents.m_events.size(); i += platformCount)
+            platform.enabledPreBuild.push_back(settings.preBuildEvents.m_events[i].id);
+        for (s32 i = p; i < settings.postBuildEvents.m_events.size(); i += platformCount)
+            platform.enabledPostBuild.push_back(settings.postBuildEvents.m_events[i].id);
+    }
+    SortConfig(settings);
+    return settings;
+}
+
+void Print(const char* name, const BenchmarkResult& result)
+{
+    printf("%-22s %10.3f ms %12llu allocations %12.2f MB\n", name, result.milliseconds,
+        (unsigned long long)result.allocations, f64(result.allocatedBytes) / (1024.0 * 1024.0));
+}
+
+int main(int argc, char** argv)
+{
+    const char* mode = argc > 1 ? argv[1] : "config";
+    if (strcmp(mode, "config") == 0)
+        return RunConfigBenchmark(argc > 2 ? atoi(argv[2]) : 10000, argc > 3 ? atoi(argv[3]) : 20);
+    if (strcmp(mode, "frames") == 0)
+        return RunFrameBenchmark(argc > 2 ? Max(atoi(argv[2]), 1) : 600);
+    if (strcmp(mode, "replay") == 0 && argc > 2)
+        return RunReplay(argv[2]);
+    if (strcmp(mode, "allocations") == 0)
+    {
+        const char* budgetFile = "Benchmarks/AllocationBudget.json";
+        bool update = false;
+        for (s32 i = 2; i < argc; i++)
+        {
+            if (strcmp(argv[i], "-update") == 0)
+                update = true;
+            else
+                budgetFile = argv[i];
+        }
+        return RunAllocationBudget(budgetFile, update);
+    }
+    printf("UATHelperBench config [entries] [iterations]\n");
+    printf("UATHelperBench frames [frames]\n");
+    printf("UATHelperBench replay <recording>\n");
+    printf("UATHelperBench allocations [budget file] [-update]\n");
+    return 1;
+}
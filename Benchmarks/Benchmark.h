@@ -0,0 +1,55 @@
+#pragma once
+#include "Math.h"
+#include "Config.h"
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+//entryCount options spread over versions, switches and build events and one platform per 32 entries (at least 4),
+//every platform enables a slice of them
+Settings GenerateConfig(s32 entryCount);
+
+struct BenchmarkResult {
+    f64 milliseconds = 0;
+    u64 allocations = 0;
+    u64 allocatedBytes = 0;
+};
+
+//Average of iterations calls, allocations are the ones made by this thread
+template <typename F>
+BenchmarkResult Measure(s32 iterations, F&& func)
+{
+    AllocationCounts before = GetThreadAllocations();
+    auto start = std::chrono::steady_clock::now();
+    for (s32 i = 0; i < iterations; i++)
+        func();
+    auto end = std::chrono::steady_clock::now();
+    AllocationCounts allocations = GetThreadAllocations() - before;
+    BenchmarkResult result;
+    result.milliseconds = std::chrono::duration<f64, std::milli>(end - start).count() / iterations;
+    result.allocations = allocations.allocations / iterations;
+    result.allocatedBytes = allocations.bytes / iterations;
+    return result;
+}
+
+void Print(const char* name, const BenchmarkResult& result);
+
+//Nearest rank of sorted, percent from 0 to 100
+template <typename T>
+T Percentile(const std::vector<T>& sorted, f64 percent)
+{
+    if (sorted.empty())
+        return T();
+    size_t index = size_t(percent / 100.0 * f64(sorted.size() - 1) + 0.5);
+    return sorted[Min(index, sorted.size() - 1)];
+}
+
+s32 RunConfigBenchmark(s32 entryCount, s32 iterations);
+//Frame time percentiles and draw list sizes of the headless UI for configs of 10 to 10000 switches
+s32 RunFrameBenchmark(s32 frames);
+//Feeds a session recorded with UATHelper -record to the headless UI as fast as it runs
+s32 RunReplay(const char* recordingFile);
+//Returns 1 when something allocates more than budgetFile allows, update writes the counts of this build into it instead
+s32 RunAllocationBudget(const char* budgetFile, bool update);
@@ -0,0 +1,248 @@
+#include "Benchmark.h"
+#include "Config.h"
+#include "ConfigSnapshot.h"
+#include "FileSystem.h"
+#include "JsonStream.h"
+#include "Windows.h"
+
+#include "json.hpp"
+
+#include <cstdio>
+
+//NOTE(CSH): compares the streaming config reader/writer against the nlohmann DOM code it replaced
+
+extern const char* platformSelectionText;
+extern const char* rootPathText;
+extern const char* projectPathText;
+extern const char* versionOptionsText;
+extern const char* switchOptionsText;
+extern const char* preBuildEventsText;
+extern const char* postBuildEventsText;
+extern const char* platformOptionsText;
+extern const char* versionText;
+extern const char* enabledVersionsText;
+extern const char* enabledSwitchesText;
+extern const char* enabledPreBuildText;
+extern const char* enabledPostBuildText;
+extern const char* uatProcessText;
+extern const char* preBuildProcessText;
+extern const char* postBuildProcessText;
+extern const char* priorityText;
+extern const char* affinityMaskText;
+extern const char* useJobObjectText;
+extern const char* cpuRatePercentText;
+extern const char* memoryLimitMBText;
+extern const char* fatalPatternsText;
+extern const char* patternText;
+extern const char* countText;
+
+//The DOM based SaveConfig/ParseConfigFile as they were before the streaming reader/writer
+namespace Legacy {
+
+void AddNames(nlohmann::json& root, const char* option, const std::vector<s32>& data, const std::vector<std::string>& names)
+{
+    for (s32 i : data)
+        root[option].push_back(names[i]);
+}
+void AddNames(nlohmann::json& root, const char* option, const std::vector<s32>& IDs, const BuildEvents& be)
+{
+    BuildEvent b;
+    for (s32 id : IDs)
+    {
+        if (be.Get(b, id))
+            root[option].push_back(b.name);
+    }
+}
+void AddProcessSettings(nlohmann::json& j, const ProcessSettings& process)
+{
+    j[priorityText]         = process.priority;
+    j[affinityMaskText]     = process.affinityMask;
+    j[useJobObjectText]     = process.useJobObject;
+    j[cpuRatePercentText]   = process.cpuRatePercent;
+    j[memoryLimitMBText]    = process.memoryLimitMB;
+}
+void AddBuildEvents(nlohmann::json& j, const char* name, const char* processName, const BuildEvents& events)
+{
+    for (const BuildEvent& be : events.m_events)
+    {
+        j[name].push_back(be.name);
+        if (be.process != ProcessSettings())
+            AddProcessSettings(j[processName][be.name], be.process);
+    }
+}
+
+std::string Save(const Settings& settings)
+{
+    nlohmann::json j;
+    j[versionText]              = settings.version;
+    j[platformSelectionText]    = settings.platformSelection;
+    j[rootPathText]             = settings.rootPath;
+    j[projectPathText]          = settings.projectPath;
+    for (const PlatformSettings& set : settings.platformOptions)
+    {
+        nlohmann::json& p = j[platformOptionsText][set.name];
+        AddNames(p, enabledVersionsText,    set.enabledVersions,    settings.versionOptions);
+        AddNames(p, enabledSwitchesText,    set.enabledSwitches,    settings.switchOptions);
+        AddNames(p, enabledPreBuildText,    set.enabledPreBuild,    settings.preBuildEvents);
+        AddNames(p, enabledPostBuildText,   set.enabledPostBuild,   settings.postBuildEvents);
+    }
+    j[versionOptionsText] = settings.versionOptions;
+    j[switchOptionsText]  = settings.switchOptions;
+    AddBuildEvents(j, preBuildEventsText,   preBuildProcessText,    settings.preBuildEvents);
+    AddBuildEvents(j, postBuildEventsText,  postBuildProcessText,   settings.postBuildEvents);
+    AddProcessSettings(j[uatProcessText], settings.uatProcess);
+    j[fatalPatternsText] = nlohmann::json::array();
+    for (const FatalLogPattern& pattern : settings.fatalPatterns)
+    {
+        nlohmann::json p;
+        p[patternText]  = pattern.text;
+        p[countText]    = pattern.count;
+        j[fatalPatternsText].push_back(p);
+    }
+    return j.dump(4) + '\n';
+}
+
+bool Valid(const nlohmann::json& root, const char* text)
+{
+    return (root.contains(text) && !root[text].is_null());
+}
+template <typename T>
+void GetTypeFromValid(const nlohmann::json& root, const char* name, T& var)
+{
+    if (Valid(root, name))
+        var = root[name].get<T>();
+}
+void GetProcessSettings(const nlohmann::json& j, ProcessSettings& process)
+{
+    GetTypeFromValid<s32>(  j, priorityText,        process.priority);
+    GetTypeFromValid<u64>(  j, affinityMaskText,    process.affinityMask);
+    GetTypeFromValid<bool>( j, useJobObjectText,    process.useJobObject);
+    GetTypeFromValid<s32>(  j, cpuRatePercentText,  process.cpuRatePercent);
+    GetTypeFromValid<s32>(  j, memoryLimitMBText,   process.memoryLimitMB);
+}
+s32 FindStringInArray(const std::string& s, const std::vector<std::string>& data)
+{
+    for (s32 i = 0; i < data.size(); i++)
+    {
+        if (data[i] == s)
+            return i;
+    }
+    return INT_MAX;
+}
+void GetEvents(nlohmann::json& j, const char* name, const char* processName, BuildEvents& be)
+{
+    if (!j[name].is_null())
+    {
+        for (auto it = j[name].begin(); it != j[name].end(); it++)
+            be.Add(it.value().get<std::string>());
+    }
+    if (!Valid(j, processName))
+        return;
+    for (auto it = j[processName].begin(); it != j[processName].end(); it++)
+    {
+        s32 index;
+        if (be.Get(index, it.key()))
+            GetProcessSettings(it.value(), be.m_events[index].process);
+    }
+}
+void GetEnabled(const nlohmann::json& src, const char* name, std::vector<s32>& dest, const std::vector<std::string>& names)
+{
+    if (!src.contains(name))
+        return;
+    for (const nlohmann::json& s : src[name])
+    {
+        s32 index = FindStringInArray(s, names);
+        if (index != INT_MAX)
+            dest.push_back(index);
+    }
+}
+void GetEnabled(const nlohmann::json& src, const char* name, std::vector<s32>& dest, const BuildEvents& be)
+{
+    if (!src.contains(name))
+        return;
+    BuildEvent b;
+    for (const nlohmann::json& s : src[name])
+    {
+        if (be.Get(b, s.get<std::string>()))
+            dest.push_back(b.id);
+    }
+}
+
+bool Load(const std::string& text, Settings& out)
+{
+    out = {};
+    nlohmann::json j = nlohmann::json::parse(text);
+    if (!Valid(j, versionText) || j[versionText].get<s32>() != out.version)
+        return false;
+    GetTypeFromValid<s32>(          j, platformSelectionText,   out.platformSelection);
+    GetTypeFromValid<std::string>(  j, rootPathText,            out.rootPath);
+    GetTypeFromValid<std::string>(  j, projectPathText,         out.projectPath);
+    if (!j[versionOptionsText].is_null())
+        out.versionOptions = j[versionOptionsText];
+    if (!j[switchOptionsText].is_null())
+        out.switchOptions = j[switchOptionsText];
+    GetEvents(j, preBuildEventsText,    preBuildProcessText,    out.preBuildEvents);
+    GetEvents(j, postBuildEventsText,   postBuildProcessText,   out.postBuildEvents);
+    if (Valid(j, uatProcessText))
+        GetProcessSettings(j[uatProcessText], out.uatProcess);
+    if (Valid(j, fatalPatternsText))
+    {
+        for (const nlohmann::json& p : j[fatalPatternsText])
+        {
+            FatalLogPattern pattern;
+            GetTypeFromValid<std::string>(p, patternText, pattern.text);
+            GetTypeFromValid<s32>(p, countText, pattern.count);
+            out.fatalPatterns.push_back(pattern);
+        }
+    }
+    for (auto it = j[platformOptionsText].begin(); it != j[platformOptionsText].end(); it++)
+    {
+        PlatformSettings& p = out.platformOptions.emplace_back();
+        p.name = it.key();
+        if (it.value().is_null())
+            continue;
+        GetEnabled(it.value(), enabledVersionsText,   p.enabledVersions,  out.versionOptions);
+        GetEnabled(it.value(), enabledSwitchesText,   p.enabledSwitches,  out.switchOptions);
+        GetEnabled(it.value(), enabledPreBuildText,   p.enabledPreBuild,  out.preBuildEvents);
+        GetEnabled(it.value(), enabledPostBuildText,  p.enabledPostBuild, out.postBuildEvents);
+    }
+    return true;
+}
+
+}
+
+s32 RunConfigBenchmark(s32 entryCount, s32 iterations)
+{
+    Settings settings = GenerateConfig(entryCount);
+
+    std::string legacyText = Legacy::Save(settings);
+    std::string text = WriteConfigText(settings);
+    printf("%i entries, %zu bytes, %i iterations\n", entryCount, text.size(), iterations);
+    if (legacyText != text)
+    {
+        printf("streaming writer output differs from the DOM writer\n");
+        return 1;
+    }
+    Settings loaded;
+    if (!ReadConfigText(text, loaded) || WriteConfigText(loaded) != text)
+    {
+        printf("streaming reader didn't round trip\n");
+        return 1;
+    }
+
+    FileEntry json;
+    json.size = text.size();
+    std::string snapshot = EncodeConfigSnapshot(json, 0, loaded);
+    if (!DecodeConfigSnapshot((const u8*)snapshot.data(), snapshot.size(), json, 0, loaded) || WriteConfigText(loaded) != text)
+    {
+        printf("snapshot didn't round trip\n");
+        return 1;
+    }
+
+    Print("load (DOM)", Measure(iterations, [&]() { Legacy::Load(legacyText, loaded); }));
+    Print("load (streaming)", Measure(iterations, [&]() { ReadConfigText(text, loaded); }));
+    Print("load (snapshot)", Measure(iterations, [&]() { DecodeConfigSnapshot((const u8*)snapshot.data(), snapshot.size(), json, 0, loaded); }));
+    Print("save (DOM)", Measure(iterations, [&]() { legacyText = Legacy::Save(settings); }));
+    Print("save (streaming)", Measure(iterations, [&]() { text = WriteConfigText(settings); }));
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "Benchmark.h"
+#include "HeadlessUI.h"
+#include "BuildQueue.h"
+#include "Threading.h"
+
+#include "imgui.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+//NOTE(CSH): CPU cost of UpdateUI + ImGui::Render for configs of growing size. The time doesn't include
+//the OpenGL backend or the swap so it is what the UI itself costs, the vertex counts show how much the
+//renderer would have to upload
+
+s32 RunFrameBenchmark(s32 frames)
+{
+    const s32 switchCounts[] = { 10, 100, 1000, 10000 };
+
+    Threading& threading = Threading::GetInstance();
+    HeadlessInit();
+    printf("%8s %8s %8s %9s %9s %9s %9s %9s %10s %10s %10s\n",
+        "switches", "versions", "events", "platforms", "p50 ms", "p90 ms", "p99 ms", "max ms", "draw lists", "vertices", "indices");
+    for (s32 switchCount : switchCounts)
+    {
+        BuildQueue buildQueue;
+        AppSettings appSettings;
+        //GenerateConfig makes 7 of every 10 entries a switch, versions and events grow with them
+        Settings settings = GenerateConfig((switchCount * 10 + 6) / 7);
+        UIState ui;
+
+        HeadlessWarmUp(ui, settings, appSettings, buildQueue, threading);
+
+        std::vector<f64> frameTimes;
+        frameTimes.reserve(frames);
+        ImDrawData* drawData = nullptr;
+        for (s32 i = 0; i < frames; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            drawData = HeadlessFrame(ui, settings, appSettings, buildQueue, threading);
+            auto end = std::chrono::steady_clock::now();
+            frameTimes.push_back(std::chrono::duration<f64, std::milli>(end - start).count());
+        }
+        std::sort(frameTimes.begin(), frameTimes.end());
+
+        size_t eventCount = settings.preBuildEvents.m_events.size() + settings.postBuildEvents.m_events.size();
+        printf("%8zu %8zu %8zu %9zu %9.3f %9.3f %9.3f %9.3f %10i %10i %10i\n",
+            settings.switchOptions.size(), settings.versionOptions.size(), eventCount, settings.platformOptions.size(),
+            Percentile(frameTimes, 50), Percentile(frameTimes, 90), Percentile(frameTimes, 99), frameTimes.empty() ? 0.0 : frameTimes.back(),
+            drawData ? drawData->CmdListsCount : 0, drawData ? drawData->TotalVtxCount : 0, drawData ? drawData->TotalIdxCount : 0);
+    }
+    HeadlessShutdown();
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "HeadlessUI.h"
+#include "FrameArena.h"
+#include "Themes.h"
+#include "PathValidator.h"
+#include "AsyncFileWriter.h"
+#include "BuildQueue.h"
+
+#include "imgui.h"
+
+void HeadlessInit(f32 width, f32 height)
+{
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(width, height);
+    io.BackendPlatformName = "Headless";
+    io.BackendRendererName = "Headless";
+    //NewFrame needs the font atlas to be built, a renderer would upload it here
+    unsigned char* pixels = nullptr;
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &atlasWidth, &atlasHeight);
+    ThemesInit();
+    PathValidator::GetInstance().m_synchronous = true;
+    AsyncFileWriter::GetInstance().m_dryRun = true;
+}
+
+ImDrawData* HeadlessFrame(UIState& ui, Settings& settings, AppSettings& appSettings, BuildQueue& buildQueue, Threading& threading, f32 deltaTime)
+{
+    ui.dryRun = true;
+    buildQueue.m_dryRun = true;
+    FrameArena::GetInstance().Reset();
+    ImGui::GetIO().DeltaTime = deltaTime;
+    ImGui::NewFrame();
+    UpdateUI(ui, settings, appSettings, buildQueue, threading);
+    ImGui::Render();
+    return ImGui::GetDrawData();
+}
+
+void HeadlessWarmUp(UIState& ui, Settings& settings, AppSettings& appSettings, BuildQueue& buildQueue, Threading& threading, s32 frames)
+{
+    for (s32 i = 0; i < frames; i++)
+        HeadlessFrame(ui, settings, appSettings, buildQueue, threading);
+}
+
+void HeadlessShutdown()
+{
+    ImGui::DestroyContext();
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "Math.h"
+#include "UI.h"
+
+struct ImDrawData;
+
+//NOTE(CSH): runs UpdateUI against ImGui without a window or a renderer. Render still builds the draw lists
+//so the cost of the UI is the same as in the app, the draw data is thrown away.
+//Headless frames are dry runs: a click on Build or Save goes through the queue and the file writer but
+//nothing is launched or written, and the PathValidator answers on the first query so every run is the same
+void HeadlessInit(f32 width = 1280.0f, f32 height = 720.0f);
+ImDrawData* HeadlessFrame(UIState& ui, Settings& settings, AppSettings& appSettings, BuildQueue& buildQueue, Threading& threading, f32 deltaTime = 1.0f / 60.0f);
+//Frames before the measured ones so window sizes and the frame arena have settled
+void HeadlessWarmUp(UIState& ui, Settings& settings, AppSettings& appSettings, BuildQueue& buildQueue, Threading& threading, s32 frames = 60);
+void HeadlessShutdown();
@@ -0,0 +1,94 @@
+#include "Benchmark.h"
+#include "HeadlessUI.h"
+#include "InputRecording.h"
+#include "BuildQueue.h"
+#include "Threading.h"
+#include "Themes.h"
+
+#include <chrono>
+#include <cstdio>
+
+//NOTE(CSH): replays a recorded session frame by frame with the delta times it was recorded with but without
+//waiting between frames. The UI is the real one but headless frames are dry runs, a recorded build click queues
+//the build and it succeeds on the next frame without UAT or its build events running.
+//There are no warm up frames, the first replayed frame is the first frame of the session like it was recorded
+
+struct ReplayFrame {
+    s32 index;
+    f64 milliseconds;
+    u64 allocations;
+};
+
+s32 RunReplay(const char* recordingFile)
+{
+    InputRecording recording;
+    if (!LoadInputRecording(recordingFile, recording))
+    {
+        printf("couldn't read %s or it was recorded with another SDL\n", recordingFile);
+        return 1;
+    }
+    Settings settings;
+    AppSettings appSettings;
+    BuildQueue buildQueue;
+    if (!ReadConfigText(recording.config, settings) || !ReadAppSettingsText(recording.appSettings, appSettings) ||
+        !ReadBuildQueueText(recording.buildQueue, buildQueue.m_requests))
+    {
+        printf("the config, app settings or build queue in %s is from another version\n", recordingFile);
+        return 1;
+    }
+    buildQueue.m_paused = recording.buildQueuePaused;
+
+    Threading& threading = Threading::GetInstance();
+    UIState ui;
+    HeadlessInit(f32(recording.windowWidth), f32(recording.windowHeight));
+    Color_Set(appSettings.colorSelection);
+    Style_Set(appSettings.styleSelection);
+
+    std::vector<ReplayFrame> frames;
+    frames.reserve(recording.frames.size());
+    for (s32 i = 0; i < recording.frames.size(); i++)
+    {
+        const RecordedFrame& recorded = recording.frames[i];
+        AllocationCounts before = GetThreadAllocations();
+        auto start = std::chrono::steady_clock::now();
+        for (u32 e = 0; e < recorded.eventCount; e++)
+            ReplayEvent(recording.events[recorded.firstEvent + e]);
+        HeadlessFrame(ui, settings, appSettings, buildQueue, threading, recorded.deltaTime > 0 ? recorded.deltaTime : 1.0f / 60.0f);
+        auto end = std::chrono::steady_clock::now();
+        ReplayFrame& frame = frames.emplace_back();
+        frame.index = i;
+        frame.milliseconds = std::chrono::duration<f64, std::milli>(end - start).count();
+        frame.allocations = (GetThreadAllocations() - before).allocations;
+    }
+    HeadlessShutdown();
+
+    std::vector<f64> frameTimes;
+    std::vector<u64> frameAllocations;
+    u64 totalAllocations = 0;
+    for (const ReplayFrame& frame : frames)
+    {
+        frameTimes.push_back(frame.milliseconds);
+        frameAllocations.push_back(frame.allocations);
+        totalAllocations += frame.allocations;
+    }
+    std::sort(frameTimes.begin(), frameTimes.end());
+    std::sort(frameAllocations.begin(), frameAllocations.end());
+
+    printf("%s: %zu frames, %zu events\n", recordingFile, recording.frames.size(), recording.events.size());
+    printf("%-12s %10s %10s %10s %10s\n", "", "p50", "p90", "p99", "max");
+    printf("%-12s %10.3f %10.3f %10.3f %10.3f\n", "ms", Percentile(frameTimes, 50), Percentile(frameTimes, 90), Percentile(frameTimes, 99), Percentile(frameTimes, 100));
+    printf("%-12s %10llu %10llu %10llu %10llu\n", "allocations", (unsigned long long)Percentile(frameAllocations, 50), (unsigned long long)Percentile(frameAllocations, 90),
+        (unsigned long long)Percentile(frameAllocations, 99), (unsigned long long)Percentile(frameAllocations, 100));
+    printf("%-12s %10llu\n", "total allocs", (unsigned long long)totalAllocations);
+
+    //the frame numbers of the hitches, to find them in the recording
+    const size_t slowestCount = Min<size_t>(5, frames.size());
+    std::partial_sort(frames.begin(), frames.begin() + slowestCount, frames.end(), [](const ReplayFrame& a, const ReplayFrame& b)
+    {
+        return a.milliseconds > b.milliseconds;
+    });
+    printf("slowest frames:\n");
+    for (size_t i = 0; i < slowestCount; i++)
+        printf("    frame %6i %10.3f ms %8llu allocations\n", frames[i].index, frames[i].milliseconds, (unsigned long long)frames[i].allocations);
+    return 0;
+}
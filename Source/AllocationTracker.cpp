@@ -0,0 +1,109 @@
+#include "AllocationTracker.h"
+
+#ifdef TRACK_ALLOCATIONS
+#include "Tracy.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+thread_local AllocationCounts t_allocations;
+std::atomic<u64> s_allocations = 0;
+std::atomic<u64> s_frees = 0;
+std::atomic<u64> s_allocatedBytes = 0;
+
+void* TrackedAllocate(size_t size)
+{
+    void* p = malloc(size ? size : 1);
+    if (!p)
+        return nullptr;
+    t_allocations.allocations++;
+    t_allocations.bytes += size;
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    //secure: the global hooks also run before the profiler exists (static init) and after it is gone
+    //(static destructors, detached threads) where the plain macros would touch a dead profiler
+    TracySecureAlloc(p, size);
+    return p;
+}
+
+void TrackedFree(void* p)
+{
+    if (!p)
+        return;
+    t_allocations.frees++;
+    s_frees.fetch_add(1, std::memory_order_relaxed);
+    TracySecureFree(p);
+    free(p);
+}
+
+void* operator new(size_t size)
+{
+    if (void* p = TrackedAllocate(size))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size);
+}
+void operator delete(void* p) noexcept
+{
+    TrackedFree(p);
+}
+void operator delete[](void* p) noexcept
+{
+    TrackedFree(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+    TrackedFree(p);
+}
+void operator delete[](void* p, size_t) noexcept
+{
+    TrackedFree(p);
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    TrackedFree(p);
+}
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    TrackedFree(p);
+}
+
+AllocationCounts GetThreadAllocations()
+{
+    return t_allocations;
+}
+
+AllocationCounts GetAllocations()
+{
+    AllocationCounts result;
+    result.allocations  = s_allocations.load(std::memory_order_relaxed);
+    result.frees        = s_frees.load(std::memory_order_relaxed);
+    result.bytes        = s_allocatedBytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+#else
+
+AllocationCounts GetThreadAllocations()
+{
+    return {};
+}
+
+AllocationCounts GetAllocations()
+{
+    return {};
+}
+
+#endif
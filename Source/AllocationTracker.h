@@ -0,0 +1,25 @@
+#pragma once
+#include "Math.h"
+
+//NOTE(CSH): with TRACK_ALLOCATIONS (Profile and the benchmarks) the global operator new/delete count every allocation,
+//per thread and in total. They are also reported to Tracy so its memory view attributes them to zones.
+//Without it the counts stay 0
+struct AllocationCounts {
+    u64 allocations = 0;
+    u64 frees = 0;
+    u64 bytes = 0; //allocated, not what is still alive
+};
+
+inline AllocationCounts operator-(const AllocationCounts& a, const AllocationCounts& b)
+{
+    AllocationCounts result;
+    result.allocations  = a.allocations - b.allocations;
+    result.frees        = a.frees - b.frees;
+    result.bytes        = a.bytes - b.bytes;
+    return result;
+}
+
+//Allocations made by the calling thread since it started
+AllocationCounts GetThreadAllocations();
+//Allocations made by every thread
+AllocationCounts GetAllocations();
@@ -0,0 +1,364 @@
+#include "ArtifactCache.h"
+#include "FileSystem.h"
+#include "Fingerprint.h"
+#include "Hash.h"
+#include "UATLog.h"
+#include "Windows.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+void ArtifactCache::Load()
+{
+    if (m_loaded)
+        return;
+    m_loaded = true;
+    LoadArtifactIndex(m_directory + "Index.json", m_manifests);
+}
+
+void ArtifactCache::Save() const
+{
+    CreateDirectories(m_directory);
+    SaveArtifactIndex(m_directory + "Index.json", m_manifests);
+}
+
+std::string ArtifactCache::ObjectPath(u64 hash) const
+{
+    return m_directory + ToString("Objects/%02llx/%016llx", (unsigned long long)(hash >> 56), (unsigned long long)hash);
+}
+
+ArtifactManifest* ArtifactCache::Find(u64 key)
+{
+    Load();
+    for (ArtifactManifest& manifest : m_manifests)
+    {
+        if (manifest.key == key)
+            return &manifest;
+    }
+    return nullptr;
+}
+
+void ArtifactCache::Remove(u64 key)
+{
+    std::erase_if(m_manifests, [key](const ArtifactManifest& manifest)
+        {
+            return manifest.key == key;
+        });
+}
+
+bool ArtifactCache::Restore(u64 key, const std::string& outputDirectory, std::atomic<s32>* progress, std::atomic<s32>* total)
+{
+    ArtifactManifest* manifest = Find(key);
+    if (!manifest)
+        return false;
+    const std::vector<ArtifactFile>& files = manifest->files;
+    if (total)
+        *total = s32(files.size());
+
+    //NOTE(CSH): restored files are hardlinks to the objects, writing to one of them in place changes
+    //the object as well so every object is checked against its hash first (cheap through the hash cache)
+    std::vector<FileEntry> objects(files.size());
+    std::vector<u8> found(files.size(), false);
+    ParallelFor(s32(files.size()), [&](s32 i)
+        {
+            found[i] = GetFileEntry(ObjectPath(files[i].hash), objects[i]);
+        });
+    std::vector<u64> hashes;
+    HashCache::GetInstance().HashFiles(objects, hashes);
+    for (s32 i = 0; i < files.size(); i++)
+    {
+        if (found[i] && hashes[i] == files[i].hash && objects[i].size == files[i].size)
+            continue;
+        SDL_Log("Artifact cache object for %s is missing or modified", files[i].path.c_str());
+        if (found[i])
+            DeleteFileA(objects[i].path.c_str());
+        Remove(key);
+        Save();
+        return false;
+    }
+
+    std::unordered_set<std::string> subDirectories;
+    std::unordered_set<std::string> restoredPaths;
+    for (const ArtifactFile& file : files)
+    {
+        subDirectories.insert(file.path.substr(0, file.path.find('/')));
+        restoredPaths.insert(outputDirectory + '/' + file.path);
+    }
+    for (const std::string& subDirectory : subDirectories)
+    {
+        std::vector<FileEntry> existing;
+        ScanFiles(outputDirectory + '/' + subDirectory, existing);
+        for (const FileEntry& file : existing)
+        {
+            if (!restoredPaths.contains(file.path))
+            {
+                SetFileAttributesA(file.path.c_str(), FILE_ATTRIBUTE_NORMAL);
+                DeleteFileA(file.path.c_str());
+            }
+        }
+    }
+
+    std::atomic<bool> failed = false;
+    ParallelFor(s32(files.size()), [&](s32 i)
+        {
+            std::string destination = outputDirectory + '/' + files[i].path;
+            size_t slash = destination.find_last_of('/');
+            CreateDirectories(destination.substr(0, slash));
+            SetFileAttributesA(destination.c_str(), FILE_ATTRIBUTE_NORMAL);
+            DeleteFileA(destination.c_str());
+            if (!CreateHardLinkA(destination.c_str(), objects[i].path.c_str(), NULL) &&
+                !CopyFileA(objects[i].path.c_str(), destination.c_str(), FALSE))
+            {
+                SDL_Log("Failed to restore %s: %i", destination.c_str(), GetLastError());
+                failed = true;
+            }
+            if (progress)
+                (*progress)++;
+        });
+    if (failed)
+        return false;
+
+    manifest->lastUsed = CurrentFileTime();
+    Save();
+    return true;
+}
+
+bool ArtifactCache::Store(u64 key, const std::string& outputDirectory, const std::vector<std::string>& subDirectories, u64 maxBytes,
+                          std::atomic<s32>* progress, std::atomic<s32>* total)
+{
+    Load();
+    std::vector<FileEntry> files;
+    for (const std::string& subDirectory : subDirectories)
+        ScanFiles(outputDirectory + '/' + subDirectory, files);
+    if (files.empty())
+        return false;
+    if (total)
+        *total = s32(files.size());
+
+    HashCache& hashCache = HashCache::GetInstance();
+    std::vector<u64> hashes;
+    hashCache.HashFiles(files, hashes);
+    hashCache.Save();
+
+    std::atomic<bool> failed = false;
+    ParallelFor(s32(files.size()), [&](s32 i)
+        {
+            DEFER
+            {
+                if (progress)
+                    (*progress)++;
+            };
+            std::string object = ObjectPath(hashes[i]);
+            FileEntry existing;
+            if (GetFileEntry(object, existing))
+            {
+                //objects are named by a 64 bit hash, a different file with the same hash must not be stored as it
+                if (existing.size != files[i].size || !SameFileContent(object, files[i].path))
+                {
+                    SDL_Log("Artifact cache object %s has the hash of %s but not its content", object.c_str(), files[i].path.c_str());
+                    failed = true;
+                }
+                return;
+            }
+            CreateDirectories(object.substr(0, object.find_last_of('/')));
+            //copied next to the object first so a partial copy never looks like a valid object
+            std::string temp = object + ToString(".%i.tmp", i);
+            if (!CopyFileA(files[i].path.c_str(), temp.c_str(), FALSE) ||
+                !MoveFileExA(temp.c_str(), object.c_str(), MOVEFILE_REPLACE_EXISTING))
+            {
+                SDL_Log("Failed to store %s in the artifact cache: %i", files[i].path.c_str(), GetLastError());
+                DeleteFileA(temp.c_str());
+                failed = true;
+            }
+        });
+    if (failed)
+        return false;
+
+    ArtifactManifest manifest;
+    manifest.key = key;
+    manifest.lastUsed = CurrentFileTime();
+    const size_t prefixSize = outputDirectory.size() + 1;
+    for (s32 i = 0; i < files.size(); i++)
+    {
+        ArtifactFile file;
+        file.path = files[i].path.substr(prefixSize);
+        file.hash = hashes[i];
+        file.size = files[i].size;
+        manifest.files.push_back(file);
+    }
+    Remove(key);
+    m_manifests.push_back(manifest);
+    Trim(maxBytes);
+    Save();
+    return true;
+}
+
+void ArtifactCache::Trim(u64 maxBytes)
+{
+    auto referencedBytes = [this](std::unordered_set<u64>& referenced)
+    {
+        referenced.clear();
+        u64 bytes = 0;
+        for (const ArtifactManifest& manifest : m_manifests)
+        {
+            for (const ArtifactFile& file : manifest.files)
+            {
+                if (referenced.insert(file.hash).second)
+                    bytes += file.size;
+            }
+        }
+        return bytes;
+    };
+
+    std::sort(m_manifests.begin(), m_manifests.end(), [](const ArtifactManifest& a, const ArtifactManifest& b)
+        {
+            return a.lastUsed > b.lastUsed;
+        });
+    std::unordered_set<u64> referenced;
+    //the most recent build is always kept even if it alone is over the limit
+    while (m_manifests.size() > 1 && referencedBytes(referenced) > maxBytes)
+        m_manifests.pop_back();
+    referencedBytes(referenced);
+
+    std::vector<FileEntry> objects;
+    ScanFiles(m_directory + "Objects", objects);
+    for (const FileEntry& object : objects)
+    {
+        size_t slash = object.path.find_last_of('/');
+        u64 hash = strtoull(object.path.c_str() + slash + 1, nullptr, 16);
+        bool temp = object.path.ends_with(".tmp");
+        if (temp || !referenced.contains(hash))
+            DeleteFileA(object.path.c_str());
+    }
+}
+
+std::string ArtifactOutputDirectory(const BuildRequest& request)
+{
+    std::string dir = GetSwitchValue(request.commandLine, "stagingdirectory");
+    if (dir.empty())
+        dir = ProjectDirectory(request.projectPath) + "Saved/StagedBuilds";
+    for (char& c : dir)
+    {
+        if (c == '\\')
+            c = '/';
+    }
+    while (dir.size() && dir.back() == '/')
+        dir.pop_back();
+    return dir;
+}
+
+void SnapshotSubDirectories(const std::string& dir, std::map<std::string, u64>& out)
+{
+    out.clear();
+    std::vector<FileEntry> files;
+    ScanFiles(dir, files);
+    std::sort(files.begin(), files.end(), [](const FileEntry& a, const FileEntry& b)
+        {
+            return a.path < b.path;
+        });
+
+    std::map<std::string, Hasher64> hashers;
+    const size_t prefixSize = dir.size() + 1;
+    for (const FileEntry& file : files)
+    {
+        std::string_view relativePath = std::string_view(file.path).substr(prefixSize);
+        size_t slash = relativePath.find('/');
+        if (slash == std::string_view::npos)
+            continue;
+        Hasher64& hasher = hashers[std::string(relativePath.substr(0, slash))];
+        hasher.Update(relativePath);
+        hasher.UpdateValue(file.fileID);
+        hasher.UpdateValue(file.size);
+        hasher.UpdateValue(file.lastWriteTime);
+    }
+    for (const auto& [subDirectory, hasher] : hashers)
+        out[subDirectory] = hasher.Final();
+}
+
+void ChangedSubDirectories(const std::string& dir, const std::map<std::string, u64>& before, std::vector<std::string>& out)
+{
+    out.clear();
+    std::map<std::string, u64> after;
+    SnapshotSubDirectories(dir, after);
+    for (const auto& [subDirectory, signature] : after)
+    {
+        auto it = before.find(subDirectory);
+        if (it == before.end() || it->second != signature)
+            out.push_back(subDirectory);
+    }
+}
+
+bool IsCacheableBuild(const BuildRequest& request)
+{
+    const std::string& commandLine = request.commandLine;
+    if (request.projectPath.empty() || ContainsSwitch(commandLine, "skipstage"))
+        return false;
+    //NOTE(CSH): a hit skips UAT and only the staging directory is restored, anything UAT does after staging
+    //(packages that end up outside of it like apks, archiving, deploying, running) wouldn't happen
+    const char* outsideOfStaging[] = { "package", "archive", "deploy", "run" };
+    for (const char* name : outsideOfStaging)
+    {
+        if (ContainsSwitch(commandLine, name))
+            return false;
+    }
+    return ContainsSwitch(commandLine, "stage");
+}
+
+u64 ArtifactKey(const BuildRun& run)
+{
+    Hasher64 hasher;
+    hasher.Update(run.request.commandLine);
+    hasher.UpdateValue(run.fingerprint.source);
+    hasher.UpdateValue(run.fingerprint.content);
+    //the engine itself isn't fingerprinted, a new engine build at least changes its version file
+    u64 engineVersion = 0;
+    HashFile(run.request.rootPath + "Engine/Build/Build.version", engineVersion);
+    hasher.UpdateValue(engineVersion);
+    return hasher.Final();
+}
+
+void StagedSnapshotJob::RunJob()
+{
+    SnapshotSubDirectories(ArtifactOutputDirectory(run->request), run->stagedSnapshot);
+}
+
+void ArtifactRestoreJob::RunJob()
+{
+    if (!run->fingerprinted)
+        return;
+    run->artifactKey = ArtifactKey(*run);
+    run->artifactState = ArtifactState_Restoring;
+    const std::string outputDirectory = ArtifactOutputDirectory(run->request);
+    ArtifactCache& cache = ArtifactCache::GetInstance();
+    if (cache.Restore(run->artifactKey, outputDirectory, &run->artifactProgress, &run->artifactTotal))
+    {
+        run->artifactState = ArtifactState_Restored;
+        return;
+    }
+    run->artifactState = ArtifactState_None;
+}
+
+void ArtifactStoreJob::RunJob()
+{
+    if (!run->fingerprinted || run->artifactState == ArtifactState_Restored)
+        return;
+    //only output that was staged by this run is known to match the fingerprints
+    if (!(run->phasesCompleted & (1 << UATPhase_Stage)))
+        return;
+    const std::string outputDirectory = ArtifactOutputDirectory(run->request);
+    std::vector<std::string> changed;
+    ChangedSubDirectories(outputDirectory, run->stagedSnapshot, changed);
+    if (changed.empty())
+        return;
+
+    run->artifactProgress = 0;
+    run->artifactState = ArtifactState_Storing;
+    ArtifactCache& cache = ArtifactCache::GetInstance();
+    if (cache.Store(run->artifactKey, outputDirectory, changed, maxBytes, &run->artifactProgress, &run->artifactTotal))
+        run->artifactState = ArtifactState_Stored;
+    else
+        run->artifactState = ArtifactState_None;
+}
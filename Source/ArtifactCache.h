@@ -0,0 +1,75 @@
+#pragma once
+#include "Math.h"
+#include "Config.h"
+#include "BuildQueue.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum ArtifactState : s32 {
+    ArtifactState_None,
+    ArtifactState_Restoring,
+    ArtifactState_Restored,
+    ArtifactState_Storing,
+    ArtifactState_Stored,
+};
+
+//NOTE(CSH): the staged output of successful builds stored by content hash, every file is stored once
+//no matter how many builds contain it. A file whose hash matches an object with other content isn't stored. Manifests are evicted least recently used first once
+//the cache is over its size and objects nothing refers to anymore are deleted
+struct ArtifactCache {
+    std::string m_directory = "ArtifactCache/";
+    std::vector<ArtifactManifest> m_manifests;
+    bool m_loaded = false;
+
+    static ArtifactCache& GetInstance()
+    {
+        static ArtifactCache instance;
+        return instance;
+    }
+    void Load();
+    void Save() const;
+    std::string ObjectPath(u64 hash) const;
+    ArtifactManifest* Find(u64 key);
+    void Remove(u64 key);
+    //Hardlinks the files of the manifest into outputDirectory, copies them when the cache is on another volume.
+    //Other files in the restored sub directories are deleted the same way UAT cleans them before staging
+    bool Restore(u64 key, const std::string& outputDirectory, std::atomic<s32>* progress, std::atomic<s32>* total);
+    //Stores the files of the given sub directories (one per staged platform) of outputDirectory
+    bool Store(u64 key, const std::string& outputDirectory, const std::vector<std::string>& subDirectories, u64 maxBytes,
+               std::atomic<s32>* progress, std::atomic<s32>* total);
+    void Trim(u64 maxBytes);
+};
+
+//Where BuildCookRun stages, -stagingdirectory or the projects Saved/StagedBuilds
+std::string ArtifactOutputDirectory(const BuildRequest& request);
+//Signature of the files in every sub directory of dir, compared before and after UAT
+//to find the platform directories the build staged to
+void SnapshotSubDirectories(const std::string& dir, std::map<std::string, u64>& out);
+//Sub directories of dir that are new or differ from the snapshot before
+void ChangedSubDirectories(const std::string& dir, const std::map<std::string, u64>& before, std::vector<std::string>& out);
+bool IsCacheableBuild(const BuildRequest& request);
+//Resolved command line, project fingerprints and the engine version
+u64 ArtifactKey(const BuildRun& run);
+
+//Takes run->stagedSnapshot, before the restore so restored platforms count as staged by this run
+struct StagedSnapshotJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    virtual void RunJob() override;
+};
+
+struct ArtifactRestoreJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    virtual void RunJob() override;
+};
+
+struct ArtifactStoreJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    u64 maxBytes = 0;
+    virtual void RunJob() override;
+};
@@ -0,0 +1,101 @@
+#include "AsyncFileWriter.h"
+#include "Hash.h"
+
+#include "SDL.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <chrono>
+#include <thread>
+
+//saves that follow within this time are written together
+const auto coalesceDelay = std::chrono::milliseconds(200);
+
+void AsyncFileWriter::Write(const std::string& filename, std::string content)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_started && !m_dryRun)
+    {
+        m_started = true;
+        std::thread([this]() { Run(); }).detach();
+    }
+    m_pending[filename] = std::move(content);
+    m_wake.notify_one();
+}
+
+bool AsyncFileWriter::GetPending(const std::string& filename, std::string& content)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_pending.find(filename);
+    if (it == m_pending.end())
+    {
+        it = m_writing.find(filename);
+        if (it == m_writing.end())
+            return false;
+    }
+    content = it->second;
+    return true;
+}
+
+void AsyncFileWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_dryRun)
+        return;
+    m_flushing = true;
+    m_wake.notify_one();
+    m_idle.wait(lock, [this]() { return m_pending.empty() && m_writing.empty(); });
+    m_flushing = false;
+}
+
+bool ReplaceFileContent(const std::string& filename, const std::string& content)
+{
+    std::string temp = filename + ".tmp";
+    HANDLE file = CreateFileA(temp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    DWORD written = 0;
+    bool success = WriteFile(file, content.data(), DWORD(content.size()), &written, NULL) && written == content.size();
+    CloseHandle(file);
+    if (success)
+        success = MoveFileExA(temp.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    if (!success)
+        DeleteFileA(temp.c_str());
+    return success;
+}
+
+void AsyncFileWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wake.wait(lock, [this]() { return !m_pending.empty(); });
+        //give the rest of a burst of saves a chance to replace what is pending, Flush doesn't wait for it
+        m_wake.wait_for(lock, coalesceDelay, [this]() { return m_flushing; });
+
+        m_writing.swap(m_pending);
+        lock.unlock();
+        std::unordered_map<std::string, u64> hashes;
+        for (const auto& [filename, content] : m_writing)
+        {
+            u64 hash = Hash64(content.data(), content.size());
+            {
+                std::lock_guard<std::mutex> hashLock(m_mutex);
+                auto it = m_writtenHashes.find(filename);
+                if (it != m_writtenHashes.end() && it->second == hash)
+                    continue;
+            }
+            if (ReplaceFileContent(filename, content))
+                hashes[filename] = hash;
+            else
+                SDL_Log("Failed to write %s: %i", filename.c_str(), GetLastError());
+        }
+        lock.lock();
+        for (const auto& [filename, hash] : hashes)
+            m_writtenHashes[filename] = hash;
+        m_writing.clear();
+        if (m_pending.empty())
+            m_idle.notify_all();
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Math.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+//NOTE(CSH): writes files on a background thread so the UI doesn't wait on a slow (network) drive.
+//Writes to the same file that come in quickly after each other only write the last content,
+//content that is the same as the last write is skipped and files are replaced through a rename
+//so a crash never leaves half a file behind
+struct AsyncFileWriter {
+    std::unordered_map<std::string, std::string> m_pending;
+    std::unordered_map<std::string, std::string> m_writing; //taken from m_pending by the writer thread
+    std::unordered_map<std::string, u64> m_writtenHashes;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    bool m_started = false;
+    bool m_flushing = false;
+    bool m_dryRun = false; //writes stay pending and GetPending returns them but nothing reaches the disk
+
+    static AsyncFileWriter& GetInstance()
+    {
+        static AsyncFileWriter instance;
+        return instance;
+    }
+    void Write(const std::string& filename, std::string content);
+    //The content that will end up in the file if it wasn't written yet
+    bool GetPending(const std::string& filename, std::string& content);
+    //Blocks until every write finished
+    void Flush();
+    void Run();
+};
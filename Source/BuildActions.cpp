@@ -0,0 +1,551 @@
+#include "BuildActions.h"
+#include "ArtifactCache.h"
+#include "FileSystem.h"
+#include "Fingerprint.h"
+#include "Threading.h"
+#include "Windows.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
+bool IsBuildAction(const std::string& event)
+{
+    return event.size() && event[0] == '@';
+}
+
+std::vector<std::string> SplitActionArguments(const std::string& event)
+{
+    std::vector<std::string> result;
+    std::string current;
+    bool quoted = false;
+    bool hasToken = false;
+    for (char c : event)
+    {
+        if (c == '\"')
+        {
+            quoted = !quoted;
+            hasToken = true;
+        }
+        else if (c == ' ' && !quoted)
+        {
+            if (hasToken)
+                result.push_back(current);
+            current.clear();
+            hasToken = false;
+        }
+        else
+        {
+            current += c;
+            hasToken = true;
+        }
+    }
+    if (hasToken)
+        result.push_back(current);
+    return result;
+}
+
+void ReplaceAll(std::string& s, const std::string& from, const std::string& to)
+{
+    size_t pos = s.find(from);
+    while (pos != std::string::npos)
+    {
+        s.replace(pos, from.size(), to);
+        pos = s.find(from, pos + to.size());
+    }
+}
+
+std::string ExpandActionPath(const std::string& path, const BuildRequest& request)
+{
+    std::string result = path;
+    const std::string projectDir = ProjectDirectory(request.projectPath);
+    ReplaceAll(result, "{Root}", request.rootPath);
+    ReplaceAll(result, "{Project}", projectDir);
+    for (char& c : result)
+    {
+        if (c == '\\')
+            c = '/';
+    }
+    bool absolute = (result.size() > 1 && result[1] == ':') || result.starts_with("//");
+    if (!absolute)
+        result = projectDir + result;
+    while (result.size() && result.back() == '/')
+        result.pop_back();
+    return result;
+}
+
+//Absolute, lower case, '/' seperated and without "..", "." or a trailing '/'
+std::string NormalizedActionPath(const std::string& path)
+{
+    char buffer[MAX_PATH * 4];
+    DWORD length = GetFullPathNameA(path.c_str(), DWORD(sizeof(buffer)), buffer, NULL);
+    std::string result = (length && length < sizeof(buffer)) ? std::string(buffer, length) : path;
+    for (char& c : result)
+    {
+        if (c == '\\')
+            c = '/';
+        c = (char)tolower(c);
+    }
+    while (result.size() && result.back() == '/')
+        result.pop_back();
+    return result;
+}
+
+bool IsSameOrInside(const std::string& path, const std::string& dir)
+{
+    return path == dir || (path.size() > dir.size() && path.starts_with(dir) && path[dir.size()] == '/');
+}
+
+bool IsSafeCleanTarget(const std::string& dir, const BuildRequest& request, std::string& reason)
+{
+    if (dir.empty())
+    {
+        reason = "the path is empty";
+        return false;
+    }
+    const std::string target = NormalizedActionPath(dir);
+    //"c:" or "//server/share"
+    bool driveRoot = target.size() <= 2;
+    if (target.starts_with("//"))
+        driveRoot = std::count(target.begin() + 2, target.end(), '/') < 2;
+    if (driveRoot)
+    {
+        reason = "it is a drive root";
+        return false;
+    }
+    const std::string protectedDirs[] = { request.rootPath, ProjectDirectory(request.projectPath) };
+    for (const std::string& protectedDir : protectedDirs)
+    {
+        if (protectedDir.empty())
+            continue;
+        if (IsSameOrInside(NormalizedActionPath(protectedDir), target))
+        {
+            reason = ToString("it is or contains '%s'", protectedDir.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+Job* CreateBuildActionJob(const std::string& event, const std::shared_ptr<BuildRun>& run)
+{
+    std::vector<std::string> args = SplitActionArguments(event);
+    if (args.empty())
+        return nullptr;
+
+    if (args[0] == "@clean")
+    {
+        CleanJob* job = new CleanJob();
+        job->run = run;
+        for (s32 i = 1; i < args.size(); i++)
+        {
+            if (args[i] == "-background")
+                job->background = true;
+            else
+                job->directories.push_back(ExpandActionPath(args[i], run->request));
+        }
+        return job;
+    }
+    if (args[0] == "@copy")
+    {
+        CopyJob* job = new CopyJob();
+        job->run = run;
+        std::vector<std::string> paths;
+        for (s32 i = 1; i < args.size(); i++)
+        {
+            if (args[i] == "-hash")
+                job->hash = true;
+            else
+                paths.push_back(ExpandActionPath(args[i], run->request));
+        }
+        if (paths.size() != 2)
+        {
+            ShowErrorWindow("Build Action Error", "@copy needs a source and a destination directory");
+            delete job;
+            return nullptr;
+        }
+        job->source = paths[0];
+        job->destination = paths[1];
+        return job;
+    }
+    if (args[0] == "@dedupe")
+    {
+        DedupeJob* job = new DedupeJob();
+        job->run = run;
+        for (s32 i = 1; i < args.size(); i++)
+            job->directories.push_back(ExpandActionPath(args[i], run->request));
+        return job;
+    }
+
+    ShowErrorWindow("Unknown Build Action", ToString("\'%s\' is not a build action", args[0].c_str()));
+    return nullptr;
+}
+
+void StartBuildAction(BuildRun& run, const char* name)
+{
+    run.actionName = name;
+    run.actionProgress = 0;
+    run.actionTotal = 0;
+    run.actionStartTicks = SDL_GetTicks64();
+    run.actionMilliseconds = 0;
+    run.actionBytesSaved = 0;
+}
+
+void FinishBuildAction(BuildRun& run)
+{
+    run.actionMilliseconds = Max<u64>(SDL_GetTicks64() - run.actionStartTicks, 1);
+}
+
+//Deletes what previous background cleans left behind when UATHelper closed before they finished
+void DeleteLeftoverAsideDirectories(const std::string& dir, std::vector<std::string>& out)
+{
+    size_t slash = dir.find_last_of('/');
+    if (slash == std::string::npos)
+        return;
+    std::string pattern = dir + ".uathelper-delete-*";
+    WIN32_FIND_DATAA data;
+    HANDLE find = FindFirstFileA(pattern.c_str(), &data);
+    if (find == INVALID_HANDLE_VALUE)
+        return;
+    do
+    {
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            out.push_back(dir.substr(0, slash + 1) + data.cFileName);
+    } while (FindNextFileA(find, &data));
+    FindClose(find);
+}
+
+void CleanJob::RunJob()
+{
+    StartBuildAction(*run, "Cleaning");
+    DEFER { FinishBuildAction(*run); };
+
+    //NOTE(CSH): a typo or an empty {Project} shouldn't be able to delete the engine, the project or a whole drive
+    for (const std::string& dir : directories)
+    {
+        std::string reason;
+        if (IsSafeCleanTarget(dir, run->request, reason))
+            continue;
+        SDL_Log("@clean refused to delete '%s': %s", dir.c_str(), reason.c_str());
+        Threading::GetInstance().ClearJobs();
+        ShowErrorWindow("Clean Refused", ToString("@clean won't delete '%s', %s", dir.c_str(), reason.c_str()));
+        return;
+    }
+
+    std::vector<std::string> deleteLater;
+    std::string failure;
+    bool failed = false;
+    for (const std::string& dir : directories)
+    {
+        if (background)
+        {
+            DeleteLeftoverAsideDirectories(dir, deleteLater);
+            //a rename on the same volume is instant, the build can start right away
+            std::string aside = dir + ToString(".uathelper-delete-%llu", (unsigned long long)SDL_GetTicks64());
+            if (MoveFileExA(dir.c_str(), aside.c_str(), 0))
+            {
+                deleteLater.push_back(aside);
+                continue;
+            }
+            if (GetLastError() == ERROR_FILE_NOT_FOUND || GetLastError() == ERROR_PATH_NOT_FOUND)
+                continue;
+            SDL_Log("Couldn't move %s aside (%i), deleting it now", dir.c_str(), GetLastError());
+        }
+        if (!DeleteDirectoryTree(dir, &run->actionProgress, &run->actionTotal, &failure))
+            failed = true;
+    }
+
+    if (deleteLater.size())
+    {
+        std::thread([deleteLater]()
+            {
+                for (const std::string& dir : deleteLater)
+                    DeleteDirectoryTree(dir);
+            }).detach();
+    }
+
+    if (failed)
+    {
+        Threading::GetInstance().ClearJobs();
+        ShowErrorWindow("Clean Failed", ToString("Couldn't delete \'%s\', it is probably still in use", failure.c_str()));
+    }
+}
+
+const char* copyManifestName = "UATHelperCopyManifest.json";
+
+//Copies next to the destination and moves the copy over it, the destination is never half written and a
+//hard link (from the dedupe) is replaced instead of written through to the other files it shares data with
+bool CopyChangedFile(const std::string& from, const std::string& to, u64 size)
+{
+    //NOTE(CSH): CopyFile lets the file system/SMB server copy without the data going through
+    //this process, unbuffered avoids pushing multi GB paks through the file cache
+    DWORD flags = size >= 64 * 1024 * 1024 ? COPY_FILE_NO_BUFFERING : 0;
+    std::string temp = to + ".uathelper-copy";
+    DeleteFileNow(temp);
+    bool copied = CopyFileExA(from.c_str(), temp.c_str(), NULL, NULL, NULL, flags);
+    //MoveFile refuses to replace read only files
+    if (copied)
+        SetFileAttributesA(to.c_str(), FILE_ATTRIBUTE_NORMAL);
+    if (copied && MoveFileExA(temp.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING))
+        return true;
+    DWORD error = GetLastError();
+    DeleteFileNow(temp);
+    SetLastError(error);
+    return false;
+}
+
+void CopyJob::RunJob()
+{
+    StartBuildAction(*run, "Copying");
+    DEFER { FinishBuildAction(*run); };
+
+    std::vector<FileEntry> files;
+    ScanFiles(source, files);
+    if (files.empty())
+    {
+        Threading::GetInstance().ClearJobs();
+        ShowErrorWindow("Copy Failed", ToString("There are no files to copy in \'%s\'", source.c_str()));
+        return;
+    }
+
+    //Without a manifest the files that are already there are used, a copy keeps the timestamps of the source.
+    //Only files from a manifest get deleted, anything else in the destination isn't ours
+    const std::string manifestPath = destination + '/' + copyManifestName;
+    std::vector<CopiedFile> previous;
+    bool hasManifest = LoadCopyManifest(manifestPath, previous);
+    if (!hasManifest)
+    {
+        std::vector<FileEntry> existing;
+        ScanFiles(destination, existing);
+        for (const FileEntry& file : existing)
+        {
+            CopiedFile copied;
+            copied.path = file.path.substr(destination.size() + 1);
+            copied.size = file.size;
+            copied.lastWriteTime = file.lastWriteTime;
+            previous.push_back(copied);
+        }
+    }
+    std::unordered_map<std::string, const CopiedFile*> previousByPath;
+    for (const CopiedFile& file : previous)
+        previousByPath[file.path] = &file;
+
+    std::vector<u64> hashes;
+    if (hash)
+    {
+        HashCache& hashCache = HashCache::GetInstance();
+        hashCache.HashFiles(files, hashes);
+        hashCache.Save();
+    }
+
+    std::vector<CopiedFile> copied(files.size());
+    std::vector<s32> changed;
+    std::set<std::string> directories;
+    for (s32 i = 0; i < files.size(); i++)
+    {
+        const FileEntry& file = files[i];
+        CopiedFile& result = copied[i];
+        result.path = file.path.substr(source.size() + 1);
+        result.size = file.size;
+        result.lastWriteTime = file.lastWriteTime;
+        result.hash = hash ? hashes[i] : 0;
+
+        auto it = previousByPath.find(result.path);
+        if (it != previousByPath.end())
+        {
+            const CopiedFile& last = *it->second;
+            previousByPath.erase(it);
+            bool same = last.size == result.size;
+            if (hash && last.hash)
+                same &= last.hash == result.hash;
+            else
+                same &= last.lastWriteTime == result.lastWriteTime;
+            if (same)
+                continue;
+        }
+        changed.push_back(i);
+        size_t slash = result.path.find_last_of('/');
+        if (slash != std::string::npos)
+            directories.insert(result.path.substr(0, slash));
+    }
+
+    run->actionTotal = s32(changed.size());
+    CreateDirectories(destination);
+    for (const std::string& dir : directories)
+        CreateDirectories(destination + '/' + dir);
+
+    //the largest files first so one big pak doesn't start last and run alone
+    std::sort(changed.begin(), changed.end(), [&files](s32 a, s32 b)
+        {
+            return files[a].size > files[b].size;
+        });
+    std::atomic<bool> failed = false;
+    std::vector<u8> copiedOK(files.size(), true); //not vector<bool>, threads write neighbouring entries
+    ParallelFor(s32(changed.size()), [&](s32 i)
+        {
+            s32 index = changed[i];
+            if (!CopyChangedFile(files[index].path, destination + '/' + copied[index].path, files[index].size))
+            {
+                SDL_Log("Couldn't copy %s: %i", files[index].path.c_str(), GetLastError());
+                copiedOK[index] = false;
+                failed = true;
+            }
+            run->actionProgress++;
+        }, 8);
+
+    if (hasManifest)
+    {
+        for (const auto& [path, file] : previousByPath)
+            DeleteFileNow(destination + '/' + path);
+    }
+
+    //files that failed to copy or to replace the old file are left out so the next copy tries them again
+    std::vector<CopiedFile> manifest;
+    for (s32 i = 0; i < copied.size(); i++)
+    {
+        if (copiedOK[i])
+            manifest.push_back(copied[i]);
+    }
+    SaveCopyManifest(manifestPath, manifest);
+
+    if (failed)
+    {
+        Threading::GetInstance().ClearJobs();
+        ShowErrorWindow("Copy Failed", ToString("Some files couldn\'t be copied to \'%s\', see the log for details", destination.c_str()));
+    }
+}
+
+//Links path to target by creating the link next to it and moving it over path,
+//path is never missing if this fails half way
+bool ReplaceWithHardLink(const std::string& path, const std::string& target)
+{
+    std::string temp = path + ".uathelper-link";
+    DeleteFileNow(temp);
+    if (!CreateHardLinkA(temp.c_str(), target.c_str(), NULL))
+        return false;
+    SetFileAttributesA(path.c_str(), FILE_ATTRIBUTE_NORMAL);
+    if (!MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        DeleteFileNow(temp);
+        return false;
+    }
+    return true;
+}
+
+void DedupeJob::RunJob()
+{
+    StartBuildAction(*run, "Deduplicating");
+    DEFER { FinishBuildAction(*run); };
+
+    //NOTE(CSH): only files that share their size with another file can have a duplicate,
+    //that skips hashing most of a build. Tiny files aren't worth a link
+    const u64 minimumSize = 4096;
+    std::vector<FileEntry> files;
+    for (const std::string& dir : directories)
+        ScanFiles(dir, files);
+    //UAT rewrites the staging directory in place, a link in there would write the next stage into every kept build
+    const std::string staging = ArtifactOutputDirectory(run->request);
+    const bool stagingAbsolute = (staging.size() > 1 && staging[1] == ':') || staging.starts_with("//");
+    if (stagingAbsolute)
+    {
+        const std::string normalizedStaging = NormalizedActionPath(staging);
+        size_t before = files.size();
+        std::erase_if(files, [&normalizedStaging](const FileEntry& file)
+            {
+                return IsSameOrInside(NormalizedActionPath(file.path), normalizedStaging);
+            });
+        if (files.size() != before)
+            SDL_Log("@dedupe skipped %i files in the staging directory %s", s32(before - files.size()), staging.c_str());
+    }
+    std::unordered_map<u64, s32> sizeCounts;
+    for (const FileEntry& file : files)
+        sizeCounts[file.size]++;
+    std::erase_if(files, [&sizeCounts, minimumSize](const FileEntry& file)
+        {
+            return file.size < minimumSize || sizeCounts[file.size] < 2;
+        });
+
+    run->actionTotal = s32(files.size());
+    HashCache& hashCache = HashCache::GetInstance();
+    std::vector<u64> hashes;
+    hashCache.HashFiles(files, hashes, &run->actionProgress);
+
+    struct Content {
+        u64 size;
+        u64 hash;
+        bool operator==(const Content& rhs) const = default;
+    };
+    struct ContentHash {
+        size_t operator()(const Content& c) const
+        {
+            return size_t(c.hash ^ (c.size * 0x9E3779B97F4A7C15ull));
+        }
+    };
+    std::unordered_map<Content, std::vector<s32>, ContentHash> groups;
+    for (s32 i = 0; i < files.size(); i++)
+    {
+        if (hashes[i])
+            groups[{ files[i].size, hashes[i] }].push_back(i);
+    }
+
+    struct Link {
+        s32 file;
+        s32 target;
+    };
+    std::vector<Link> links;
+    for (const auto& [content, group] : groups)
+    {
+        if (group.size() < 2)
+            continue;
+        //link to the file that already has the most links so the least files get replaced
+        std::unordered_map<u64, s32> idCounts;
+        s32 target = group[0];
+        for (s32 index : group)
+        {
+            if (++idCounts[files[index].fileID] > idCounts[files[target].fileID])
+                target = index;
+        }
+        for (s32 index : group)
+        {
+            if (files[index].fileID != files[target].fileID)
+                links.push_back({ index, target });
+        }
+    }
+
+    run->actionProgress = 0;
+    run->actionTotal = s32(links.size());
+    std::atomic<s32> failures = 0;
+    std::atomic<s32> mismatches = 0;
+    ParallelFor(s32(links.size()), [&](s32 i)
+        {
+            const FileEntry& file = files[links[i].file];
+            const FileEntry& target = files[links[i].target];
+            //a link can't be undone, the hash only finds the candidates
+            if (!SameFileContent(file.path, target.path))
+            {
+                SDL_Log("@dedupe: %s and %s have the same size and hash but different content", file.path.c_str(), target.path.c_str());
+                mismatches++;
+            }
+            else if (ReplaceWithHardLink(file.path, target.path))
+            {
+                FileEntry linked = target;
+                linked.path = file.path;
+                hashCache.Set(linked, hashes[links[i].target]);
+                run->actionBytesSaved += file.size;
+            }
+            else
+            {
+                //NTFS allows 1023 links per file and links can't cross volumes
+                failures++;
+            }
+            run->actionProgress++;
+        });
+    hashCache.Save();
+
+    SDL_Log("Deduplicated %i files, %llu MB reclaimed, %i files couldn't be linked, %i differed from their hash match",
+            s32(links.size()) - failures - mismatches, (u64)run->actionBytesSaved / (1024 * 1024), (s32)failures, (s32)mismatches);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Math.h"
+#include "BuildQueue.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+//NOTE(CSH): build events starting with '@' run a built in action instead of a program.
+//{Root} and {Project} expand to the root directory and the directory of the .uproject,
+//relative paths are relative to the project directory
+//  @clean [-background] <dir>...   deletes the directories, -background renames them aside and deletes them after.
+//                                  Drive roots and directories that are or contain the root or project directory are refused
+//  @copy [-hash] <source> <dest>   copies the files that changed since the last copy and deletes the ones
+//                                  that were removed, -hash compares the contents when the timestamps differ
+//  @dedupe <dir>...                replaces identical files in the directories with hardlinks to one copy,
+//                                  only for builds that are kept around and not written to again.
+//                                  Files are compared byte for byte before linking, the staging directory is skipped
+bool IsBuildAction(const std::string& event);
+//Returns nullptr and shows an error for unknown actions
+Job* CreateBuildActionJob(const std::string& event, const std::shared_ptr<BuildRun>& run);
+std::vector<std::string> SplitActionArguments(const std::string& event);
+std::string ExpandActionPath(const std::string& path, const BuildRequest& request);
+
+struct CleanJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    std::vector<std::string> directories;
+    bool background = false;
+    virtual void RunJob() override;
+};
+
+struct CopyJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    std::string source;
+    std::string destination;
+    bool hash = false;
+    virtual void RunJob() override;
+};
+
+struct DedupeJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    std::vector<std::string> directories;
+    virtual void RunJob() override;
+};
@@ -0,0 +1,330 @@
+#include "BuildQueue.h"
+#include "Windows.h"
+#include "UATLog.h"
+#include "Fingerprint.h"
+#include "ArtifactCache.h"
+#include "Prefetch.h"
+#include "BuildActions.h"
+#include "SizeAnalytics.h"
+#include "UATWarmup.h"
+
+bool SeperatePathAndArguments(const std::string& input, std::string& path, std::string& args)
+{
+    char charSeperator = ' ';
+    if (input[0] == '\"')
+    {
+        charSeperator = '\"';
+    }
+    //look for end quote or space
+    s32 i = 1;
+    for (; i < input.size(); i++)
+    {
+        if (input[i] == charSeperator)
+            break;
+    }
+#if 0
+    //NOTE(CSH): finding if there is an included name without a '-' after the exe name.
+    //This needs to be included in the path not the args
+    if (charSeperator == ' ')
+    {
+        for (; i < input.size() && input[i] != '-'; i++)
+        { }
+        if (input[i] == '-')
+            i--;
+    }
+#endif
+    s32 maxValue = Min<s32>((s32)input.size(), i + 1);
+    path = input.substr(0, maxValue);
+    if (maxValue == input.size())
+    {
+        args.clear();
+        return false;
+    }
+
+    args = input.substr(maxValue,   input.size() - (maxValue));
+    return true;
+}
+
+//NOTE(CSH): the job keeps the run alive through the flag, a cancel lets the worker skip what is left of the build
+//instead of the main thread taking the jobs out from under it
+void SubmitBuildJob(Job* job, const std::shared_ptr<BuildRun>& run, Threading& threading)
+{
+    job->cancelled = std::shared_ptr<const std::atomic<bool>>(run, &run->cancelled);
+    threading.SubmitJob(job);
+}
+
+void SubmitProcessSingle(const std::string& name, const ProcessSettings& process, const std::shared_ptr<BuildRun>& run, Threading& thread)//, bool keepAlive)
+{
+    //TODO: Make this function and surrounding code more robust
+
+    if (name.size() < 2)
+    {
+        ShowErrorWindow("RunProcess Error", "Trying to run process with path.size() < 2");
+        assert(false);
+        return;
+    }
+
+    StartProcessJob* job = new StartProcessJob();
+    SeperatePathAndArguments(name, job->applicationPath, job->arguments);
+    job->process = process;
+    SubmitBuildJob(job, run, thread);
+}
+
+void SubmitProcessList(const std::vector<BuildEvent>& events, const std::shared_ptr<BuildRun>& run, Threading& thread)
+{
+    for (const BuildEvent& b : events)
+    {
+        if (IsBuildAction(b.name))
+        {
+            if (Job* job = CreateBuildActionJob(b.name, run))
+                SubmitBuildJob(job, run, thread);
+        }
+        else
+        {
+            SubmitProcessSingle(b.name, b.process, run, thread);
+        }
+    }
+}
+
+void GetEnabledBuildEvents(const BuildEvents& be, const std::vector<s32>& enabledIDs, std::vector<BuildEvent>& out)
+{
+    out.clear();
+    for (s32 i = 0; i < enabledIDs.size(); i++)
+    {
+        BuildEvent b;
+        if (be.Get(b, enabledIDs[i]))
+            out.push_back(b);
+    }
+}
+
+void SubmitBuildRequest(const std::shared_ptr<BuildRun>& run, const HostBudget& hostBudget, Threading& threading)
+{
+    const BuildRequest& request = run->request;
+    SubmitProcessList(request.preBuildEvents, run, threading);
+
+    //after the pre build events since they can change the project (syncing etc.)
+    const bool useArtifactCache = run->useArtifactCache && IsCacheableBuild(request);
+    if ((run->fingerprintMode != FingerprintMode_Off || useArtifactCache) && request.projectPath.size())
+    {
+        FingerprintJob* fingerprint = new FingerprintJob();
+        fingerprint->run = run;
+        fingerprint->mode = run->fingerprintMode;
+        SubmitBuildJob(fingerprint, run, threading);
+    }
+    const bool reportSize = ContainsSwitch(request.commandLine, "stage") && request.projectPath.size();
+    if (useArtifactCache || reportSize)
+    {
+        StagedSnapshotJob* snapshot = new StagedSnapshotJob();
+        snapshot->run = run;
+        SubmitBuildJob(snapshot, run, threading);
+    }
+    if (useArtifactCache)
+    {
+        ArtifactRestoreJob* restore = new ArtifactRestoreJob();
+        restore->run = run;
+        SubmitBuildJob(restore, run, threading);
+    }
+
+    if (run->prefetchContent && request.projectPath.size() && ContainsSwitch(request.commandLine, "cook"))
+    {
+        PrefetchContentJob* prefetch = new PrefetchContentJob();
+        prefetch->run = run;
+        SubmitBuildJob(prefetch, run, threading);
+    }
+
+    if (run->uatWarmup)
+    {
+        UATWarmupJob* warmup = new UATWarmupJob();
+        warmup->run = run;
+        SubmitBuildJob(warmup, run, threading);
+    }
+
+    RunUATJob* job = new RunUATJob();
+    SeperatePathAndArguments(request.commandLine, job->applicationPath, job->arguments);
+    job->rootPath = request.rootPath;
+    job->process = request.uatProcess;
+    job->hostBudget = hostBudget;
+    job->run = run;
+    SubmitBuildJob(job, run, threading);
+
+    if (useArtifactCache)
+    {
+        ArtifactStoreJob* store = new ArtifactStoreJob();
+        store->run = run;
+        store->maxBytes = run->artifactCacheMaxBytes;
+        SubmitBuildJob(store, run, threading);
+    }
+    if (reportSize)
+    {
+        SizeReportJob* sizeReport = new SizeReportJob();
+        sizeReport->run = run;
+        SubmitBuildJob(sizeReport, run, threading);
+    }
+
+    SubmitProcessList(request.postBuildEvents, run, threading);
+
+    FinishBuildJob* finish = new FinishBuildJob();
+    finish->run = run;
+    SubmitBuildJob(finish, run, threading);
+}
+
+void FinishBuildJob::RunJob()
+{
+    run->state = BuildState_Succeeded;
+}
+
+bool SameBuildEvents(const std::vector<BuildEvent>& a, const std::vector<BuildEvent>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (s32 i = 0; i < a.size(); i++)
+    {
+        if (a[i].name != b[i].name || a[i].process != b[i].process)
+            return false;
+    }
+    return true;
+}
+
+bool SameBuildRequest(const BuildRequest& a, const BuildRequest& b)
+{
+    return a.configFile     == b.configFile &&
+           a.platform       == b.platform &&
+           a.rootPath       == b.rootPath &&
+           a.projectPath    == b.projectPath &&
+           a.commandLine    == b.commandLine &&
+           a.uatProcess     == b.uatProcess &&
+           a.fatalPatterns  == b.fatalPatterns &&
+           SameBuildEvents(a.preBuildEvents,  b.preBuildEvents) &&
+           SameBuildEvents(a.postBuildEvents, b.postBuildEvents);
+}
+
+void BuildQueue::Load()
+{
+    LoadBuildQueue(m_requests);
+    //Don't start building behind the users back after a restart
+    m_paused = m_requests.size() > 0;
+}
+
+void BuildQueue::Save() const
+{
+    SaveBuildQueue(m_requests);
+}
+
+bool BuildQueue::Add(const BuildRequest& request)
+{
+    //the running build counts too, only a cancelled one can be queued again right away
+    s32 first = (IsRunning() && m_current->cancelled) ? 1 : 0;
+    for (s32 i = first; i < m_requests.size(); i++)
+    {
+        if (SameBuildRequest(m_requests[i], request))
+            return false;
+    }
+    m_requests.push_back(request);
+    Save();
+    return true;
+}
+
+void BuildQueue::Remove(s32 index)
+{
+    if (index < 0 || index >= m_requests.size())
+        return;
+    if (index == 0 && IsRunning())
+        return;
+    m_requests.erase(m_requests.begin() + index);
+    Save();
+}
+
+void BuildQueue::Cancel()
+{
+    if (!m_current)
+        return;
+    //the job that is running stops on its own (UAT, host slot wait) and the worker skips the rest
+    m_current->cancelled = true;
+}
+
+void BuildQueue::Move(s32 index, s32 offset)
+{
+    s32 firstPending = IsRunning() ? 1 : 0;
+    s32 target = index + offset;
+    if (index < firstPending || index >= m_requests.size())
+        return;
+    if (target < firstPending || target >= m_requests.size())
+        return;
+    std::swap(m_requests[index], m_requests[target]);
+    Save();
+}
+
+BuildRequest MakeResumeRequest(const BuildRun& run)
+{
+    BuildRequest request = run.request;
+    request.commandLine = BuildResumeCommandLine(request.commandLine, run.phasesCompleted);
+    //NOTE(CSH): the pre build events already ran and could undo the phases that are skipped (cleaning etc.)
+    if (run.phasesCompleted)
+        request.preBuildEvents.clear();
+    return request;
+}
+
+void BuildQueue::ResumeLastFailed()
+{
+    if (!m_lastFailed)
+        return;
+    s32 firstPending = IsRunning() ? 1 : 0;
+    m_requests.insert(m_requests.begin() + firstPending, MakeResumeRequest(*m_lastFailed));
+    m_lastFailed = nullptr;
+    m_paused = false;
+    Save();
+}
+
+BuildState BuildQueue::Update(Threading& threading, const AppSettings& appSettings)
+{
+    if (!threading.IsIdle())
+        return BuildState_Running;
+
+    BuildState finished = BuildState_Running;
+    if (m_current)
+    {
+        finished = m_current->state == BuildState_Succeeded ? BuildState_Succeeded : BuildState_Failed;
+        m_current->state = finished;
+        if (m_requests.size())
+            m_requests.erase(m_requests.begin());
+        if (finished == BuildState_Failed && m_current->WillRetry())
+        {
+            BuildRequest retry = MakeResumeRequest(*m_current);
+            retry.retryCount++;
+            m_requests.insert(m_requests.begin(), retry);
+            finished = BuildState_Running;
+        }
+        else if (finished == BuildState_Failed)
+        {
+            m_lastFailed = m_current;
+            //a failed build stops the queue so the rest doesn't run on top of a broken state
+            if (m_requests.size())
+                m_paused = true;
+        }
+        else
+        {
+            m_lastFailed = nullptr;
+            RecordSuccessfulFingerprint(*m_current);
+        }
+        m_current = nullptr;
+        Save();
+    }
+
+    if (!m_paused && m_requests.size())
+    {
+        m_current = std::make_shared<BuildRun>();
+        m_current->request = m_requests[0];
+        m_current->retriesAllowed = appSettings.transientFailureRetries;
+        m_current->fingerprintMode = appSettings.fingerprintMode;
+        m_current->useArtifactCache = appSettings.artifactCache;
+        m_current->prefetchContent = appSettings.prefetchContent;
+        m_current->sizeGrowthWarningPercent = appSettings.sizeGrowthWarningPercent;
+        m_current->uatWarmup = appSettings.uatWarmup;
+        m_current->artifactCacheMaxBytes = u64(Max(appSettings.artifactCacheMaxGB, 1)) * 1024 * 1024 * 1024;
+        if (m_dryRun)
+            m_current->state = BuildState_Succeeded;
+        else
+            SubmitBuildRequest(m_current, appSettings.hostBudget, threading);
+    }
+    return finished;
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include "Config.h"
+#include "Threading.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum BuildState : s32 {
+    BuildState_Running,
+    BuildState_Succeeded,
+    BuildState_Failed,
+};
+
+//Shared between the queue on the main thread and the jobs of a single build
+struct BuildRun {
+    BuildRequest request;
+    s32 retriesAllowed = 0;
+    std::atomic<s32> state = BuildState_Running;
+    //written by the UAT log monitor while UAT runs
+    std::atomic<u32> phasesCompleted = 0; //bit per UATPhase
+    std::atomic<s32> currentPhase = -1; //the phase a failed build failed in
+    std::atomic<bool> transientFailure = false;
+    std::atomic<bool> cancelled = false; //set by the main thread, stops the host slot wait and UAT
+    std::string abortReason; //log line of the fatal pattern that stopped UAT
+    s32 fingerprintMode = FingerprintMode_Off;
+    //written by the fingerprint job before UAT starts
+    std::atomic<s32> fingerprintProgress = 0;
+    std::atomic<s32> fingerprintTotal = 0;
+    std::atomic<bool> fingerprinted = false;
+    ProjectFingerprint fingerprint;
+    std::string fingerprintKey;
+    std::string extraArguments; //appended to the UAT command line
+    bool useArtifactCache = false;
+    u64 artifactCacheMaxBytes = 0;
+    u64 artifactKey = 0;
+    std::atomic<s32> artifactState = 0; //ArtifactState
+    std::atomic<s32> artifactProgress = 0;
+    std::atomic<s32> artifactTotal = 0;
+    std::map<std::string, u64> stagedSnapshot; //before the artifact restore and UAT ran
+    bool prefetchContent = false;
+    //written by the prefetch thread which can outlive the build
+    std::atomic<s32> prefetchState = 0; //PrefetchState
+    std::atomic<u64> prefetchBytes = 0;
+    std::atomic<u64> prefetchTotalBytes = 0;
+    std::atomic<u64> prefetchMilliseconds = 0;
+    //written by the built in build event that is running (@clean etc.)
+    std::atomic<const char*> actionName = nullptr;
+    std::atomic<s32> actionProgress = 0;
+    std::atomic<s32> actionTotal = 0;
+    std::atomic<u64> actionStartTicks = 0;
+    std::atomic<u64> actionMilliseconds = 0; //0 while the action runs
+    std::atomic<u64> actionBytesSaved = 0;
+    s32 sizeGrowthWarningPercent = 0;
+    bool uatWarmup = false;
+
+    bool WillRetry() const
+    {
+        return transientFailure && abortReason.empty() && request.retryCount < retriesAllowed;
+    }
+    bool CanResume() const
+    {
+        return state == BuildState_Failed && phasesCompleted != 0;
+    }
+};
+
+//Runs once every other job of the build has finished successfully,
+//if any of them fail the remaining jobs are cleared and this never runs
+struct FinishBuildJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    virtual void RunJob() override;
+};
+
+//NOTE(CSH): the front request is the one running while m_current is set, it is only removed
+//from the queue (and the queue file) once the build finished so a restart picks it back up
+struct BuildQueue {
+    std::vector<BuildRequest>   m_requests;
+    std::shared_ptr<BuildRun>   m_current;
+    std::shared_ptr<BuildRun>   m_lastFailed;
+    bool                        m_paused = false;
+    bool                        m_dryRun = false; //builds start and succeed without running anything, for replays and benchmarks
+
+    void Load();
+    void Save() const;
+    //returns false when an identical request is already running or waiting in the queue
+    bool Add(const BuildRequest& request);
+    void Remove(s32 index);
+    void Move(s32 index, s32 offset);
+    //Stops the running build, it fails like any other build and its request is removed when Update sees it
+    void Cancel();
+    //Queues the last failed build again in front of everything else, skipping the phases that completed
+    void ResumeLastFailed();
+    bool IsRunning() const
+    {
+        return m_current != nullptr;
+    }
+    //Call once per frame, starts the next build when the job threads are idle
+    //and returns the state of a build that finished this frame (BuildState_Running if none did)
+    BuildState Update(Threading& threading, const AppSettings& appSettings);
+};
+
+bool SameBuildRequest(const BuildRequest& a, const BuildRequest& b);
+bool SeperatePathAndArguments(const std::string& input, std::string& path, std::string& args);
+void GetEnabledBuildEvents(const BuildEvents& be, const std::vector<s32>& enabledIDs, std::vector<BuildEvent>& out);
+void SubmitBuildRequest(const std::shared_ptr<BuildRun>& run, const HostBudget& hostBudget, Threading& threading);
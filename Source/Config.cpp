@@ -1,9 +1,15 @@
 #include "Config.h"
 #include "Windows.h"
+#include "ConfigCatalog.h"
+#include "AsyncFileWriter.h"
+#include "JsonStream.h"
+#include "FileSystem.h"
+#include "SettingsHistory.h"
+#include "StringTable.h"
 
-#include "json.hpp"
-
+#include <algorithm>
 #include <fstream>
+#include <unordered_map>
 
 
 const char* appSettingsFileName     = "UATHelper.json";
@@ -14,6 +20,15 @@ const char* colorSelectionText      = "Color Selection";
 const char* styleSelectionText      = "Style Selection";
 const char* currentFileText         = "Currently Loaded File";
 const char* configDirectoryText     = "Config Directory";
+const char* hostMaxBuildsText       = "Host Max Concurrent Builds";
+const char* hostMemoryBudgetText    = "Host Memory Budget MB";
+const char* transientRetriesText    = "Transient Failure Retries";
+const char* fingerprintModeText     = "Fingerprint Mode";
+const char* artifactCacheText       = "Artifact Cache";
+const char* artifactCacheMaxGBText  = "Artifact Cache Max GB";
+const char* prefetchContentText     = "Prefetch Content";
+const char* sizeGrowthWarningText   = "Size Growth Warning Percent";
+const char* uatWarmupText           = "Warm Up AutomationTool";
 
 const char* platformSelectionText   = "Platform Selection";
 const char* rootPathText            = "Root Path";
@@ -28,9 +43,45 @@ const char* enabledVersionsText     = "Enabled Versions";
 const char* enabledSwitchesText     = "Enabled Switches";
 const char* enabledPreBuildText     = "Enabled Pre Build";
 const char* enabledPostBuildText    = "Enabled Post Build";
+const char* uatProcessText          = "UAT Process Settings";
+const char* preBuildProcessText     = "Pre Build Process Settings";
+const char* postBuildProcessText    = "Post Build Process Settings";
+const char* buildQueueFileName      = "BuildQueue.json";
+const char* buildQueueText          = "Build Queue";
+const char* configFileText          = "Config File";
+const char* platformText            = "Platform";
+const char* commandLineText         = "Command Line";
+const char* nameText                = "Name";
+const char* processSettingsText     = "Process Settings";
+const char* priorityText            = "Priority";
+const char* affinityMaskText        = "Affinity Mask";
+const char* useJobObjectText        = "Use Job Object";
+const char* cpuRatePercentText      = "CPU Rate Percent";
+const char* memoryLimitMBText       = "Memory Limit MB";
+const char* fatalPatternsText       = "Fatal Log Patterns";
+const char* patternText             = "Pattern";
+const char* countText               = "Count";
+const char* fingerprintsFileName    = "Fingerprints.json";
+const char* sourceText              = "Source";
+const char* contentText             = "Content";
+const char* manifestsText           = "Manifests";
+const char* keyText                 = "Key";
+const char* lastUsedText            = "Last Used";
+const char* filesText               = "Files";
+const char* pathText                = "Path";
+const char* hashText                = "Hash";
+const char* sizeText                = "Size";
+const char* lastWriteTimeText       = "Last Write Time";
+
+const char* sizeHistoryFileName     = "SizeHistory.json";
+const char* reportsText             = "Reports";
+const char* timeText                = "Time";
+const char* totalBytesText          = "Total Bytes";
+const char* directoriesText         = "Directories";
+const char* extensionsText          = "Extensions";
+const char* bytesText               = "Bytes";
 
 
-Settings fileSettings = {};
 AppSettings appSettings = {};
 
 void BuildEvents::RemoveNullElements()
@@ -73,8 +124,7 @@ bool BuildEvents::Get(BuildEvent& out, const s32 id) const
     {
         if (m_events[i].id == id)
         {
-            out.id      = m_events[i].id;
-            out.name    = m_events[i].name;
+            out = m_events[i];
             return true;
         }
     }
@@ -88,21 +138,17 @@ bool BuildEvents::Get(BuildEvent& out, const std::string& s) const
     {
         if (m_events[i].name == s)
         {
-            out.id      = m_events[i].id;
-            out.name    = m_events[i].name;
+            out = m_events[i];
             return true;
         }
     }
     return false;
 }
 
-s32 ComparisonFunction(const void* a, const void* b)
-{
-    return  *(s32*)b - *(s32*)a;
-}
+//NOTE(CSH): QuickSort takes the last element as the pivot which is quadratic on the already sorted lists saved every time
 void SortData(std::vector<s32>& data)
 {
-    QuickSort((u8*)data.data(), (s32)data.size(), sizeof(data[0]), ComparisonFunction);
+    std::sort(data.begin(), data.end());
 }
 void SortConfig(Settings& set)
 {
@@ -120,7 +166,7 @@ void SortConfig(Settings& set)
 void RemoveNullStrings(const std::vector<std::string>& strings, std::vector<s32>& vals)
 {
     std::erase_if(vals,
-        [strings](s32 val)
+        [&strings](s32 val)
         {
             return strings[val].empty();
         });
@@ -136,224 +182,460 @@ void RemoveNullStrings(std::vector<std::string>& strings)
 void RemoveNullIDs(std::vector<s32>& IDs, const BuildEvents& be)
 {
     std::erase_if(IDs,
-        [be](s32& id)
+        [&be](s32& id)
         {
-            BuildEvent b;
-            if (be.Get(b, id))
-            {
-                return b.name.empty();
-            }
-            return true;
+            auto it = std::find_if(be.m_events.begin(), be.m_events.end(), [id](const BuildEvent& b) { return b.id == id; });
+            return it == be.m_events.end() || it->name.empty();
         });
 }
-void AddParentAndChildrenInt(nlohmann::json& root, const std::string& option, std::vector<s32>& IDs, const BuildEvents& be)
+void ValidateLoadConfig(Settings& settings)
 {
-    if (!IDs.size())
-        return;
-    RemoveNullIDs(IDs, be);
-    BuildEvent b;
-    for (s32 i = 0; i < IDs.size(); i++)
+    if (!settings.platformOptions.size())
     {
-        if (be.Get(b, IDs[i]))
-            root[option].push_back(b.name);
+        ShowErrorWindow("Invalid Config", ToString("\'%s\' needs to be greater than 0", platformOptionsText));
     }
 }
-void AddParentAndChildrenInt(nlohmann::json& root, const std::string& option, std::vector<s32>& data, const std::vector<std::string>& names)
+
+void JsonRead(JsonReader& r, ProcessSettings& out);
+void JsonWrite(JsonWriter& w, const ProcessSettings& in);
+void JsonRead(JsonReader& r, std::vector<FatalLogPattern>& out);
+void JsonWrite(JsonWriter& w, const std::vector<FatalLogPattern>& in);
+
+//NOTE(CSH): the tables are in the order nlohmann wrote the keys (sorted) so existing files don't change on save
+const JsonField<ProcessSettings> processSettingsFields[] = {
+    JsonMember<&ProcessSettings::affinityMask>(affinityMaskText),
+    JsonMember<&ProcessSettings::cpuRatePercent>(cpuRatePercentText),
+    JsonMember<&ProcessSettings::memoryLimitMB>(memoryLimitMBText),
+    JsonMember<&ProcessSettings::priority>(priorityText),
+    JsonMember<&ProcessSettings::useJobObject>(useJobObjectText),
+};
+const JsonField<FatalLogPattern> fatalPatternFields[] = {
+    JsonMember<&FatalLogPattern::count>(countText),
+    JsonMember<&FatalLogPattern::text>(patternText),
+};
+
+void JsonRead(JsonReader& r, ProcessSettings& out)
 {
-    if (!data.size())
-        return;
-    RemoveNullStrings(names, data);
-    for (s32 i = 0; i < data.size(); i++)
+    JsonReadObject(r, out, processSettingsFields);
+    out.priority        = Clamp<s32>(out.priority, 0, ProcessPriority_Count - 1);
+    out.cpuRatePercent  = Clamp<s32>(out.cpuRatePercent, 0, 100);
+    out.memoryLimitMB   = Max<s32>(out.memoryLimitMB, 0);
+}
+void JsonWrite(JsonWriter& w, const ProcessSettings& in)
+{
+    JsonWriteObject(w, in, processSettingsFields);
+}
+void JsonRead(JsonReader& r, std::vector<FatalLogPattern>& out)
+{
+    JsonReadArray(r, out, fatalPatternFields,
+        [](FatalLogPattern& pattern)
+        {
+            pattern.count = Max(pattern.count, 1);
+            return !pattern.text.empty();
+        });
+}
+void JsonWrite(JsonWriter& w, const std::vector<FatalLogPattern>& in)
+{
+    w.BeginArray();
+    for (const FatalLogPattern& pattern : in)
     {
-        root[option].push_back(names[data[i]]);
+        if (pattern.text.size())
+            JsonWriteObject(w, pattern, fatalPatternFields);
     }
+    w.EndArray();
 }
-void AddBuildEvents(nlohmann::json& j, const char* name, const BuildEvents& events)
+
+//Platforms and build events reference options by name in the file and by index/id in Settings,
+//the names are kept until the whole file is read since the options can come after the platforms.
+//Every platform repeats the same names so they are interned instead of copied for each one
+struct PlatformFile {
+    std::string name;
+    std::vector<StringHandle> enabledVersions;
+    std::vector<StringHandle> enabledSwitches;
+    std::vector<StringHandle> enabledPreBuild;
+    std::vector<StringHandle> enabledPostBuild;
+};
+
+struct BuildEventProcessFile {
+    std::string name;
+    ProcessSettings process;
+};
+
+struct ConfigFile {
+    Settings& settings;
+    s32 version = 0;
+    std::vector<PlatformFile> platforms;
+    std::vector<BuildEventProcessFile> preBuildProcess;
+    std::vector<BuildEventProcessFile> postBuildProcess;
+};
+
+void ReadInternedNames(JsonReader& r, std::vector<StringHandle>& out)
 {
-    for (s32 i = 0; i < events.m_events.size(); i++)
+    std::string name;
+    out.clear();
+    if (!r.BeginArray())
+        return;
+    while (r.NextElement())
     {
-        j[name].push_back(events.m_events[i].name);
+        if (r.ReadString(name))
+            out.push_back(Intern(name));
     }
 }
-void SaveConfig(Settings& settings, const std::string& filename)
+//Only read, WritePlatforms writes the names from Settings
+template <auto Member>
+constexpr JsonField<PlatformFile> PlatformNamesField(const char* name)
 {
-    SortConfig(settings);
-    nlohmann::json j;
+    return { name, [](JsonReader& r, PlatformFile& out) { ReadInternedNames(r, out.*Member); }, nullptr };
+}
 
-    j[versionText]              = settings.version;
-    j[platformSelectionText]    = settings.platformSelection;
-    j[rootPathText]             = settings.rootPath;
-    j[projectPathText]          = settings.projectPath;
+const JsonField<PlatformFile> platformFileFields[] = {
+    PlatformNamesField<&PlatformFile::enabledPostBuild>(enabledPostBuildText),
+    PlatformNamesField<&PlatformFile::enabledPreBuild>(enabledPreBuildText),
+    PlatformNamesField<&PlatformFile::enabledSwitches>(enabledSwitchesText),
+    PlatformNamesField<&PlatformFile::enabledVersions>(enabledVersionsText),
+};
 
-    for (s32 i = 0; i < settings.platformOptions.size(); i++)
+void ReadBuildEvents(JsonReader& r, BuildEvents& be)
+{
+    std::string name;
+    if (!r.BeginArray())
+        return;
+    while (r.NextElement())
     {
-        if (settings.platformOptions[i].name.empty())
-            continue;
-        PlatformSettings& set = settings.platformOptions[i];
-        AddParentAndChildrenInt(j[platformOptionsText][set.name], enabledVersionsText,      set.enabledVersions,    settings.versionOptions);
-        AddParentAndChildrenInt(j[platformOptionsText][set.name], enabledSwitchesText,      set.enabledSwitches,    settings.switchOptions);
-        AddParentAndChildrenInt(j[platformOptionsText][set.name], enabledPreBuildText,     set.enabledPreBuild,     settings.preBuildEvents);
-        AddParentAndChildrenInt(j[platformOptionsText][set.name], enabledPostBuildText,    set.enabledPostBuild,    settings.postBuildEvents);
+        r.ReadString(name);
+        be.Add(name);
     }
-
-    RemoveNullStrings(settings.versionOptions);
-    RemoveNullStrings(settings.switchOptions);
-    settings.preBuildEvents.RemoveNullElements();
-    settings.postBuildEvents.RemoveNullElements();
-    j[versionOptionsText] = settings.versionOptions;
-    j[switchOptionsText]  = settings.switchOptions;
-    AddBuildEvents(j, preBuildEventsText,   settings.preBuildEvents);
-    AddBuildEvents(j, postBuildEventsText,  settings.postBuildEvents);
-
-    fileSettings = settings;
-
-    std::ofstream o(filename);
-    o << std::setw(4) << j << std::endl;
 }
-
-void GetChildrenString(nlohmann::json& j, const std::string& name, std::vector<std::string>& data)
+//Empty names are removed from the settings after they are written
+void WriteBuildEvents(JsonWriter& w, const char* key, const BuildEvents& be)
 {
-    if (! j[name].is_null())
-        data = j[name];
+    auto named = [](const BuildEvent& e) { return e.name.size(); };
+    if (std::none_of(be.m_events.begin(), be.m_events.end(), named))
+        return;
+    w.Key(key);
+    w.BeginArray();
+    for (const BuildEvent& e : be.m_events)
+    {
+        if (named(e))
+            w.String(e.name);
+    }
+    w.EndArray();
 }
-void GetChildrenString(nlohmann::json& j, const std::string& name, BuildEvents& be)
+void WriteOptions(JsonWriter& w, const char* key, const std::vector<std::string>& options)
 {
-    if (!j[name].is_null())
+    w.Key(key);
+    w.BeginArray();
+    for (const std::string& s : options)
     {
-        for (auto it = j[name].begin(); it != j[name].end(); it++)
-        {
-            be.Add(it.value().get<std::string>());
-        }
+        if (s.size())
+            w.String(s);
     }
+    w.EndArray();
 }
-
-
-s32 FindStringInArray(const std::string& s, const std::vector<std::string>& data)
+void ReadBuildEventsProcess(JsonReader& r, std::vector<BuildEventProcessFile>& out)
 {
-    for (s32 i = 0; i < data.size(); i++)
+    std::string_view key;
+    if (!r.BeginObject())
+        return;
+    while (r.NextKey(key))
     {
-        if (data[i] == s)
-            return i;
+        BuildEventProcessFile& e = out.emplace_back();
+        e.name = key;
+        if (!r.ReadNull())
+            JsonRead(r, e.process);
     }
-    return INT_MAX;
 }
-
-void LoadPlatformSettingsChildren(const std::string& optionsName, const auto& src, std::vector<s32>& dest, const BuildEvents& be)
+//Entries are sorted by name and events with the default settings are left out
+void WriteBuildEventsProcess(JsonWriter& w, const char* key, const BuildEvents& be)
 {
-    if (src.contains(optionsName))
+    std::vector<const BuildEvent*> events;
+    for (const BuildEvent& e : be.m_events)
     {
-        const auto& data = src[optionsName];
-        BuildEvent b;
-        for (auto it = data.begin(); it != data.end(); it++)
-        {
-            
-            const std::string& s = it.value();
-            if (be.Get(b, s))
-            {
-                dest.push_back(b.id);
-            }
-            else
-            {
-                assert(false);
-                ShowErrorWindow("String Not Found In Array", ToString("\'%s\' not found in \'%s\'", it.value().get<std::string>().c_str(), optionsName.c_str()));
-            }
-        }
+        if (e.name.size() && e.process != ProcessSettings())
+            events.push_back(&e);
+    }
+    if (events.empty())
+        return;
+    std::stable_sort(events.begin(), events.end(), [](const BuildEvent* a, const BuildEvent* b) { return a->name < b->name; });
+    w.Key(key);
+    w.BeginObject();
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        if (i && events[i]->name == events[i - 1]->name)
+            continue;
+        w.Key(events[i]->name);
+        JsonWrite(w, events[i]->process);
+    }
+    w.EndObject();
+}
+void WriteEnabledNames(JsonWriter& w, const char* key, const std::vector<s32>& enabled, const std::vector<std::string>& names)
+{
+    if (enabled.empty())
+        return;
+    w.Key(key);
+    w.BeginArray();
+    for (s32 index : enabled)
+        w.String(names[index]);
+    w.EndArray();
+}
+void WriteEnabledNames(JsonWriter& w, const char* key, const std::vector<s32>& enabled, const std::unordered_map<s32, const std::string*>& names)
+{
+    if (enabled.empty())
+        return;
+    w.Key(key);
+    w.BeginArray();
+    for (s32 id : enabled)
+    {
+        auto it = names.find(id);
+        if (it != names.end())
+            w.String(*it->second);
+    }
+    w.EndArray();
+}
+void AddLookup(std::unordered_map<s32, const std::string*>& lookup, const BuildEvents& be)
+{
+    lookup.reserve(be.m_events.size());
+    for (const BuildEvent& e : be.m_events)
+        lookup.emplace(e.id, &e.name);
+}
+void ReadPlatforms(JsonReader& r, std::vector<PlatformFile>& out)
+{
+    std::string_view key;
+    if (!r.BeginObject())
+        return;
+    while (r.NextKey(key))
+    {
+        PlatformFile& platform = out.emplace_back();
+        platform.name = key;
+        if (!r.ReadNull())
+            JsonReadObject(r, platform, platformFileFields);
     }
 }
-void LoadPlatformSettingsChildren(const std::string& optionsName, const auto& src, std::vector<s32>& dest, const std::vector<std::string>& optionNames)
+//Platforms are sorted by name, one without anything enabled is written as null
+void WritePlatforms(JsonWriter& w, const char* key, const Settings& settings)
 {
-    if (src.contains(optionsName))
+    std::vector<const PlatformSettings*> platforms;
+    for (const PlatformSettings& p : settings.platformOptions)
+    {
+        if (p.name.size())
+            platforms.push_back(&p);
+    }
+    if (platforms.empty())
+        return;
+    std::stable_sort(platforms.begin(), platforms.end(), [](const PlatformSettings* a, const PlatformSettings* b) { return a->name < b->name; });
+    std::unordered_map<s32, const std::string*> preBuild;
+    std::unordered_map<s32, const std::string*> postBuild;
+    AddLookup(preBuild, settings.preBuildEvents);
+    AddLookup(postBuild, settings.postBuildEvents);
+    w.Key(key);
+    w.BeginObject();
+    for (size_t i = 0; i < platforms.size(); i++)
     {
-        const auto& data = src[optionsName];
-        for (auto it = data.begin(); it != data.end(); it++)
+        const PlatformSettings& p = *platforms[i];
+        if (i && p.name == platforms[i - 1]->name)
+            continue;
+        w.Key(p.name);
+        if (p.enabledVersions.empty() && p.enabledSwitches.empty() && p.enabledPreBuild.empty() && p.enabledPostBuild.empty())
         {
-            s32 index = FindStringInArray(it.value(), optionNames);
-            if (index == INT_MAX)
-            {
-                assert(false);
-                ShowErrorWindow("String Not Found In Array", ToString("\'%s\' not found in \'%s\'", it.value().get<std::string>().c_str(), optionsName.c_str()));
-                continue;
-            }
-            dest.push_back(index);
+            w.Null();
+            continue;
         }
+        w.BeginObject();
+        WriteEnabledNames(w, enabledPostBuildText,  p.enabledPostBuild, postBuild);
+        WriteEnabledNames(w, enabledPreBuildText,   p.enabledPreBuild,  preBuild);
+        WriteEnabledNames(w, enabledSwitchesText,   p.enabledSwitches,  settings.switchOptions);
+        WriteEnabledNames(w, enabledVersionsText,   p.enabledVersions,  settings.versionOptions);
+        w.EndObject();
     }
+    w.EndObject();
 }
 
-void ValidateLoadConfig(Settings& settings)
+//Settings members are reached through ConfigFile::settings so they get their own field lambdas
+#define CONFIG_FIELD(__key, __member)                                                           \
+    JsonField<ConfigFile>{ __key,                                                               \
+        [](JsonReader& r, ConfigFile& out) { JsonRead(r, out.settings.__member); },         \
+        [](JsonWriter& w, const char* key, const ConfigFile& in) { w.Key(key); JsonWrite(w, in.settings.__member); } }
+
+const JsonField<ConfigFile> configFileFields[] = {
+    CONFIG_FIELD(fatalPatternsText,     fatalPatterns),
+    CONFIG_FIELD(platformSelectionText, platformSelection),
+    {
+        platformOptionsText,
+        [](JsonReader& r, ConfigFile& out) { ReadPlatforms(r, out.platforms); },
+        [](JsonWriter& w, const char* key, const ConfigFile& in) { WritePlatforms(w, key, in.settings); },
+    },
+    {
+        postBuildEventsText,
+        [](JsonReader& r, ConfigFile& out) { ReadBuildEvents(r, out.settings.postBuildEvents); },
+        [](JsonWriter& w, const char* key, const ConfigFile& in) { WriteBuildEvents(w, key, in.settings.postBuildEvents); },
+    },
+    {
+        postBuildProcessText,
+        [](JsonReader& r, ConfigFile& out) { ReadBuildEventsProcess(r, out.postBuildProcess); },
+        [](JsonWriter& w, const char* key, const ConfigFile& in) { WriteBuildEventsProcess(w, key, in.settings.postBuildEvents); },
+    },
+    {
+        preBuildEventsText,
+        [](JsonReader& r, ConfigFile& out) { ReadBuildEvents(r, out.settings.preBuildEvents); },
+        [](JsonWriter& w, const char* key, const ConfigFile& in) { WriteBuildEvents(w, key, in.settings.preBuildEvents); },
+    },
+    {
+        preBuildProcessText,
+        [](JsonReader& r, ConfigFile& out) { ReadBuildEventsProcess(r, out.preBuildProcess); },
+        [](JsonWriter& w, const char* key, const ConfigFile& in) { WriteBuildEventsProcess(w, key, in.settings.preBuildEvents); },
+    },
+    CONFIG_FIELD(projectPathText,       projectPath),
+    CONFIG_FIELD(rootPathText,          rootPath),
+    {
+        switchOptionsText,
+        [](JsonReader& r, ConfigFile& out) { JsonRead(r, out.settings.switchOptions); },
+        [](JsonWriter& w, const char* key, const ConfigFile& in) { WriteOptions(w, key, in.settings.switchOptions); },
+    },
+    CONFIG_FIELD(uatProcessText,        uatProcess),
+    {
+        versionText,
+        [](JsonReader& r, ConfigFile& out) { JsonRead(r, out.version); },
+        [](JsonWriter& w, const char* key, const ConfigFile& in) { w.Key(key); w.Int(in.settings.version); },
+    },
+    {
+        versionOptionsText,
+        [](JsonReader& r, ConfigFile& out) { JsonRead(r, out.settings.versionOptions); },
+        [](JsonWriter& w, const char* key, const ConfigFile& in) { WriteOptions(w, key, in.settings.versionOptions); },
+    },
+};
+#undef CONFIG_FIELD
+
+void ResolveEnabledNames(const std::vector<StringHandle>& names, const std::unordered_map<StringHandle, s32>& lookup, std::vector<s32>& dest, const char* optionsName)
 {
-    if (!settings.platformOptions.size())
+    for (StringHandle name : names)
     {
-        ShowErrorWindow("Invalid Config", ToString("\'%s\' needs to be greater than 0", platformOptionsText));
+        auto it = lookup.find(name);
+        if (it == lookup.end())
+        {
+            assert(false);
+            ShowErrorWindow("String Not Found In Array", ToString("\'%s\' not found in \'%s\'", StringTable::GetInstance().CString(name), optionsName));
+            continue;
+        }
+        dest.push_back(it->second);
     }
 }
-
-bool Valid(const nlohmann::json root, const std::string& text)
+//first entry wins for duplicate names like the linear search did
+void AddLookup(std::unordered_map<StringHandle, s32>& lookup, const std::vector<std::string>& names)
 {
-    return (root.contains(text) && !root[text].is_null());
+    lookup.reserve(names.size());
+    for (s32 i = 0; i < names.size(); i++)
+        lookup.emplace(Intern(names[i]), i);
 }
-
-template <typename T>
-void GetTypeFromValid(const nlohmann::json& root, const char* name, T& var)
+void AddLookup(std::unordered_map<StringHandle, s32>& lookup, const BuildEvents& be, bool ids)
 {
-    if (Valid(root, name))
+    lookup.reserve(be.m_events.size());
+    for (s32 i = 0; i < be.m_events.size(); i++)
+        lookup.emplace(Intern(be.m_events[i].name), ids ? be.m_events[i].id : i);
+}
+void ApplyBuildEventsProcess(const std::vector<BuildEventProcessFile>& processes, BuildEvents& be)
+{
+    std::unordered_map<StringHandle, s32> indices;
+    AddLookup(indices, be, false);
+    for (const BuildEventProcessFile& p : processes)
     {
-        var = root[name].get<T>();
+        auto it = indices.find(Intern(p.name));
+        if (it != indices.end())
+            be.m_events[it->second].process = p.process;
     }
 }
 
-void LoadConfig(Settings& settings, const AppSettings& appSettings)
+bool ReadConfigText(std::string_view text, Settings& out)
 {
-    fileSettings = {};
-    settings = {};
-    std::ifstream file(appSettings.fileNames[appSettings.currentFileNameIndex]);
-    if (file.fail())
+    out = {};
+    ConfigFile file = { out };
+    JsonReader r(text);
+    if (!JsonReadObject(r, file, configFileFields) || file.version != out.version)
+        return false;
+
+    ApplyBuildEventsProcess(file.preBuildProcess, out.preBuildEvents);
+    ApplyBuildEventsProcess(file.postBuildProcess, out.postBuildEvents);
+
+    std::unordered_map<StringHandle, s32> versions;
+    std::unordered_map<StringHandle, s32> switches;
+    std::unordered_map<StringHandle, s32> preBuild;
+    std::unordered_map<StringHandle, s32> postBuild;
+    AddLookup(versions, out.versionOptions);
+    AddLookup(switches, out.switchOptions);
+    AddLookup(preBuild, out.preBuildEvents, true);
+    AddLookup(postBuild, out.postBuildEvents, true);
+    out.platformOptions.reserve(file.platforms.size());
+    for (PlatformFile& p : file.platforms)
     {
-        LoadConfigDefaults(settings);
-        return;
+        PlatformSettings& platform = out.platformOptions.emplace_back();
+        platform.name = std::move(p.name);
+        ResolveEnabledNames(p.enabledVersions,  versions,   platform.enabledVersions,   enabledVersionsText);
+        ResolveEnabledNames(p.enabledSwitches,  switches,   platform.enabledSwitches,   enabledSwitchesText);
+        ResolveEnabledNames(p.enabledPreBuild,  preBuild,   platform.enabledPreBuild,   enabledPreBuildText);
+        ResolveEnabledNames(p.enabledPostBuild, postBuild,  platform.enabledPostBuild,  enabledPostBuildText);
     }
-    nlohmann::json j;
-    file >> j;
 
-    if (!Valid(j, versionText) || j[versionText].get<s32>() != fileSettings.version)
+    if (out.platformSelection >= out.platformOptions.size())
+        out.platformSelection = s32(out.platformOptions.size() - 1);
+    return true;
+}
+
+std::string WriteConfigText(Settings& settings)
+{
+    SortConfig(settings);
+    for (PlatformSettings& set : settings.platformOptions)
     {
-        LoadConfigDefaults(settings);
-        return;
+        if (set.name.empty())
+            continue;
+        RemoveNullStrings(settings.versionOptions, set.enabledVersions);
+        RemoveNullStrings(settings.switchOptions, set.enabledSwitches);
+        RemoveNullIDs(set.enabledPreBuild, settings.preBuildEvents);
+        RemoveNullIDs(set.enabledPostBuild, settings.postBuildEvents);
     }
 
-    GetTypeFromValid<s32>(          j, platformSelectionText,   fileSettings.platformSelection);
-    GetTypeFromValid<std::string>(  j, rootPathText,            fileSettings.rootPath);
-    GetTypeFromValid<std::string>(  j, projectPathText,         fileSettings.projectPath);
+    JsonWriter w;
+    ConfigFile file = { settings };
+    JsonWriteObject(w, file, configFileFields);
+    w.m_out += '\n';
 
-    GetChildrenString(j, versionOptionsText,   fileSettings.versionOptions);
-    GetChildrenString(j, switchOptionsText,    fileSettings.switchOptions);
-    GetChildrenString(j, preBuildEventsText,  fileSettings.preBuildEvents);
-    GetChildrenString(j, postBuildEventsText, fileSettings.postBuildEvents);
+    //the platforms are written with the indices from before the empty options are removed
+    RemoveNullStrings(settings.versionOptions);
+    RemoveNullStrings(settings.switchOptions);
+    settings.preBuildEvents.RemoveNullElements();
+    settings.postBuildEvents.RemoveNullElements();
+    std::erase_if(settings.fatalPatterns, [](const FatalLogPattern& p) { return p.text.empty(); });
+    return std::move(w.m_out);
+}
 
-    //assert(Valid(j, platformOptionsText));
+void SaveConfig(Settings& settings, const std::string& filename)
+{
+    std::string text = WriteConfigText(settings);
+    SettingsHistory::GetInstance().Saved(settings);
+    AsyncFileWriter::GetInstance().Write(filename, std::move(text));
+}
 
-    for (auto it = j[platformOptionsText].begin(); it != j[platformOptionsText].end(); it++)
-    {
-        auto& po = fileSettings.platformOptions;
-        po.push_back({ it.key() });
-        if (it.value().is_null())
-            continue;
+bool ParseConfigFile(const std::string& filename, Settings& out)
+{
+    out = {};
+    std::string text;
+    if (!AsyncFileWriter::GetInstance().GetPending(filename, text) && !ReadEntireFile(filename, text))
+        return false;
+    return ReadConfigText(text, out);
+}
 
-        LoadPlatformSettingsChildren(enabledVersionsText,   it.value(), po[po.size() - 1].enabledVersions,  fileSettings.versionOptions);
-        LoadPlatformSettingsChildren(enabledSwitchesText,   it.value(), po[po.size() - 1].enabledSwitches,  fileSettings.switchOptions);
-        LoadPlatformSettingsChildren(enabledPreBuildText,   it.value(), po[po.size() - 1].enabledPreBuild,  fileSettings.preBuildEvents);
-        LoadPlatformSettingsChildren(enabledPostBuildText,  it.value(), po[po.size() - 1].enabledPostBuild, fileSettings.postBuildEvents);
+void LoadConfig(Settings& settings, const AppSettings& appSettings)
+{
+    const std::string& filename = appSettings.fileNames[appSettings.currentFileNameIndex];
+    settings = {};
+    if (!ConfigCatalog::GetInstance().GetConfig(filename, settings))
+    {
+        settings = {};
+        LoadConfigDefaults(settings);
+        SettingsHistory::GetInstance().Loaded(filename, settings, false);
+        return;
     }
 
-    if (fileSettings.platformSelection >= fileSettings.platformOptions.size())
-        fileSettings.platformSelection = s32(fileSettings.platformOptions.size() - 1);
-
-    settings = fileSettings;
-
     ValidateLoadConfig(settings);
-
-     
-    
-    return;
+    SettingsHistory::GetInstance().Loaded(filename, settings, true);
 }
 
 void LoadConfigDefaults(Settings& settings)
@@ -393,140 +675,92 @@ void ClearConfig(Settings& settings)
     settings = {};
 }
 
-bool ArraysAreTheSame(const std::vector<s32>& a, const BuildEvents& abes, const std::vector<s32>& b, const BuildEvents& bbes)
+bool ConfigIsSameAsLastLoad(const Settings& s)
 {
-    if (a.size() != b.size())
-    {
-        return false;
-    }
-    else                                                        
-    {                                                           
-        BuildEvent abe;
-        BuildEvent bbe;
-        for (s32 i = 0; i < a.size(); i++)
-        {
-            abe.name.clear();
-            bbe.name.clear();
-            if (!abes.Get(abe, a[i]))
-                return false;
-            if (!bbes.Get(bbe, b[i]))
-                return false;
-            if (abe.name != bbe.name)
-                return false;
-        }
-    }
-    return true;
+    return SettingsHistory::GetInstance().IsSaved(s);
 }
-bool ArraysAreTheSame(const std::vector<s32>& a, const std::vector<std::string>& aStrings, const std::vector<s32>& b, const std::vector<std::string>& bStrings)
-{
-    if (a.size() != b.size())
+
+const JsonField<AppSettings> appSettingsFields[] = {
+    JsonMember<&AppSettings::artifactCache>(artifactCacheText),
+    JsonMember<&AppSettings::artifactCacheMaxGB>(artifactCacheMaxGBText),
+    JsonMember<&AppSettings::colorSelection>(colorSelectionText),
+    JsonMember<&AppSettings::configDirectory>(configDirectoryText),
     {
-        return false;
-    }
-    else                                                        
-    {                                                           
-        for (s32 i = 0; i < a.size(); i++)
+        //only the name is read, ScanDirectoryForConfigs finds it in the directory
+        currentFileText,
+        [](JsonReader& r, AppSettings& out)
         {
-            if (aStrings[a[i]] != bStrings[b[i]])
-                return false;
-        }
-    }
-    return true;
-}
-bool ArraysAreTheSame(const std::vector<std::string>& a, const std::vector<std::string>& b)
-{
-    if (a.size() != b.size())
-    {
-        return false;
-    }
-    else                                                        
-    {                                                           
-        for (s32 i = 0; i < a.size(); i++)
+            out.fileNames.resize(1);
+            JsonRead(r, out.fileNames[0]);
+            out.currentFileNameIndex = 0;
+        },
+        [](JsonWriter& w, const char* key, const AppSettings& in)
         {
-            if (a[i] != b[i])
-                return false;
-        }
-    }
-    return true;
-}
-bool ArraysAreTheSame(const BuildEvents& a, const BuildEvents& b)
-{
-    if (a.m_events.size() != b.m_events.size())
+            w.Key(key);
+            if (in.currentFileNameIndex >= 0 && in.currentFileNameIndex < in.fileNames.size())
+                w.String(in.fileNames[in.currentFileNameIndex]);
+            else
+                w.Null();
+        },
+    },
+    JsonMember<&AppSettings::fingerprintMode>(fingerprintModeText),
     {
-        return false;
-    }
-    else                                                        
-    {                                                           
-        for (s32 i = 0; i < a.m_events.size(); i++)
-        {
-            if (a.m_events[i].name != b.m_events[i].name)
-                return false;
-        }
-    }
-    return true;
-}
-
-bool ConfigIsSameAsLastLoad(const Settings& s)
-{
-#define ROOTCMP(__member)                       \
-if (s. ## __member != fileSettings. ## __member)\
-    return false
-
-#define CHILDCMP(__index, __member)                      \
-if (s.platformOptions[__index]. ## __member != fileSettings.platformOptions[__index]. ## __member)\
-    return false
-
-#define ARRAYS_ARE_DIFFERENT2(a, b) if (!ArraysAreTheSame(a, b))\
-    return false
-#define ARRAYSAREDIFFERENT4(a, b, c, d) if (!ArraysAreTheSame(a, b, c, d))\
-    return false
-
-    ROOTCMP(platformSelection);
-    ROOTCMP(rootPath);
-    ROOTCMP(projectPath);
-
-    ARRAYS_ARE_DIFFERENT2(s.versionOptions,  fileSettings.versionOptions);
-    ARRAYS_ARE_DIFFERENT2(s.switchOptions,   fileSettings.switchOptions);
-    ARRAYS_ARE_DIFFERENT2(s.preBuildEvents,  fileSettings.preBuildEvents );
-    ARRAYS_ARE_DIFFERENT2(s.postBuildEvents, fileSettings.postBuildEvents);
-
-    if (s.platformOptions.size() != fileSettings.platformOptions.size())
-        return false;
-    else
+        hostMaxBuildsText,
+        [](JsonReader& r, AppSettings& out) { JsonRead(r, out.hostBudget.maxConcurrentBuilds); },
+        [](JsonWriter& w, const char* key, const AppSettings& in) { w.Key(key); w.Int(in.hostBudget.maxConcurrentBuilds); },
+    },
     {
-        for (s32 i = 0; i < s.platformOptions.size(); i++)
-        {
-            CHILDCMP(i, name);
-            ARRAYSAREDIFFERENT4(s.platformOptions[i].enabledVersions,  s.versionOptions,   fileSettings.platformOptions[i].enabledVersions,    fileSettings.versionOptions );
-            ARRAYSAREDIFFERENT4(s.platformOptions[i].enabledSwitches,  s.switchOptions,    fileSettings.platformOptions[i].enabledSwitches,    fileSettings.switchOptions  );
-            ARRAYSAREDIFFERENT4(s.platformOptions[i].enabledPreBuild,  s.preBuildEvents,   fileSettings.platformOptions[i].enabledPreBuild,    fileSettings.preBuildEvents );
-            ARRAYSAREDIFFERENT4(s.platformOptions[i].enabledPostBuild, s.postBuildEvents,  fileSettings.platformOptions[i].enabledPostBuild,   fileSettings.postBuildEvents);
-        }
-    }
-
+        hostMemoryBudgetText,
+        [](JsonReader& r, AppSettings& out) { JsonRead(r, out.hostBudget.memoryBudgetMB); },
+        [](JsonWriter& w, const char* key, const AppSettings& in) { w.Key(key); w.Int(in.hostBudget.memoryBudgetMB); },
+    },
+    JsonMember<&AppSettings::majorRev>(majorRevText),
+    JsonMember<&AppSettings::minorRev>(minorRevText),
+    JsonMember<&AppSettings::prefetchContent>(prefetchContentText),
+    JsonMember<&AppSettings::sizeGrowthWarningPercent>(sizeGrowthWarningText),
+    JsonMember<&AppSettings::styleSelection>(styleSelectionText),
+    JsonMember<&AppSettings::transientFailureRetries>(transientRetriesText),
+    JsonMember<&AppSettings::UPS>(UPSText),
+    JsonMember<&AppSettings::uatWarmup>(uatWarmupText),
+};
 
+bool ReadAppSettingsText(std::string_view text, AppSettings& out)
+{
+    JsonReader r(text);
+    return JsonReadObject(r, out, appSettingsFields);
+}
 
-    return true;
+std::string WriteAppSettingsText(const AppSettings& settings)
+{
+    JsonWriter w;
+    JsonWriteObject(w, settings, appSettingsFields);
+    w.m_out += '\n';
+    return std::move(w.m_out);
 }
 
 void SaveAppSettings(AppSettings& settings)
 {
-    nlohmann::json j;
+    AsyncFileWriter::GetInstance().Write(appSettingsFileName, WriteAppSettingsText(settings));
+}
 
-    j[majorRevText]         = settings.majorRev;
-    j[minorRevText]         = settings.minorRev;
-    j[colorSelectionText]   = settings.colorSelection;
-    j[styleSelectionText]   = settings.styleSelection;
-    j[UPSText]              = settings.UPS;
-    if (settings.fileNames.size() && settings.currentFileNameIndex >= 0 && settings.currentFileNameIndex < settings.fileNames.size())
-        j[currentFileText] = settings.fileNames[settings.currentFileNameIndex];
-    else
-        j[currentFileText] = {};
-    j[configDirectoryText]  = settings.configDirectory;
+const u64 appSettingsSaveDelay = 500; //milliseconds
+bool s_appSettingsDirty = false;
+u64 s_appSettingsDirtyTicks = 0;
 
-    std::ofstream o(appSettingsFileName);
-    o << std::setw(4) << j << std::endl;
-    LoadAppSettings(settings);
+void MarkAppSettingsDirty()
+{
+    s_appSettingsDirty = true;
+    s_appSettingsDirtyTicks = SDL_GetTicks64();
+}
+
+void UpdateAppSettingsSave(AppSettings& settings, bool force)
+{
+    if (!s_appSettingsDirty)
+        return;
+    if (!force && SDL_GetTicks64() - s_appSettingsDirtyTicks < appSettingsSaveDelay)
+        return;
+    s_appSettingsDirty = false;
+    SaveAppSettings(settings);
 }
 
 void Convert(s32 fromMajor, s32 fromMinor, AppSettings& settings, s32 toMajor, s32 toMinor)
@@ -550,50 +784,25 @@ void Convert(s32 fromMajor, s32 fromMinor, AppSettings& settings, s32 toMajor, s
 void LoadAppSettings(AppSettings& settings)
 {
     appSettings = {};
-    std::ifstream file(appSettingsFileName);
-    if (file.fail())
+    std::string text;
+    AppSettings file = {};
+    //so missing revisions can be told apart from the defaults
+    file.majorRev = -1;
+    file.minorRev = -1;
+    if (!ReadEntireFile(appSettingsFileName, text) || !ReadAppSettingsText(text, file) || file.majorRev < 0 || file.minorRev < 0)
     {
         LoadDefaultAppSettings(settings);
         return;
     }
-    nlohmann::json j;
-    file >> j;
-
-    if (!Valid(j, majorRevText) || !Valid(j, minorRevText))
+    if (file.majorRev != appSettings.majorRev || file.minorRev != appSettings.minorRev)
     {
-        LoadDefaultAppSettings(settings);
-        return;
+        //TODO: is this ever necessary for app settings?
+        Convert(file.majorRev, file.minorRev, settings, appSettings.majorRev, appSettings.minorRev);
     }
-    else
-    {
-        s32 major = j[majorRevText].get<s32>();
-        s32 minor = j[minorRevText].get<s32>();
-        if (major != appSettings.majorRev || minor != appSettings.minorRev)
-        {
-            //TODO: is this ever necessary for app settings?
-            Convert(major, minor, settings, appSettings.majorRev, appSettings.minorRev);
-        }
-    }
-
-    GetTypeFromValid<s32>(  j, majorRevText,        appSettings.majorRev);
-    GetTypeFromValid<s32>(  j, minorRevText,        appSettings.minorRev);
-    GetTypeFromValid<s32>(  j, colorSelectionText,  appSettings.colorSelection);
-    GetTypeFromValid<s32>(  j, styleSelectionText,  appSettings.styleSelection);
-    GetTypeFromValid<float>(j, UPSText,             appSettings.UPS);
-    GetTypeFromValid<std::string>(j, configDirectoryText, appSettings.configDirectory);
 
+    appSettings = file;
+    appSettings.fingerprintMode = Clamp<s32>(appSettings.fingerprintMode, 0, FingerprintMode_Count - 1);
     ScanDirectoryForConfigs(appSettings);
-    appSettings.currentFileNameIndex = -1;
-    if (Valid(j, currentFileText))
-    {
-        for (s32 i = 0; i < appSettings.fileNames.size(); i++)
-        {
-            if (appSettings.fileNames[i] == j[currentFileText])
-            {
-                appSettings.currentFileNameIndex = i;
-            }
-        }
-    }
 
     settings = appSettings;
 
@@ -608,18 +817,296 @@ void LoadDefaultAppSettings(AppSettings& appSet)
 
 void ScanDirectoryForConfigs(AppSettings& settings)
 {
-    //TODO: Add ability to work with case insensitivity
-    std::vector<std::string> fileNames;
-    ScanDirectoryForFileNames(settings.configDirectory, fileNames);
-    for (s32 i = 0; i < fileNames.size(); i++)
+    std::string current;
+    if (settings.currentFileNameIndex >= 0 && settings.currentFileNameIndex < settings.fileNames.size())
+        current = settings.fileNames[settings.currentFileNameIndex];
+    ConfigCatalog::GetInstance().ListConfigs(settings.configDirectory, settings.fileNames);
+    auto it = std::find(settings.fileNames.begin(), settings.fileNames.end(), current);
+    settings.currentFileNameIndex = it == settings.fileNames.end() ? -1 : s32(it - settings.fileNames.begin());
+}
+
+//NOTE(CSH): the build queue, fingerprint, artifact and size files use field tables too, in the same sorted key order
+bool ValidQueuedEvent(BuildEvent& e)
+{
+    return !e.name.empty();
+}
+const JsonField<BuildEvent> queuedBuildEventFields[] = {
+    JsonMember<&BuildEvent::name>(nameText),
+    JsonMember<&BuildEvent::process>(processSettingsText),
+};
+
+//Build events are only written when the request has some
+template <auto Member>
+constexpr JsonField<BuildRequest> QueuedBuildEventsField(const char* name)
+{
+    return {
+        name,
+        [](JsonReader& r, BuildRequest& out) { JsonReadArray(r, out.*Member, queuedBuildEventFields, ValidQueuedEvent); },
+        [](JsonWriter& w, const char* key, const BuildRequest& in)
+        {
+            if ((in.*Member).empty())
+                return;
+            w.Key(key);
+            JsonWriteArray(w, in.*Member, queuedBuildEventFields);
+        },
+    };
+}
+
+const JsonField<BuildRequest> buildRequestFields[] = {
+    JsonMember<&BuildRequest::commandLine>(commandLineText),
+    JsonMember<&BuildRequest::configFile>(configFileText),
+    JsonMember<&BuildRequest::fatalPatterns>(fatalPatternsText),
+    JsonMember<&BuildRequest::platform>(platformText),
+    QueuedBuildEventsField<&BuildRequest::postBuildEvents>(postBuildEventsText),
+    QueuedBuildEventsField<&BuildRequest::preBuildEvents>(preBuildEventsText),
+    JsonMember<&BuildRequest::projectPath>(projectPathText),
+    JsonMember<&BuildRequest::rootPath>(rootPathText),
+    JsonMember<&BuildRequest::uatProcess>(uatProcessText),
+};
+
+struct BuildQueueFile {
+    std::vector<BuildRequest> requests;
+};
+const JsonField<BuildQueueFile> buildQueueFileFields[] = {
     {
-        std::string_view name = fileNames[i];
-        if (name.size() > 9 + 5)
+        buildQueueText,
+        [](JsonReader& r, BuildQueueFile& out)
         {
-            if (name.starts_with("UATHelper") && name.ends_with(".json"))
-            {
-                settings.fileNames.push_back(fileNames[i]);
-            }
-        }
+            JsonReadArray(r, out.requests, buildRequestFields, [](BuildRequest& request) { return !request.commandLine.empty(); });
+        },
+        [](JsonWriter& w, const char* key, const BuildQueueFile& in) { w.Key(key); JsonWriteArray(w, in.requests, buildRequestFields); },
+    },
+};
+
+bool ReadBuildQueueText(std::string_view text, std::vector<BuildRequest>& out)
+{
+    BuildQueueFile file;
+    JsonReader r(text);
+    if (!JsonReadObject(r, file, buildQueueFileFields))
+        return false;
+    out = std::move(file.requests);
+    return true;
+}
+
+std::string WriteBuildQueueText(const std::vector<BuildRequest>& requests)
+{
+    BuildQueueFile file = { requests };
+    JsonWriter w;
+    JsonWriteObject(w, file, buildQueueFileFields);
+    w.m_out += '\n';
+    return std::move(w.m_out);
+}
+
+void SaveBuildQueue(const std::vector<BuildRequest>& requests)
+{
+    AsyncFileWriter::GetInstance().Write(buildQueueFileName, WriteBuildQueueText(requests));
+}
+
+void LoadBuildQueue(std::vector<BuildRequest>& requests)
+{
+    requests.clear();
+    std::string text;
+    if (ReadEntireFile(buildQueueFileName, text))
+        ReadBuildQueueText(text, requests);
+}
+
+//Saved straight to disk like before, unlike the config these aren't queued on the AsyncFileWriter
+void WriteJsonFile(const std::string& filename, JsonWriter& w)
+{
+    w.m_out += '\n';
+    std::ofstream o(filename);
+    o << w.m_out;
+}
+
+const JsonField<ProjectFingerprint> fingerprintFields[] = {
+    JsonMember<&ProjectFingerprint::content>(contentText),
+    JsonMember<&ProjectFingerprint::source>(sourceText),
+};
+
+void SaveFingerprints(const std::map<std::string, ProjectFingerprint>& fingerprints)
+{
+    JsonWriter w;
+    w.BeginObject();
+    for (const auto& [key, fingerprint] : fingerprints)
+    {
+        w.Key(key);
+        JsonWriteObject(w, fingerprint, fingerprintFields);
     }
+    w.EndObject();
+    WriteJsonFile(fingerprintsFileName, w);
+}
+
+void LoadFingerprints(std::map<std::string, ProjectFingerprint>& fingerprints)
+{
+    fingerprints.clear();
+    std::string text;
+    if (!ReadEntireFile(fingerprintsFileName, text))
+        return;
+    JsonReader r(text);
+    std::string_view key;
+    if (!r.BeginObject())
+        return;
+    while (r.NextKey(key))
+    {
+        ProjectFingerprint& fingerprint = fingerprints[std::string(key)];
+        if (!r.ReadNull())
+            JsonReadObject(r, fingerprint, fingerprintFields);
+    }
+    //a half read file would drop fingerprints on the next save, start over instead
+    if (r.Failed())
+        fingerprints.clear();
+}
+
+const JsonField<ArtifactFile> artifactFileFields[] = {
+    JsonMember<&ArtifactFile::hash>(hashText),
+    JsonMember<&ArtifactFile::path>(pathText),
+    JsonMember<&ArtifactFile::size>(sizeText),
+};
+void JsonRead(JsonReader& r, std::vector<ArtifactFile>& out)
+{
+    JsonReadArray(r, out, artifactFileFields, [](ArtifactFile& file) { return !file.path.empty(); });
+}
+void JsonWrite(JsonWriter& w, const std::vector<ArtifactFile>& in)
+{
+    JsonWriteArray(w, in, artifactFileFields);
+}
+
+const JsonField<ArtifactManifest> artifactManifestFields[] = {
+    JsonMember<&ArtifactManifest::files>(filesText),
+    JsonMember<&ArtifactManifest::key>(keyText),
+    JsonMember<&ArtifactManifest::lastUsed>(lastUsedText),
+};
+
+struct ArtifactIndexFile {
+    std::vector<ArtifactManifest> manifests;
+};
+const JsonField<ArtifactIndexFile> artifactIndexFileFields[] = {
+    {
+        manifestsText,
+        [](JsonReader& r, ArtifactIndexFile& out)
+        {
+            JsonReadArray(r, out.manifests, artifactManifestFields, [](ArtifactManifest& manifest) { return manifest.key && manifest.files.size(); });
+        },
+        [](JsonWriter& w, const char* key, const ArtifactIndexFile& in) { w.Key(key); JsonWriteArray(w, in.manifests, artifactManifestFields); },
+    },
+};
+
+void SaveArtifactIndex(const std::string& filename, const std::vector<ArtifactManifest>& manifests)
+{
+    ArtifactIndexFile file = { manifests };
+    JsonWriter w;
+    JsonWriteObject(w, file, artifactIndexFileFields);
+    WriteJsonFile(filename, w);
+}
+
+void LoadArtifactIndex(const std::string& filename, std::vector<ArtifactManifest>& manifests)
+{
+    manifests.clear();
+    std::string text;
+    if (!ReadEntireFile(filename, text))
+        return;
+    ArtifactIndexFile file;
+    JsonReader r(text);
+    if (JsonReadObject(r, file, artifactIndexFileFields))
+        manifests = std::move(file.manifests);
+}
+
+const JsonField<CopiedFile> copiedFileFields[] = {
+    JsonMember<&CopiedFile::hash>(hashText),
+    JsonMember<&CopiedFile::lastWriteTime>(lastWriteTimeText),
+    JsonMember<&CopiedFile::path>(pathText),
+    JsonMember<&CopiedFile::size>(sizeText),
+};
+
+struct CopyManifestFile {
+    std::vector<CopiedFile> files;
+    bool read = false; //the manifest only counts if it had a file list
+};
+const JsonField<CopyManifestFile> copyManifestFileFields[] = {
+    {
+        filesText,
+        [](JsonReader& r, CopyManifestFile& out)
+        {
+            JsonReadArray(r, out.files, copiedFileFields, [](CopiedFile& file) { return !file.path.empty(); });
+            out.read = true;
+        },
+        [](JsonWriter& w, const char* key, const CopyManifestFile& in) { w.Key(key); JsonWriteArray(w, in.files, copiedFileFields); },
+    },
+};
+
+void SaveCopyManifest(const std::string& filename, const std::vector<CopiedFile>& files)
+{
+    CopyManifestFile file = { files };
+    JsonWriter w;
+    JsonWriteObject(w, file, copyManifestFileFields);
+    WriteJsonFile(filename, w);
+}
+
+bool LoadCopyManifest(const std::string& filename, std::vector<CopiedFile>& files)
+{
+    files.clear();
+    std::string text;
+    if (!ReadEntireFile(filename, text))
+        return false;
+    CopyManifestFile file;
+    JsonReader r(text);
+    if (!JsonReadObject(r, file, copyManifestFileFields) || !file.read)
+        return false;
+    files = std::move(file.files);
+    return true;
+}
+
+const JsonField<SizeEntry> sizeEntryFields[] = {
+    JsonMember<&SizeEntry::bytes>(bytesText),
+    JsonMember<&SizeEntry::name>(nameText),
+};
+void JsonRead(JsonReader& r, std::vector<SizeEntry>& out)
+{
+    JsonReadArray(r, out, sizeEntryFields, [](SizeEntry&) { return true; });
+}
+void JsonWrite(JsonWriter& w, const std::vector<SizeEntry>& in)
+{
+    JsonWriteArray(w, in, sizeEntryFields);
+}
+
+const JsonField<SizeReport> sizeReportFields[] = {
+    JsonMember<&SizeReport::directories>(directoriesText),
+    JsonMember<&SizeReport::extensions>(extensionsText),
+    JsonMember<&SizeReport::key>(keyText),
+    JsonMember<&SizeReport::time>(timeText),
+    JsonMember<&SizeReport::totalBytes>(totalBytesText),
+};
+
+struct SizeHistoryFile {
+    std::vector<SizeReport> reports;
+};
+const JsonField<SizeHistoryFile> sizeHistoryFileFields[] = {
+    {
+        reportsText,
+        [](JsonReader& r, SizeHistoryFile& out)
+        {
+            JsonReadArray(r, out.reports, sizeReportFields, [](SizeReport& report) { return !report.key.empty(); });
+        },
+        [](JsonWriter& w, const char* key, const SizeHistoryFile& in) { w.Key(key); JsonWriteArray(w, in.reports, sizeReportFields); },
+    },
+};
+
+void SaveSizeHistory(const std::vector<SizeReport>& reports)
+{
+    SizeHistoryFile file = { reports };
+    JsonWriter w;
+    JsonWriteObject(w, file, sizeHistoryFileFields);
+    WriteJsonFile(sizeHistoryFileName, w);
+}
+
+void LoadSizeHistory(std::vector<SizeReport>& reports)
+{
+    reports.clear();
+    std::string text;
+    if (!ReadEntireFile(sizeHistoryFileName, text))
+        return;
+    SizeHistoryFile file;
+    JsonReader r(text);
+    if (JsonReadObject(r, file, sizeHistoryFileFields))
+        reports = std::move(file.reports);
 }
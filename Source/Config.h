@@ -1,21 +1,108 @@
 #pragma once
 #include "Math.h"
 #include "Themes.h"
+#include "HostSlots.h"
+#include <map>
 #include <vector>
 #include <string>
+#include <string_view>
 
 
+enum ProcessPriority : s32 {
+    ProcessPriority_Idle,
+    ProcessPriority_BelowNormal,
+    ProcessPriority_Normal,
+    ProcessPriority_AboveNormal,
+    ProcessPriority_High,
+    ProcessPriority_Count,
+};
+
+//NOTE(CSH): the job object limits apply to the whole process tree (cmd -> UAT -> UBT/cooker),
+//priority and affinity are also applied to the first process when no job object is used
+struct ProcessSettings {
+    s32 priority = ProcessPriority_Normal;
+    u64 affinityMask = 0; //0 = all cores
+    bool useJobObject = false;
+    s32 cpuRatePercent = 0; //0 = no limit
+    s32 memoryLimitMB = 0; //0 = no limit
+
+    bool operator==(const ProcessSettings& rhs) const = default;
+};
+
+//UAT is stopped as soon as count of its log lines contained the text
+struct FatalLogPattern {
+    std::string text;
+    s32 count = 1;
+
+    bool operator==(const FatalLogPattern& rhs) const = default;
+};
+
+enum FingerprintMode : s32 {
+    FingerprintMode_Off,
+    FingerprintMode_Ask,
+    FingerprintMode_Automatic,
+    FingerprintMode_Count,
+};
+
+//Hashes of the inputs of the build and cook phases of a project
+struct ProjectFingerprint {
+    u64 source = 0; //Source, Plugins and the .uproject
+    u64 content = 0; //Content, Config and plugin content
+
+    bool operator==(const ProjectFingerprint& rhs) const = default;
+};
+
+struct ArtifactFile {
+    std::string path; //relative to the output directory
+    u64 hash = 0;
+    u64 size = 0;
+};
+
+//Output of one successful build in the artifact cache
+struct ArtifactManifest {
+    u64 key = 0;
+    u64 lastUsed = 0; //FILETIME
+    std::vector<ArtifactFile> files;
+};
+
+//A file the @copy build event copied, compared against the source on the next copy
+struct CopiedFile {
+    std::string path; //relative to the destination
+    u64 size = 0;
+    u64 lastWriteTime = 0; //FILETIME of the source
+    u64 hash = 0; //0 if the copy didn't hash
+};
+
+struct SizeEntry {
+    std::string name;
+    u64 bytes = 0;
+};
+
+//Size of the staged output of one successful build
+struct SizeReport {
+    std::string key; //FingerprintKey, platform and config of the build
+    u64 time = 0; //FILETIME
+    u64 totalBytes = 0;
+    std::vector<SizeEntry> directories; //relative to the staging directory, largest first
+    std::vector<SizeEntry> extensions; //largest first
+};
+
 struct PlatformSettings {
     std::string name;
     std::vector<s32> enabledVersions;
     std::vector<s32> enabledSwitches;
     std::vector<s32> enabledPreBuild;
     std::vector<s32> enabledPostBuild;
+
+    bool operator==(const PlatformSettings& rhs) const = default;
 };
 
 struct BuildEvent {
     s32 id = {};
     std::string name;
+    ProcessSettings process;
+
+    bool operator==(const BuildEvent& rhs) const = default;
 };
 
 struct BuildEvents {
@@ -26,6 +113,8 @@ struct BuildEvents {
     bool Get(BuildEvent& out, const s32 id) const;
     bool Get(BuildEvent& out, const std::string& s) const;
     BuildEvent* Add(const std::string& name);
+
+    bool operator==(const BuildEvents& rhs) const = default;
 };
 
 struct Settings {
@@ -38,6 +127,22 @@ struct Settings {
     BuildEvents preBuildEvents;
     BuildEvents postBuildEvents;
     std::vector<PlatformSettings> platformOptions;
+    ProcessSettings uatProcess;
+    std::vector<FatalLogPattern> fatalPatterns;
+};
+
+//Everything needed to run a build without the config it came from
+struct BuildRequest {
+    std::string configFile;
+    std::string platform;
+    std::string rootPath;
+    std::string projectPath;
+    std::string commandLine;
+    ProcessSettings uatProcess;
+    std::vector<BuildEvent> preBuildEvents;
+    std::vector<BuildEvent> postBuildEvents;
+    std::vector<FatalLogPattern> fatalPatterns;
+    s32 retryCount = 0; //automatic retries already used by this request
 };
 
 struct AppSettings {
@@ -49,16 +154,51 @@ struct AppSettings {
     s32 currentFileNameIndex = -1;
     std::vector<std::string> fileNames;
     std::string configDirectory;
+    HostBudget hostBudget;
+    s32 transientFailureRetries = 0;
+    s32 fingerprintMode = FingerprintMode_Off;
+    bool artifactCache = false;
+    s32 artifactCacheMaxGB = 50;
+    bool prefetchContent = false;
+    s32 sizeGrowthWarningPercent = 5; //0 = never warn
+    bool uatWarmup = false;
 };
 
 void SortConfig(Settings& settings);
 void SaveConfig(Settings& settings, const std::string& filename);
 void LoadConfig(Settings& settings, const AppSettings& appSettings);
+//returns false if the file can't be read or is from another version
+bool ParseConfigFile(const std::string& filename, Settings& out);
+//Streaming reader/writer behind the two above, the writer removes empty entries from settings like SaveConfig
+bool ReadConfigText(std::string_view text, Settings& out);
+std::string WriteConfigText(Settings& settings);
 void LoadConfigDefaults(Settings& settings);
 void ClearConfig(Settings& settings);
 bool ConfigIsSameAsLastLoad(const Settings& settings);
 
 void SaveAppSettings(AppSettings& settings);
+//NOTE(CSH): changes from the UI only mark the app settings dirty, they are saved once nothing
+//changed for a moment so dragging a value or typing doesn't save on every frame
+void MarkAppSettingsDirty();
+//Call once per frame, force saves right away (on exit)
+void UpdateAppSettingsSave(AppSettings& settings, bool force = false);
 void LoadAppSettings(AppSettings& settings);
+bool ReadAppSettingsText(std::string_view text, AppSettings& out);
+std::string WriteAppSettingsText(const AppSettings& settings);
 void LoadDefaultAppSettings(AppSettings& appSet);
 void ScanDirectoryForConfigs(AppSettings& settings);
+
+void SaveBuildQueue(const std::vector<BuildRequest>& requests);
+void LoadBuildQueue(std::vector<BuildRequest>& requests);
+bool ReadBuildQueueText(std::string_view text, std::vector<BuildRequest>& out);
+std::string WriteBuildQueueText(const std::vector<BuildRequest>& requests);
+//Fingerprints of the last successful build keyed by project, platform and client config
+void SaveFingerprints(const std::map<std::string, ProjectFingerprint>& fingerprints);
+void LoadFingerprints(std::map<std::string, ProjectFingerprint>& fingerprints);
+void SaveArtifactIndex(const std::string& filename, const std::vector<ArtifactManifest>& manifests);
+void LoadArtifactIndex(const std::string& filename, std::vector<ArtifactManifest>& manifests);
+void SaveCopyManifest(const std::string& filename, const std::vector<CopiedFile>& files);
+//returns false if there is no manifest
+bool LoadCopyManifest(const std::string& filename, std::vector<CopiedFile>& files);
+void SaveSizeHistory(const std::vector<SizeReport>& reports);
+void LoadSizeHistory(std::vector<SizeReport>& reports);
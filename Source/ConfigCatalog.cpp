@@ -0,0 +1,94 @@
+#include "ConfigCatalog.h"
+#include "FileSystem.h"
+#include "AsyncFileWriter.h"
+#include "ConfigSnapshot.h"
+#include "Windows.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+const s32 parsedConfigCount = 16;
+
+bool IsConfigFileName(std::string_view name)
+{
+    //TODO: Add ability to work with case insensitivity
+    return name.size() > 9 + 5 && name.starts_with("UATHelper") && name.ends_with(".json");
+}
+
+void ConfigCatalog::ListConfigs(const std::string& directory, std::vector<std::string>& out)
+{
+    //without a watch there is no way to know if the directory changed
+    bool rescan = !m_scanned || directory != m_directory || !m_watch;
+    if (!rescan)
+    {
+        rescan = WaitForSingleObject(m_watch, 0) == WAIT_OBJECT_0;
+        if (rescan)
+            FindNextChangeNotification(m_watch);
+    }
+    if (directory != m_directory || !m_scanned)
+    {
+        if (m_watch)
+            FindCloseChangeNotification(m_watch);
+        std::string watchDirectory = directory.size() < 2 ? "." : directory;
+        m_watch = FindFirstChangeNotificationA(watchDirectory.c_str(), FALSE, FILE_NOTIFY_CHANGE_FILE_NAME);
+        if (m_watch == INVALID_HANDLE_VALUE)
+            m_watch = nullptr;
+        m_directory = directory;
+    }
+
+    if (rescan)
+    {
+        std::vector<std::string> fileNames;
+        ScanDirectoryForFileNames(directory, fileNames);
+        m_fileNames.clear();
+        for (const std::string& name : fileNames)
+        {
+            if (IsConfigFileName(name))
+                m_fileNames.push_back(name);
+        }
+        m_scanned = true;
+    }
+    out = m_fileNames;
+}
+
+bool ConfigCatalog::GetConfig(const std::string& filename, Settings& out)
+{
+    //the file on disk is out of date until the writer gets to it
+    std::string pending;
+    if (AsyncFileWriter::GetInstance().GetPending(filename, pending))
+        return ParseConfigFile(filename, out);
+
+    FileEntry entry;
+    if (!GetFileEntry(filename, entry))
+        return false;
+
+    auto it = m_parsed.find(filename);
+    if (it != m_parsed.end())
+    {
+        Parsed& parsed = it->second;
+        if (parsed.lastWriteTime == entry.lastWriteTime && parsed.size == entry.size)
+        {
+            m_lru.splice(m_lru.begin(), m_lru, parsed.lru);
+            out = parsed.settings;
+            return true;
+        }
+        m_lru.erase(parsed.lru);
+        m_parsed.erase(it);
+    }
+
+    if (!LoadConfigWithSnapshot(filename, entry, out))
+        return false;
+
+    m_lru.push_front(filename);
+    Parsed& parsed = m_parsed[filename];
+    parsed.lastWriteTime = entry.lastWriteTime;
+    parsed.size = entry.size;
+    parsed.settings = out;
+    parsed.lru = m_lru.begin();
+    if (m_lru.size() > parsedConfigCount)
+    {
+        m_parsed.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+    return true;
+}
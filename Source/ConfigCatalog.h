@@ -0,0 +1,36 @@
+#pragma once
+#include "Math.h"
+#include "Config.h"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//NOTE(CSH): keeps the list of UATHelper*.json configs and the last few parsed configs in memory.
+//The config directory is only scanned again once its change notification fires and a parsed
+//config is reused until its write time or size changes, configs that aren't in memory are read from
+//their snapshot when it is still valid. Only used from the main thread
+struct ConfigCatalog {
+    struct Parsed {
+        u64 lastWriteTime = 0;
+        u64 size = 0;
+        Settings settings;
+        std::list<std::string>::iterator lru;
+    };
+    std::string m_directory;
+    std::vector<std::string> m_fileNames;
+    void* m_watch = nullptr;
+    bool m_scanned = false;
+    std::unordered_map<std::string, Parsed> m_parsed;
+    std::list<std::string> m_lru; //most recently used first
+
+    static ConfigCatalog& GetInstance()
+    {
+        static ConfigCatalog instance;
+        return instance;
+    }
+    void ListConfigs(const std::string& directory, std::vector<std::string>& out);
+    //returns false if the file doesn't exist or isn't a config of the current version
+    bool GetConfig(const std::string& filename, Settings& out);
+};
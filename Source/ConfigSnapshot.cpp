@@ -0,0 +1,380 @@
+#include "ConfigSnapshot.h"
+#include "FileSystem.h"
+#include "AsyncFileWriter.h"
+#include "Hash.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <cstring>
+#include <unordered_map>
+
+const u32 snapshotMagic = 0x53544155; //"UATS"
+const u32 snapshotVersion = 1; //bump when any of the structs below change
+
+struct SnapshotString {
+    u32 offset;
+    u32 size;
+};
+
+struct SnapshotArray {
+    u32 offset;
+    u32 count;
+};
+
+struct SnapshotProcess {
+    u64 affinityMask;
+    s32 priority;
+    s32 cpuRatePercent;
+    s32 memoryLimitMB;
+    u32 useJobObject;
+};
+
+struct SnapshotEvent {
+    SnapshotString name;
+    SnapshotProcess process;
+};
+
+//enabled build events are indices into the event arrays, the ids are handed out again on load
+struct SnapshotPlatform {
+    SnapshotString name;
+    SnapshotArray enabledVersions;
+    SnapshotArray enabledSwitches;
+    SnapshotArray enabledPreBuild;
+    SnapshotArray enabledPostBuild;
+};
+
+struct SnapshotPattern {
+    SnapshotString text;
+    s32 count;
+};
+
+struct SnapshotHeader {
+    u32 magic;
+    u32 version;
+    u64 fileSize;
+    u64 jsonSize;
+    u64 jsonWriteTime;
+    u64 jsonHash;
+    s32 settingsVersion;
+    s32 platformSelection;
+    SnapshotString rootPath;
+    SnapshotString projectPath;
+    SnapshotArray versionOptions; //SnapshotString
+    SnapshotArray switchOptions; //SnapshotString
+    SnapshotArray preBuildEvents; //SnapshotEvent
+    SnapshotArray postBuildEvents; //SnapshotEvent
+    SnapshotArray platforms; //SnapshotPlatform
+    SnapshotArray fatalPatterns; //SnapshotPattern
+    SnapshotProcess uatProcess;
+};
+
+std::string ConfigSnapshotFileName(const std::string& configFile)
+{
+    return configFile + ".snapshot";
+}
+
+//Everything is written by offset since the buffer moves while it grows
+struct SnapshotWriter {
+    std::string m_data;
+
+    template <typename T>
+    u32 Reserve(u64 count)
+    {
+        m_data.resize((m_data.size() + alignof(T) - 1) & ~(alignof(T) - 1));
+        u32 offset = u32(m_data.size());
+        m_data.resize(m_data.size() + count * sizeof(T));
+        return offset;
+    }
+    template <typename T>
+    void Set(u32 offset, u64 index, const T& value)
+    {
+        memcpy(&m_data[offset + index * sizeof(T)], &value, sizeof(T));
+    }
+    template <typename T>
+    SnapshotArray Array(const std::vector<T>& values)
+    {
+        SnapshotArray a = { Reserve<T>(values.size()), u32(values.size()) };
+        if (values.size())
+            memcpy(&m_data[a.offset], values.data(), values.size() * sizeof(T));
+        return a;
+    }
+    SnapshotString String(const std::string& s)
+    {
+        SnapshotString result = { u32(m_data.size()), u32(s.size()) };
+        m_data += s;
+        return result;
+    }
+    SnapshotArray Strings(const std::vector<std::string>& strings)
+    {
+        SnapshotArray a = { Reserve<SnapshotString>(strings.size()), u32(strings.size()) };
+        for (u64 i = 0; i < strings.size(); i++)
+            Set(a.offset, i, String(strings[i]));
+        return a;
+    }
+    SnapshotArray Events(const BuildEvents& be)
+    {
+        SnapshotArray a = { Reserve<SnapshotEvent>(be.m_events.size()), u32(be.m_events.size()) };
+        for (u64 i = 0; i < be.m_events.size(); i++)
+        {
+            const BuildEvent& e = be.m_events[i];
+            SnapshotEvent se = {};
+            se.name = String(e.name);
+            se.process = Process(e.process);
+            Set(a.offset, i, se);
+        }
+        return a;
+    }
+    static SnapshotProcess Process(const ProcessSettings& p)
+    {
+        SnapshotProcess result = {};
+        result.affinityMask = p.affinityMask;
+        result.priority = p.priority;
+        result.cpuRatePercent = p.cpuRatePercent;
+        result.memoryLimitMB = p.memoryLimitMB;
+        result.useJobObject = p.useJobObject;
+        return result;
+    }
+};
+
+std::vector<s32> EventIndices(const std::vector<s32>& ids, const std::unordered_map<s32, s32>& indices)
+{
+    std::vector<s32> result;
+    result.reserve(ids.size());
+    for (s32 id : ids)
+    {
+        auto it = indices.find(id);
+        if (it != indices.end())
+            result.push_back(it->second);
+    }
+    return result;
+}
+
+std::string EncodeConfigSnapshot(const FileEntry& json, u64 jsonHash, const Settings& settings)
+{
+    SnapshotWriter w;
+    w.m_data.reserve(64 * 1024);
+    u32 headerOffset = w.Reserve<SnapshotHeader>(1);
+    SnapshotHeader header = {};
+    header.magic = snapshotMagic;
+    header.version = snapshotVersion;
+    header.jsonSize = json.size;
+    header.jsonWriteTime = json.lastWriteTime;
+    header.jsonHash = jsonHash;
+    header.settingsVersion = settings.version;
+    header.platformSelection = settings.platformSelection;
+    header.rootPath = w.String(settings.rootPath);
+    header.projectPath = w.String(settings.projectPath);
+    header.versionOptions = w.Strings(settings.versionOptions);
+    header.switchOptions = w.Strings(settings.switchOptions);
+    header.preBuildEvents = w.Events(settings.preBuildEvents);
+    header.postBuildEvents = w.Events(settings.postBuildEvents);
+    header.uatProcess = SnapshotWriter::Process(settings.uatProcess);
+
+    std::unordered_map<s32, s32> preBuild;
+    std::unordered_map<s32, s32> postBuild;
+    for (s32 i = 0; i < settings.preBuildEvents.m_events.size(); i++)
+        preBuild.emplace(settings.preBuildEvents.m_events[i].id, i);
+    for (s32 i = 0; i < settings.postBuildEvents.m_events.size(); i++)
+        postBuild.emplace(settings.postBuildEvents.m_events[i].id, i);
+
+    header.platforms = { w.Reserve<SnapshotPlatform>(settings.platformOptions.size()), u32(settings.platformOptions.size()) };
+    for (u64 i = 0; i < settings.platformOptions.size(); i++)
+    {
+        const PlatformSettings& p = settings.platformOptions[i];
+        SnapshotPlatform sp = {};
+        sp.name = w.String(p.name);
+        sp.enabledVersions = w.Array(p.enabledVersions);
+        sp.enabledSwitches = w.Array(p.enabledSwitches);
+        sp.enabledPreBuild = w.Array(EventIndices(p.enabledPreBuild, preBuild));
+        sp.enabledPostBuild = w.Array(EventIndices(p.enabledPostBuild, postBuild));
+        w.Set(header.platforms.offset, i, sp);
+    }
+
+    header.fatalPatterns = { w.Reserve<SnapshotPattern>(settings.fatalPatterns.size()), u32(settings.fatalPatterns.size()) };
+    for (u64 i = 0; i < settings.fatalPatterns.size(); i++)
+    {
+        SnapshotPattern sp = {};
+        sp.text = w.String(settings.fatalPatterns[i].text);
+        sp.count = settings.fatalPatterns[i].count;
+        w.Set(header.fatalPatterns.offset, i, sp);
+    }
+
+    header.fileSize = w.m_data.size();
+    w.Set(headerOffset, 0, header);
+    return std::move(w.m_data);
+}
+
+//Every offset is checked against the size so a damaged snapshot fails instead of reading outside the mapping
+struct SnapshotReader {
+    const u8* m_data;
+    u64 m_size;
+    bool m_failed = false;
+
+    template <typename T>
+    const T* Array(SnapshotArray a)
+    {
+        if (a.offset % alignof(T) || u64(a.offset) + u64(a.count) * sizeof(T) > m_size)
+        {
+            m_failed = true;
+            return nullptr;
+        }
+        return (const T*)(m_data + a.offset);
+    }
+    void String(SnapshotString s, std::string& out)
+    {
+        if (u64(s.offset) + s.size > m_size)
+        {
+            m_failed = true;
+            return;
+        }
+        out.assign((const char*)m_data + s.offset, s.size);
+    }
+    void Strings(SnapshotArray a, std::vector<std::string>& out)
+    {
+        const SnapshotString* strings = Array<SnapshotString>(a);
+        if (!strings)
+            return;
+        out.resize(a.count);
+        for (u32 i = 0; i < a.count; i++)
+            String(strings[i], out[i]);
+    }
+    void Events(SnapshotArray a, BuildEvents& out)
+    {
+        const SnapshotEvent* events = Array<SnapshotEvent>(a);
+        if (!events)
+            return;
+        out.m_events.reserve(a.count);
+        std::string name;
+        for (u32 i = 0; i < a.count; i++)
+        {
+            String(events[i].name, name);
+            BuildEvent* be = out.Add(name);
+            Process(events[i].process, be->process);
+        }
+    }
+    static void Process(const SnapshotProcess& p, ProcessSettings& out)
+    {
+        out.affinityMask = p.affinityMask;
+        out.priority = p.priority;
+        out.cpuRatePercent = p.cpuRatePercent;
+        out.memoryLimitMB = p.memoryLimitMB;
+        out.useJobObject = p.useJobObject != 0;
+    }
+    //indices must be below count, events are turned back into ids
+    void Enabled(SnapshotArray a, s32 count, std::vector<s32>& out, const BuildEvents* be = nullptr)
+    {
+        const s32* values = Array<s32>(a);
+        if (!values)
+            return;
+        out.reserve(a.count);
+        for (u32 i = 0; i < a.count; i++)
+        {
+            if (values[i] < 0 || values[i] >= count)
+            {
+                m_failed = true;
+                return;
+            }
+            out.push_back(be ? be->m_events[values[i]].id : values[i]);
+        }
+    }
+};
+
+bool DecodeConfigSnapshot(const u8* data, u64 size, const FileEntry& json, u64 jsonHash, Settings& out)
+{
+    out = {};
+    if (size < sizeof(SnapshotHeader))
+        return false;
+    SnapshotHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != snapshotMagic || header.version != snapshotVersion || header.fileSize != size)
+        return false;
+    if (header.jsonSize != json.size || header.jsonWriteTime != json.lastWriteTime || header.jsonHash != jsonHash)
+        return false;
+    if (header.settingsVersion != out.version)
+        return false;
+
+    SnapshotReader r = { data, size };
+    out.platformSelection = header.platformSelection;
+    r.String(header.rootPath, out.rootPath);
+    r.String(header.projectPath, out.projectPath);
+    r.Strings(header.versionOptions, out.versionOptions);
+    r.Strings(header.switchOptions, out.switchOptions);
+    r.Events(header.preBuildEvents, out.preBuildEvents);
+    r.Events(header.postBuildEvents, out.postBuildEvents);
+    SnapshotReader::Process(header.uatProcess, out.uatProcess);
+
+    if (const SnapshotPlatform* platforms = r.Array<SnapshotPlatform>(header.platforms))
+    {
+        out.platformOptions.resize(header.platforms.count);
+        for (u32 i = 0; i < header.platforms.count && !r.m_failed; i++)
+        {
+            PlatformSettings& p = out.platformOptions[i];
+            r.String(platforms[i].name, p.name);
+            r.Enabled(platforms[i].enabledVersions,  s32(out.versionOptions.size()),                p.enabledVersions);
+            r.Enabled(platforms[i].enabledSwitches,  s32(out.switchOptions.size()),                 p.enabledSwitches);
+            r.Enabled(platforms[i].enabledPreBuild,  s32(out.preBuildEvents.m_events.size()),       p.enabledPreBuild,  &out.preBuildEvents);
+            r.Enabled(platforms[i].enabledPostBuild, s32(out.postBuildEvents.m_events.size()),      p.enabledPostBuild, &out.postBuildEvents);
+        }
+    }
+    if (const SnapshotPattern* patterns = r.Array<SnapshotPattern>(header.fatalPatterns))
+    {
+        out.fatalPatterns.resize(header.fatalPatterns.count);
+        for (u32 i = 0; i < header.fatalPatterns.count; i++)
+        {
+            r.String(patterns[i].text, out.fatalPatterns[i].text);
+            out.fatalPatterns[i].count = patterns[i].count;
+        }
+    }
+
+    if (r.m_failed)
+    {
+        out = {};
+        return false;
+    }
+    return true;
+}
+
+bool LoadConfigSnapshot(const std::string& configFile, const FileEntry& json, u64 jsonHash, Settings& out)
+{
+    std::string snapshotFile = ConfigSnapshotFileName(configFile);
+    HANDLE file = CreateFileA(snapshotFile.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    DEFER { CloseHandle(file); };
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || u64(size.QuadPart) < sizeof(SnapshotHeader))
+        return false;
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping)
+        return false;
+    DEFER { CloseHandle(mapping); };
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+        return false;
+    DEFER { UnmapViewOfFile(view); };
+
+    return DecodeConfigSnapshot((const u8*)view, u64(size.QuadPart), json, jsonHash, out);
+}
+
+void SaveConfigSnapshot(const std::string& configFile, const FileEntry& json, u64 jsonHash, const Settings& settings)
+{
+    AsyncFileWriter::GetInstance().Write(ConfigSnapshotFileName(configFile), EncodeConfigSnapshot(json, jsonHash, settings));
+}
+
+bool LoadConfigWithSnapshot(const std::string& configFile, const FileEntry& json, Settings& out)
+{
+    //the json is read once for the hash and only parsed when the snapshot is stale
+    std::string text;
+    if (!ReadEntireFile(configFile, text))
+        return false;
+    u64 hash = Hash64(text.data(), text.size());
+    if (LoadConfigSnapshot(configFile, json, hash, out))
+        return true;
+    if (!ReadConfigText(text, out))
+        return false;
+    SaveConfigSnapshot(configFile, json, hash, out);
+    return true;
+}
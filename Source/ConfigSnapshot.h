@@ -0,0 +1,21 @@
+#pragma once
+#include "Math.h"
+#include "Config.h"
+
+#include <string>
+
+struct FileEntry;
+
+//NOTE(CSH): a parsed config is also stored as a flat binary file next to the json (<config>.snapshot).
+//Strings and arrays are offsets into the file so it is read straight from a mapping without parsing.
+//The snapshot is only used while the size, write time and hash of the json are the ones it was made from
+std::string ConfigSnapshotFileName(const std::string& configFile);
+//returns false if there is no snapshot or it doesn't match json
+bool LoadConfigSnapshot(const std::string& configFile, const FileEntry& json, u64 jsonHash, Settings& out);
+void SaveConfigSnapshot(const std::string& configFile, const FileEntry& json, u64 jsonHash, const Settings& settings);
+//Reads configFile from its snapshot, falls back to the json when the snapshot is stale and writes a new one
+bool LoadConfigWithSnapshot(const std::string& configFile, const FileEntry& json, Settings& out);
+
+//The snapshot encoding without the files, for the benchmark
+std::string EncodeConfigSnapshot(const FileEntry& json, u64 jsonHash, const Settings& settings);
+bool DecodeConfigSnapshot(const u8* data, u64 size, const FileEntry& json, u64 jsonHash, Settings& out);
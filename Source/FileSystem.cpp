@@ -0,0 +1,283 @@
+#include "FileSystem.h"
+#include "Hash.h"
+#include "Threading.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <cstring>
+#include <mutex>
+
+std::string WideToUTF8(const wchar_t* s, s32 length)
+{
+    std::string result;
+    if (length <= 0)
+        return result;
+    s32 size = WideCharToMultiByte(CP_UTF8, 0, s, length, nullptr, 0, NULL, NULL);
+    if (size <= 0)
+        return result;
+    result.resize(size);
+    WideCharToMultiByte(CP_UTF8, 0, s, length, result.data(), size, NULL, NULL);
+    return result;
+}
+
+//NOTE(CSH): FileIdBothDirectoryInfo returns the file id, size and write time of a whole
+//batch of entries per call so nothing needs to be opened or stat'd per file
+void ScanDirectory(const std::string& dir, std::vector<FileEntry>& files, std::vector<std::string>& subDirs, std::vector<std::string>& links)
+{
+    HANDLE handle = CreateFileA(dir.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+        return;
+    DEFER { CloseHandle(handle); };
+
+    alignas(8) u8 buffer[64 * 1024];
+    FILE_INFO_BY_HANDLE_CLASS infoClass = FileIdBothDirectoryRestartInfo;
+    while (GetFileInformationByHandleEx(handle, infoClass, buffer, sizeof(buffer)))
+    {
+        infoClass = FileIdBothDirectoryInfo;
+        u8* entry = buffer;
+        while (true)
+        {
+            const FILE_ID_BOTH_DIR_INFO& info = *(const FILE_ID_BOTH_DIR_INFO*)entry;
+            s32 nameLength = s32(info.FileNameLength / sizeof(wchar_t));
+            bool dots = (nameLength == 1 && info.FileName[0] == L'.') ||
+                        (nameLength == 2 && info.FileName[0] == L'.' && info.FileName[1] == L'.');
+            if (!dots)
+            {
+                std::string path = dir + '/' + WideToUTF8(info.FileName, nameLength);
+                if (info.FileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                {
+                    if (info.FileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+                        links.push_back(path);
+                    else
+                        subDirs.push_back(path);
+                }
+                else
+                {
+                    FileEntry file;
+                    file.path           = path;
+                    file.fileID         = u64(info.FileId.QuadPart);
+                    file.size           = u64(info.EndOfFile.QuadPart);
+                    file.lastWriteTime  = u64(info.LastWriteTime.QuadPart);
+                    files.push_back(file);
+                }
+            }
+            if (info.NextEntryOffset == 0)
+                break;
+            entry += info.NextEntryOffset;
+        }
+    }
+}
+
+void ScanFiles(const std::string& root, std::vector<FileEntry>& out, std::vector<std::string>* directories)
+{
+    std::vector<std::string> dirs;
+    if (root.size() && (root.back() == '/' || root.back() == '\\'))
+        dirs.push_back(root.substr(0, root.size() - 1));
+    else
+        dirs.push_back(root);
+
+    while (dirs.size())
+    {
+        std::vector<std::vector<FileEntry>> files(dirs.size());
+        std::vector<std::vector<std::string>> subDirs(dirs.size());
+        std::vector<std::vector<std::string>> links(dirs.size());
+        ParallelFor(s32(dirs.size()), [&](s32 i)
+            {
+                ScanDirectory(dirs[i], files[i], subDirs[i], links[i]);
+            });
+
+        dirs.clear();
+        for (s32 i = 0; i < files.size(); i++)
+        {
+            out.insert(out.end(), files[i].begin(), files[i].end());
+            dirs.insert(dirs.end(), subDirs[i].begin(), subDirs[i].end());
+            if (directories)
+            {
+                directories->insert(directories->end(), subDirs[i].begin(), subDirs[i].end());
+                directories->insert(directories->end(), links[i].begin(), links[i].end());
+            }
+        }
+    }
+}
+
+bool GetFileEntry(const std::string& path, FileEntry& out)
+{
+    HANDLE file = CreateFileA(path.c_str(), FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    DEFER { CloseHandle(file); };
+
+    BY_HANDLE_FILE_INFORMATION info = {};
+    if (!GetFileInformationByHandle(file, &info))
+        return false;
+    out.path            = path;
+    out.fileID          = (u64(info.nFileIndexHigh) << 32) | u64(info.nFileIndexLow);
+    out.size            = (u64(info.nFileSizeHigh) << 32) | u64(info.nFileSizeLow);
+    out.lastWriteTime   = (u64(info.ftLastWriteTime.dwHighDateTime) << 32) | u64(info.ftLastWriteTime.dwLowDateTime);
+    return true;
+}
+
+bool DeleteFileNow(const std::string& path)
+{
+    //NOTE(CSH): POSIX semantics remove the name right away instead of once the last handle closes
+    //(virus scanners, indexers) so the directory can be removed right after
+    HANDLE file = CreateFileA(path.c_str(), DELETE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_FLAG_OPEN_REPARSE_POINT, NULL);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        FILE_DISPOSITION_INFO_EX disposition = {};
+        disposition.Flags = FILE_DISPOSITION_FLAG_DELETE | FILE_DISPOSITION_FLAG_POSIX_SEMANTICS | FILE_DISPOSITION_FLAG_IGNORE_READONLY_ATTRIBUTE;
+        bool deleted = SetFileInformationByHandle(file, FileDispositionInfoEx, &disposition, sizeof(disposition));
+        CloseHandle(file);
+        if (deleted)
+            return true;
+    }
+    //older versions of Windows and file systems without POSIX delete
+    SetFileAttributesA(path.c_str(), FILE_ATTRIBUTE_NORMAL);
+    return DeleteFileA(path.c_str()) || GetLastError() == ERROR_FILE_NOT_FOUND;
+}
+
+bool DeleteDirectoryTree(const std::string& dir, std::atomic<s32>* progress, std::atomic<s32>* total, std::string* failure)
+{
+    std::vector<FileEntry> files;
+    std::vector<std::string> directories;
+    ScanFiles(dir, files, &directories);
+    if (total)
+        *total += s32(files.size());
+
+    const s32 filesPerTask = 256;
+    s32 taskCount = s32((files.size() + filesPerTask - 1) / filesPerTask);
+    std::atomic<bool> failed = false;
+    std::mutex failureMutex;
+    ParallelFor(taskCount, [&](s32 task)
+        {
+            s32 end = Min<s32>(s32(files.size()), (task + 1) * filesPerTask);
+            for (s32 i = task * filesPerTask; i < end; i++)
+            {
+                if (!DeleteFileNow(files[i].path) && !failed.exchange(true) && failure)
+                {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    *failure = files[i].path;
+                }
+            }
+            if (progress)
+                *progress += end - task * filesPerTask;
+        });
+
+    //scanned breadth first so going backwards removes the deepest directories first
+    for (size_t i = directories.size(); i > 0; i--)
+        RemoveDirectoryA(directories[i - 1].c_str());
+    if (!RemoveDirectoryA(dir.c_str()) && GetLastError() != ERROR_FILE_NOT_FOUND && GetLastError() != ERROR_PATH_NOT_FOUND)
+    {
+        if (!failed.exchange(true) && failure)
+            *failure = dir;
+    }
+    return !failed;
+}
+
+bool CreateDirectories(const std::string& path)
+{
+    if (path.empty())
+        return false;
+    if (CreateDirectoryA(path.c_str(), NULL) || GetLastError() == ERROR_ALREADY_EXISTS)
+        return true;
+    if (GetLastError() != ERROR_PATH_NOT_FOUND)
+        return false;
+    size_t pos = path.find_last_of("/\\", path.size() - 2);
+    if (pos == std::string::npos || !CreateDirectories(path.substr(0, pos)))
+        return false;
+    return CreateDirectoryA(path.c_str(), NULL) || GetLastError() == ERROR_ALREADY_EXISTS;
+}
+
+bool HashFile(const std::string& path, u64& hash)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    DEFER { CloseHandle(file); };
+
+    thread_local std::vector<u8> buffer(1024 * 1024);
+    Hasher64 hasher;
+    while (true)
+    {
+        DWORD bytesRead = 0;
+        if (!ReadFile(file, buffer.data(), DWORD(buffer.size()), &bytesRead, NULL))
+            return false;
+        if (bytesRead == 0)
+            break;
+        hasher.Update(buffer.data(), bytesRead);
+    }
+    hash = hasher.Final();
+    return true;
+}
+
+bool SameFileContent(const std::string& a, const std::string& b)
+{
+    HANDLE fileA = CreateFileA(a.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (fileA == INVALID_HANDLE_VALUE)
+        return false;
+    DEFER { CloseHandle(fileA); };
+    HANDLE fileB = CreateFileA(b.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (fileB == INVALID_HANDLE_VALUE)
+        return false;
+    DEFER { CloseHandle(fileB); };
+
+    LARGE_INTEGER sizeA;
+    LARGE_INTEGER sizeB;
+    if (!GetFileSizeEx(fileA, &sizeA) || !GetFileSizeEx(fileB, &sizeB) || sizeA.QuadPart != sizeB.QuadPart)
+        return false;
+
+    thread_local std::vector<u8> bufferA(1024 * 1024);
+    thread_local std::vector<u8> bufferB(1024 * 1024);
+    while (true)
+    {
+        DWORD readA = 0;
+        DWORD readB = 0;
+        if (!ReadFile(fileA, bufferA.data(), DWORD(bufferA.size()), &readA, NULL) ||
+            !ReadFile(fileB, bufferB.data(), DWORD(bufferB.size()), &readB, NULL))
+            return false;
+        if (readA != readB)
+            return false;
+        if (readA == 0)
+            return true;
+        if (memcmp(bufferA.data(), bufferB.data(), readA) != 0)
+            return false;
+    }
+}
+
+bool ReadEntireFile(const std::string& path, std::string& out)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    DEFER { CloseHandle(file); };
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+        return false;
+    out.resize(size_t(size.QuadPart));
+    u64 offset = 0;
+    while (offset < out.size())
+    {
+        DWORD bytesRead = 0;
+        DWORD toRead = DWORD(Min<u64>(out.size() - offset, 64ull * 1024 * 1024));
+        if (!ReadFile(file, out.data() + offset, toRead, &bytesRead, NULL) || bytesRead == 0)
+            return false;
+        offset += bytesRead;
+    }
+    return true;
+}
+
+u64 CurrentFileTime()
+{
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    return (u64(now.dwHighDateTime) << 32) | u64(now.dwLowDateTime);
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "Math.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+struct FileEntry {
+    std::string path; //full path with '/' seperators
+    u64 fileID = 0;
+    u64 size = 0;
+    u64 lastWriteTime = 0;
+};
+
+//Lists every file under root, directories of the same depth are read in parallel.
+//Junctions and symlinked directories are not followed but are added to directories
+void ScanFiles(const std::string& root, std::vector<FileEntry>& out, std::vector<std::string>* directories = nullptr);
+bool GetFileEntry(const std::string& path, FileEntry& out);
+//Creates every missing directory of path, path itself is a directory
+bool CreateDirectories(const std::string& path);
+bool DeleteFileNow(const std::string& path);
+//Deletes files in parallel batches and then the directories, a missing dir counts as deleted.
+//failure gets the first path that couldn't be deleted
+bool DeleteDirectoryTree(const std::string& dir, std::atomic<s32>* progress = nullptr, std::atomic<s32>* total = nullptr, std::string* failure = nullptr);
+bool HashFile(const std::string& path, u64& hash);
+//Byte for byte, false when either can't be read
+bool SameFileContent(const std::string& a, const std::string& b);
+bool ReadEntireFile(const std::string& path, std::string& out);
+std::string WideToUTF8(const wchar_t* s, s32 length);
+u64 CurrentFileTime();
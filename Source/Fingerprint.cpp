@@ -0,0 +1,304 @@
+#include "Fingerprint.h"
+#include "Hash.h"
+#include "UATLog.h"
+#include "Windows.h"
+
+#include <algorithm>
+#include <fstream>
+
+const char* fingerprintModeNames[FingerprintMode_Count] = {
+    "Off",
+    "Ask",
+    "Automatic",
+};
+
+const char* hashCacheFileName = "HashCache.bin";
+const u32 hashCacheMagic = 0x43485548; //"UHHC"
+const u32 hashCacheVersion = 1;
+
+void HashCache::Load()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_loaded)
+        return;
+    m_loaded = true;
+    m_entries.clear();
+
+    std::ifstream file(hashCacheFileName, std::ios::binary);
+    if (file.fail())
+        return;
+    u32 magic = 0;
+    u32 version = 0;
+    u64 count = 0;
+    file.read((char*)&magic, sizeof(magic));
+    file.read((char*)&version, sizeof(version));
+    file.read((char*)&count, sizeof(count));
+    if (!file || magic != hashCacheMagic || version != hashCacheVersion)
+        return;
+
+    m_entries.reserve(count);
+    std::string path;
+    for (u64 i = 0; i < count; i++)
+    {
+        Entry entry;
+        u32 pathLength = 0;
+        file.read((char*)&entry, sizeof(entry));
+        file.read((char*)&pathLength, sizeof(pathLength));
+        path.resize(pathLength);
+        file.read(path.data(), pathLength);
+        if (!file)
+        {
+            //a truncated cache is only slower, never wrong
+            m_entries.clear();
+            return;
+        }
+        m_entries[path] = entry;
+    }
+}
+
+void HashCache::Save()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ofstream file(hashCacheFileName, std::ios::binary | std::ios::trunc);
+    if (file.fail())
+        return;
+    u64 count = m_entries.size();
+    file.write((const char*)&hashCacheMagic, sizeof(hashCacheMagic));
+    file.write((const char*)&hashCacheVersion, sizeof(hashCacheVersion));
+    file.write((const char*)&count, sizeof(count));
+    for (const auto& [path, entry] : m_entries)
+    {
+        u32 pathLength = u32(path.size());
+        file.write((const char*)&entry, sizeof(entry));
+        file.write((const char*)&pathLength, sizeof(pathLength));
+        file.write(path.data(), pathLength);
+    }
+}
+
+void HashCache::HashFiles(const std::vector<FileEntry>& files, std::vector<u64>& hashes, std::atomic<s32>* progress)
+{
+    Load();
+    hashes.assign(files.size(), 0);
+    std::vector<s32> misses;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (s32 i = 0; i < files.size(); i++)
+        {
+            const FileEntry& file = files[i];
+            auto it = m_entries.find(file.path);
+            if (it != m_entries.end() &&
+                it->second.fileID == file.fileID &&
+                it->second.size == file.size &&
+                it->second.lastWriteTime == file.lastWriteTime)
+            {
+                hashes[i] = it->second.hash;
+            }
+            else
+            {
+                misses.push_back(i);
+            }
+        }
+    }
+    if (progress)
+        *progress += s32(files.size() - misses.size());
+
+    //biggest files first so a large file at the end doesn't leave every other core idle
+    std::sort(misses.begin(), misses.end(), [&files](s32 a, s32 b)
+        {
+            return files[a].size > files[b].size;
+        });
+    std::vector<u8> hashed(files.size(), false);
+    ParallelFor(s32(misses.size()), [&](s32 i)
+        {
+            s32 index = misses[i];
+            hashed[index] = HashFile(files[index].path, hashes[index]);
+            if (progress)
+                (*progress)++;
+        });
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (s32 index : misses)
+    {
+        if (!hashed[index])
+            continue;
+        const FileEntry& file = files[index];
+        Entry& entry = m_entries[file.path];
+        entry.fileID        = file.fileID;
+        entry.size          = file.size;
+        entry.lastWriteTime = file.lastWriteTime;
+        entry.hash          = hashes[index];
+    }
+}
+
+void HashCache::Set(const FileEntry& file, u64 hash)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = m_entries[file.path];
+    entry.fileID        = file.fileID;
+    entry.size          = file.size;
+    entry.lastWriteTime = file.lastWriteTime;
+    entry.hash          = hash;
+}
+
+std::string ProjectDirectory(const std::string& projectPath)
+{
+    size_t pos = projectPath.find_last_of("/\\");
+    if (pos == std::string::npos)
+        return {};
+    return projectPath.substr(0, pos + 1);
+}
+
+std::string FingerprintKey(const BuildRequest& request)
+{
+    //another engine install or an engine update builds different binaries from the same project
+    std::string engineVersion;
+    ReadEntireFile(request.rootPath + "Engine/Build/Build.version", engineVersion);
+    u64 engineHash = Hash64(engineVersion.data(), engineVersion.size());
+    return ToString("%s|%016llx|", request.rootPath.c_str(), (unsigned long long)engineHash) +
+           request.projectPath + "|" + request.platform + "|" + GetSwitchValue(request.commandLine, "clientconfig");
+}
+
+bool EqualsNoCase(std::string_view a, std::string_view b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (s32 i = 0; i < a.size(); i++)
+    {
+        if (tolower(a[i]) != tolower(b[i]))
+            return false;
+    }
+    return true;
+}
+
+//Build output that lives next to plugin source and content, none of it is an input
+bool IsGeneratedDirectory(std::string_view relativePath)
+{
+    const char* generated[] = { "Binaries", "Intermediate", "Saved", "DerivedDataCache" };
+    size_t start = 0;
+    while (start < relativePath.size())
+    {
+        size_t end = relativePath.find('/', start);
+        if (end == std::string_view::npos)
+            break;
+        std::string_view segment = relativePath.substr(start, end - start);
+        for (const char* name : generated)
+        {
+            if (EqualsNoCase(segment, name))
+                return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+bool IsContentPath(std::string_view relativePath)
+{
+    if (relativePath.starts_with("Content/") || relativePath.starts_with("Config/"))
+        return true;
+    return relativePath.find("/Content/") != std::string_view::npos || relativePath.find("/Config/") != std::string_view::npos;
+}
+
+ProjectFingerprint ComputeProjectFingerprint(const std::string& projectPath, std::atomic<s32>* progress, std::atomic<s32>* total)
+{
+    const std::string projectDir = ProjectDirectory(projectPath);
+    std::vector<FileEntry> files;
+    const char* inputDirectories[] = { "Source", "Config", "Content", "Plugins" };
+    for (const char* dir : inputDirectories)
+        ScanFiles(projectDir + dir, files);
+    std::erase_if(files, [&projectDir](const FileEntry& file)
+        {
+            return IsGeneratedDirectory(std::string_view(file.path).substr(projectDir.size()));
+        });
+    FileEntry project;
+    if (GetFileEntry(projectPath, project))
+        files.push_back(project);
+    //the scan order depends on the threads
+    std::sort(files.begin(), files.end(), [](const FileEntry& a, const FileEntry& b)
+        {
+            return a.path < b.path;
+        });
+    if (total)
+        *total = s32(files.size());
+
+    HashCache& cache = HashCache::GetInstance();
+    std::vector<u64> hashes;
+    cache.HashFiles(files, hashes, progress);
+    cache.Save();
+
+    Hasher64 source;
+    Hasher64 content;
+    for (s32 i = 0; i < files.size(); i++)
+    {
+        std::string_view relativePath = std::string_view(files[i].path).substr(Min(projectDir.size(), files[i].path.size()));
+        Hasher64& hasher = IsContentPath(relativePath) ? content : source;
+        hasher.Update(relativePath);
+        hasher.UpdateValue(hashes[i]);
+    }
+    ProjectFingerprint result;
+    result.source = source.Final();
+    result.content = content.Final();
+    return result;
+}
+
+void RecordSuccessfulFingerprint(const BuildRun& run)
+{
+    if (!run.fingerprinted)
+        return;
+    std::map<std::string, ProjectFingerprint> fingerprints;
+    LoadFingerprints(fingerprints);
+    ProjectFingerprint& recorded = fingerprints[run.fingerprintKey];
+    const u32 completed = run.phasesCompleted;
+    bool changed = false;
+    //only a build that compiled (or was skipped because the source matched) says the binaries are up to date,
+    //a run without -build (cook only etc.) doesn't
+    if ((completed & (1 << UATPhase_Build)) || ContainsSwitch(run.extraArguments, "skipbuild"))
+    {
+        changed |= recorded.source != run.fingerprint.source;
+        recorded.source = run.fingerprint.source;
+    }
+    if (completed & (1 << UATPhase_Cook))
+    {
+        changed |= recorded.content != run.fingerprint.content;
+        recorded.content = run.fingerprint.content;
+    }
+    if (changed)
+        SaveFingerprints(fingerprints);
+}
+
+void FingerprintJob::RunJob()
+{
+    const BuildRequest& request = run->request;
+    run->fingerprintKey = FingerprintKey(request);
+    run->fingerprint = ComputeProjectFingerprint(request.projectPath, &run->fingerprintProgress, &run->fingerprintTotal);
+    run->fingerprinted = true;
+    if (mode == FingerprintMode_Off)
+        return;
+
+    std::map<std::string, ProjectFingerprint> fingerprints;
+    LoadFingerprints(fingerprints);
+    auto it = fingerprints.find(run->fingerprintKey);
+    if (it == fingerprints.end())
+        return;
+    const ProjectFingerprint& last = it->second;
+    const std::string& commandLine = request.commandLine;
+
+    bool sourceSame = last.source && last.source == run->fingerprint.source;
+    //cooking runs the project's editor code so a source change needs a cook as well
+    bool contentSame = sourceSame && last.content && last.content == run->fingerprint.content;
+    std::string skips;
+    if (sourceSame && ContainsSwitch(commandLine, "build") && !ContainsSwitch(commandLine, "skipbuild"))
+        skips += " -skipbuild";
+    if (contentSame && ContainsSwitch(commandLine, "cook") && !ContainsSwitch(commandLine, "skipcook"))
+        skips += " -skipcook";
+    if (skips.empty())
+        return;
+
+    if (mode == FingerprintMode_Ask)
+    {
+        std::string text = ToString("Nothing %s depends on changed since the last successful build of:\n%s\n\nAdd%s to the command line?",
+            contentSame ? "building or cooking" : "building", run->fingerprintKey.c_str(), skips.c_str());
+        if (!ShowQuestionWindow("Skip Unchanged Phases", text))
+            return;
+    }
+    run->extraArguments = skips;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "Math.h"
+#include "Config.h"
+#include "FileSystem.h"
+#include "BuildQueue.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern const char* fingerprintModeNames[FingerprintMode_Count];
+
+//NOTE(CSH): persistent (file id, size, write time) -> content hash cache,
+//a file is only read again once one of those changed
+struct HashCache {
+    struct Entry {
+        u64 fileID = 0;
+        u64 size = 0;
+        u64 lastWriteTime = 0;
+        u64 hash = 0;
+    };
+    std::unordered_map<std::string, Entry> m_entries;
+    std::mutex m_mutex;
+    bool m_loaded = false;
+
+    static HashCache& GetInstance()
+    {
+        static HashCache instance;
+        return instance;
+    }
+    void Load();
+    void Save();
+    //hashes aligned with files, files that couldn't be read get a hash of 0.
+    //progress counts the files that are done
+    void HashFiles(const std::vector<FileEntry>& files, std::vector<u64>& hashes, std::atomic<s32>* progress = nullptr);
+    //For files whose hash is known without reading them (a new hardlink etc.)
+    void Set(const FileEntry& file, u64 hash);
+};
+
+std::string ProjectDirectory(const std::string& projectPath);
+//NOTE(CSH): the command line switches are left out of the key on purpose,
+//changing them alone shouldn't require building and cooking again. The engine root and a hash of its
+//Build.version are in it so switching or updating the engine builds again
+std::string FingerprintKey(const BuildRequest& request);
+ProjectFingerprint ComputeProjectFingerprint(const std::string& projectPath, std::atomic<s32>* progress = nullptr, std::atomic<s32>* total = nullptr);
+//Stores the fingerprints of the phases the run completed
+void RecordSuccessfulFingerprint(const BuildRun& run);
+
+//Adds -skipbuild/-skipcook to the UAT job of the run when nothing they depend on changed
+struct FingerprintJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    s32 mode = FingerprintMode_Off;
+    virtual void RunJob() override;
+};
@@ -0,0 +1,65 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+const u64 frameArenaMinimumSize = 64 * 1024;
+
+void* FrameArena::Allocate(u64 size, u64 alignment)
+{
+    u64 start = (m_used + alignment - 1) & ~(alignment - 1);
+    if (m_block && start + size <= m_size)
+    {
+        m_used = start + size;
+        return m_block.get() + start;
+    }
+
+    //new[] is aligned for anything the frame allocates
+    m_overflow.push_back(std::make_unique<u8[]>(size));
+    m_overflowBytes += size;
+    return m_overflow.back().get();
+}
+
+void FrameArena::Reset()
+{
+    m_highWater = Max(m_highWater, m_used + m_overflowBytes);
+    if (m_overflow.size() || !m_block)
+    {
+        //one block that fits everything the largest frame needed so the next frames don't overflow again
+        m_overflow.clear();
+        m_size = Max(frameArenaMinimumSize, m_highWater + m_highWater / 2);
+        m_block = std::make_unique<u8[]>(m_size);
+    }
+    m_used = 0;
+    m_overflowBytes = 0;
+}
+
+const char* FrameFormat(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    s32 length = vsnprintf(nullptr, 0, format, copy);
+    va_end(copy);
+    if (length < 0)
+    {
+        va_end(args);
+        return "";
+    }
+    char* result = (char*)FrameArena::GetInstance().Allocate(u64(length) + 1, 1);
+    vsnprintf(result, u64(length) + 1, format, args);
+    va_end(args);
+    return result;
+}
+
+const char* FrameConcat(std::string_view a, std::string_view b, std::string_view c)
+{
+    char* result = (char*)FrameArena::GetInstance().Allocate(a.size() + b.size() + c.size() + 1, 1);
+    char* at = std::copy(a.begin(), a.end(), result);
+    at = std::copy(b.begin(), b.end(), at);
+    at = std::copy(c.begin(), c.end(), at);
+    *at = 0;
+    return result;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Math.h"
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+//NOTE(CSH): memory for everything that only has to live until the end of the frame, labels, formatted text
+//and paths that are only queried. Reset at the start of every frame, it keeps its block so once it has grown
+//to the size of the largest frame a frame doesn't touch the heap anymore. Only used from the main thread
+//NOTE(CSH): an idle main window allocates 0 times per frame after warm up (UATHelperBench allocations, 100 entries,
+//600 frames). Not covered: the size report window copies its reports while it is open, the log of a running build
+//grows, and loading/saving the config allocates
+struct FrameArena {
+    std::unique_ptr<u8[]> m_block;
+    u64 m_size = 0;
+    u64 m_used = 0;
+    std::vector<std::unique_ptr<u8[]>> m_overflow; //allocations that didn't fit in m_block this frame
+    u64 m_overflowBytes = 0;
+    u64 m_highWater = 0;
+
+    static FrameArena& GetInstance()
+    {
+        static FrameArena instance;
+        return instance;
+    }
+    void* Allocate(u64 size, u64 alignment = alignof(std::max_align_t));
+    //Everything allocated in the previous frame is invalid after this
+    void Reset();
+};
+
+//printf into the frame arena
+const char* FrameFormat(const char* format, ...);
+//a + b + c into the frame arena, null terminated
+const char* FrameConcat(std::string_view a, std::string_view b, std::string_view c = {});
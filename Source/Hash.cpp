@@ -0,0 +1,134 @@
+#include "Hash.h"
+
+#include <cstring>
+
+const u64 prime64_1 = 0x9E3779B185EBCA87ULL;
+const u64 prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+const u64 prime64_3 = 0x165667B19E3779F9ULL;
+const u64 prime64_4 = 0x85EBCA77C2B2AE63ULL;
+const u64 prime64_5 = 0x27D4EB2F165667C5ULL;
+
+static u64 RotateLeft(u64 v, s32 bits)
+{
+    return (v << bits) | (v >> (64 - bits));
+}
+
+static u64 Read64(const u8* p)
+{
+    u64 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static u32 Read32(const u8* p)
+{
+    u32 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static u64 Round(u64 acc, u64 input)
+{
+    acc += input * prime64_2;
+    acc = RotateLeft(acc, 31);
+    return acc * prime64_1;
+}
+
+static u64 MergeRound(u64 acc, u64 v)
+{
+    acc ^= Round(0, v);
+    return acc * prime64_1 + prime64_4;
+}
+
+void Hasher64::Reset(u64 seed)
+{
+    m_seed = seed;
+    m_acc[0] = seed + prime64_1 + prime64_2;
+    m_acc[1] = seed + prime64_2;
+    m_acc[2] = seed;
+    m_acc[3] = seed - prime64_1;
+    m_bufferSize = 0;
+    m_totalSize = 0;
+}
+
+void Hasher64::Update(const void* data, size_t size)
+{
+    const u8* p = (const u8*)data;
+    const u8* end = p + size;
+    m_totalSize += size;
+
+    if (m_bufferSize + size < sizeof(m_buffer))
+    {
+        memcpy(m_buffer + m_bufferSize, p, size);
+        m_bufferSize += u32(size);
+        return;
+    }
+    if (m_bufferSize)
+    {
+        u32 fill = u32(sizeof(m_buffer)) - m_bufferSize;
+        memcpy(m_buffer + m_bufferSize, p, fill);
+        p += fill;
+        for (s32 i = 0; i < 4; i++)
+            m_acc[i] = Round(m_acc[i], Read64(m_buffer + i * 8));
+        m_bufferSize = 0;
+    }
+    while (end - p >= 32)
+    {
+        for (s32 i = 0; i < 4; i++)
+            m_acc[i] = Round(m_acc[i], Read64(p + i * 8));
+        p += 32;
+    }
+    m_bufferSize = u32(end - p);
+    memcpy(m_buffer, p, m_bufferSize);
+}
+
+u64 Hasher64::Final() const
+{
+    u64 h;
+    if (m_totalSize >= 32)
+    {
+        h = RotateLeft(m_acc[0], 1) + RotateLeft(m_acc[1], 7) + RotateLeft(m_acc[2], 12) + RotateLeft(m_acc[3], 18);
+        for (s32 i = 0; i < 4; i++)
+            h = MergeRound(h, m_acc[i]);
+    }
+    else
+    {
+        h = m_seed + prime64_5;
+    }
+    h += m_totalSize;
+
+    const u8* p = m_buffer;
+    const u8* end = m_buffer + m_bufferSize;
+    while (end - p >= 8)
+    {
+        h ^= Round(0, Read64(p));
+        h = RotateLeft(h, 27) * prime64_1 + prime64_4;
+        p += 8;
+    }
+    if (end - p >= 4)
+    {
+        h ^= u64(Read32(p)) * prime64_1;
+        h = RotateLeft(h, 23) * prime64_2 + prime64_3;
+        p += 4;
+    }
+    while (p < end)
+    {
+        h ^= u64(*p) * prime64_5;
+        h = RotateLeft(h, 11) * prime64_1;
+        p++;
+    }
+
+    h ^= h >> 33;
+    h *= prime64_2;
+    h ^= h >> 29;
+    h *= prime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+u64 Hash64(const void* data, size_t size, u64 seed)
+{
+    Hasher64 hasher(seed);
+    hasher.Update(data, size);
+    return hasher.Final();
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "Math.h"
+
+#include <string_view>
+
+//NOTE(CSH): XXH64, only used to detect changes so there are no guarantees across versions of UATHelper
+struct Hasher64 {
+    u64 m_acc[4];
+    u8  m_buffer[32];
+    u32 m_bufferSize;
+    u64 m_totalSize;
+    u64 m_seed;
+
+    Hasher64(u64 seed = 0)
+    {
+        Reset(seed);
+    }
+    void Reset(u64 seed = 0);
+    void Update(const void* data, size_t size);
+    void Update(std::string_view s)
+    {
+        Update(s.data(), s.size());
+    }
+    template <typename T>
+    void UpdateValue(const T& value)
+    {
+        Update(&value, sizeof(value));
+    }
+    [[nodiscard]] u64 Final() const;
+};
+
+[[nodiscard]] u64 Hash64(const void* data, size_t size, u64 seed = 0);
@@ -0,0 +1,221 @@
+#include "HostSlots.h"
+
+#include "SDL.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <sddl.h>
+
+#include <atomic>
+#include <string>
+
+// NOTE(CSH): every UATHelper process maps the same named section and registers each running UAT build
+// in a slot. A named mutex guards the table, if the owner of the mutex crashes the next process gets
+// WAIT_ABANDONED and still owns it. Slots of processes that are no longer alive are reclaimed
+// by checking the process id together with its creation time so a reused pid doesn't keep a slot alive.
+
+const u32 hostSlotVersion = 1;
+const s32 hostSlotCount = 64;
+
+struct HostSlot {
+    u32 processID;
+    u64 processCreationTime;
+    s32 memoryMB;
+};
+
+struct HostSlotTable {
+    u32 version;
+    HostSlot slots[hostSlotCount];
+};
+
+HANDLE          s_hostSlotMutex = NULL;
+HANDLE          s_hostSlotMapping = NULL;
+HostSlotTable*  s_hostSlotTable = nullptr;
+std::atomic<bool> s_hostSlotWaiting = false;
+std::atomic<s32>  s_hostSlotBuildsRunning = 0;
+std::atomic<s32>  s_hostSlotMemoryReserved = 0;
+
+u64 FileTimeToU64(const FILETIME& time)
+{
+    return (u64(time.dwHighDateTime) << 32) | u64(time.dwLowDateTime);
+}
+
+u64 GetProcessCreationTime(HANDLE process)
+{
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(process, &creation, &exit, &kernel, &user))
+        return 0;
+    return FileTimeToU64(creation);
+}
+
+//NOTE(CSH): the default DACL only lets the user that created the objects open them, every interactive user
+//(console and RDP), SYSTEM and admins get full access instead. The low integrity label lets a process that isn't
+//elevated write to objects an elevated instance created
+const char* hostSlotSecurityDescriptor = "D:(A;;GA;;;IU)(A;;GA;;;SY)(A;;GA;;;BA)S:(ML;;NW;;;LW)";
+
+bool OpenHostSlotTable(const char* nameSpace)
+{
+    std::string mutexName   = std::string(nameSpace) + "UATHelperHostSlotsMutex";
+    std::string mappingName = std::string(nameSpace) + "UATHelperHostSlots";
+    SECURITY_ATTRIBUTES security = {};
+    security.nLength = sizeof(security);
+    security.bInheritHandle = FALSE;
+    if (!ConvertStringSecurityDescriptorToSecurityDescriptorA(hostSlotSecurityDescriptor, SDDL_REVISION_1, &security.lpSecurityDescriptor, NULL))
+        return false;
+    DEFER { LocalFree(security.lpSecurityDescriptor); };
+    HANDLE mutex = CreateMutexA(&security, FALSE, mutexName.c_str());
+    if (mutex == NULL)
+        return false;
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, &security, PAGE_READWRITE, 0, sizeof(HostSlotTable), mappingName.c_str());
+    if (mapping == NULL)
+    {
+        CloseHandle(mutex);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(HostSlotTable));
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(mutex);
+        return false;
+    }
+    s_hostSlotMutex     = mutex;
+    s_hostSlotMapping   = mapping;
+    s_hostSlotTable     = (HostSlotTable*)view;
+    return true;
+}
+
+bool InitHostSlots()
+{
+    if (s_hostSlotTable)
+        return true;
+    //Global objects are shared between sessions (RDP) but need SeCreateGlobalPrivilege,
+    //fall back to the session namespace so at least instances of the same user are coordinated
+    if (OpenHostSlotTable("Global\\"))
+        return true;
+    SDL_Log("Host build slots: Global namespace unavailable (%i), only builds of this session are coordinated", GetLastError());
+    if (OpenHostSlotTable("Local\\"))
+        return true;
+    SDL_Log("Host build slots unavailable: %i", GetLastError());
+    return false;
+}
+
+bool LockHostSlots()
+{
+    DWORD result = WaitForSingleObject(s_hostSlotMutex, INFINITE);
+    return result == WAIT_OBJECT_0 || result == WAIT_ABANDONED;
+}
+
+bool SlotIsAlive(const HostSlot& slot)
+{
+    if (slot.processID == 0)
+        return false;
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, slot.processID);
+    //only a pid that doesn't exist is dead, another user's (elevated) UAT is access denied and still running
+    if (process == NULL)
+        return GetLastError() != ERROR_INVALID_PARAMETER;
+    DEFER { CloseHandle(process); };
+    DWORD exitCode = {};
+    if (!GetExitCodeProcess(process, &exitCode) || exitCode != STILL_ACTIVE)
+        return false;
+    return GetProcessCreationTime(process) == slot.processCreationTime;
+}
+
+//Must be called with the mutex held
+void ReclaimDeadHostSlots(HostSlotTable& table)
+{
+    if (table.version != hostSlotVersion)
+    {
+        table = {};
+        table.version = hostSlotVersion;
+    }
+    for (s32 i = 0; i < hostSlotCount; i++)
+    {
+        HostSlot& slot = table.slots[i];
+        if (slot.processID && !SlotIsAlive(slot))
+            slot = {};
+    }
+}
+
+s32 AcquireHostBuildSlot(const HostBudget& budget, s32 memoryMB, const std::atomic<bool>* cancel)
+{
+    if (!InitHostSlots())
+        return -1;
+
+    const u32 processID = GetCurrentProcessId();
+    const u64 processCreationTime = GetProcessCreationTime(GetCurrentProcess());
+    const s32 reservationMB = memoryMB > 0 ? memoryMB : budget.memoryBudgetMB;
+    DEFER { s_hostSlotWaiting = false; };
+    while (true)
+    {
+        if (cancel && *cancel)
+            return hostSlotCancelled;
+        if (!LockHostSlots())
+            return -1;
+
+        HostSlotTable& table = *s_hostSlotTable;
+        ReclaimDeadHostSlots(table);
+        s32 running = 0;
+        s32 reserved = 0;
+        s32 freeSlot = -1;
+        for (s32 i = 0; i < hostSlotCount; i++)
+        {
+            if (table.slots[i].processID)
+            {
+                running++;
+                reserved += table.slots[i].memoryMB;
+            }
+            else if (freeSlot == -1)
+            {
+                freeSlot = i;
+            }
+        }
+        s_hostSlotBuildsRunning = running;
+        s_hostSlotMemoryReserved = reserved;
+
+        bool fits = freeSlot != -1;
+        if (budget.maxConcurrentBuilds > 0)
+            fits &= running < budget.maxConcurrentBuilds;
+        //an empty host always gets to build even if the reservation alone is over the budget
+        if (budget.memoryBudgetMB > 0 && running)
+            fits &= reserved + reservationMB <= budget.memoryBudgetMB;
+        if (fits)
+        {
+            HostSlot& slot = table.slots[freeSlot];
+            slot.processID = processID;
+            slot.processCreationTime = processCreationTime;
+            slot.memoryMB = reservationMB;
+            s_hostSlotBuildsRunning = running + 1;
+            s_hostSlotMemoryReserved = reserved + reservationMB;
+        }
+        ReleaseMutex(s_hostSlotMutex);
+
+        if (fits)
+            return freeSlot;
+        s_hostSlotWaiting = true;
+        //short sleeps so a cancel doesn't wait on the other instances
+        for (s32 i = 0; i < 10 && !(cancel && *cancel); i++)
+            Sleep(100);
+    }
+}
+
+void ReleaseHostBuildSlot(s32 slot)
+{
+    if (slot < 0 || slot >= hostSlotCount || !s_hostSlotTable)
+        return;
+    if (!LockHostSlots())
+        return;
+    HostSlot& s = s_hostSlotTable->slots[slot];
+    if (s.processID == GetCurrentProcessId())
+        s = {};
+    ReleaseMutex(s_hostSlotMutex);
+}
+
+HostSlotStatus GetHostSlotStatus()
+{
+    HostSlotStatus status;
+    status.waiting          = s_hostSlotWaiting;
+    status.buildsRunning    = s_hostSlotBuildsRunning;
+    status.memoryReservedMB = s_hostSlotMemoryReserved;
+    return status;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "Math.h"
+
+#include <atomic>
+
+//Host wide limits shared by every UATHelper process on the machine
+struct HostBudget {
+    s32 maxConcurrentBuilds = 0; //0 = unlimited
+    s32 memoryBudgetMB = 0; //0 = unlimited
+};
+
+struct HostSlotStatus {
+    bool waiting = false;
+    s32 buildsRunning = 0;
+    s32 memoryReservedMB = 0;
+};
+
+const s32 hostSlotCancelled = -2;
+
+//Blocks until the build fits inside of the host budget or cancel is set.
+//memoryMB of 0 means the build has no memory limit and reserves the whole memory budget
+//returns the slot that needs to be released, -1 if there was nothing to reserve or hostSlotCancelled
+[[nodiscard]] s32 AcquireHostBuildSlot(const HostBudget& budget, s32 memoryMB, const std::atomic<bool>* cancel = nullptr);
+void ReleaseHostBuildSlot(s32 slot);
+HostSlotStatus GetHostSlotStatus();
@@ -0,0 +1,217 @@
+#include "InputRecording.h"
+#include "FileSystem.h"
+#include "AsyncFileWriter.h"
+
+#include "imgui.h"
+
+#include <cfloat>
+#include <cstring>
+
+const u32 recordingMagic = 0x52544155; //"UATR"
+const u32 recordingVersion = 2;
+
+struct RecordingHeader {
+    u32 magic;
+    u32 version;
+    u32 eventSize; //SDL_Event is stored as it is, a different SDL can't read it
+    s32 windowWidth;
+    s32 windowHeight;
+    u32 buildQueuePaused;
+    u32 configSize;
+    u32 appSettingsSize;
+    u32 buildQueueSize;
+    u32 frameCount;
+    u32 eventCount;
+};
+
+void InputRecording::BeginFrame()
+{
+    RecordedFrame& frame = frames.emplace_back();
+    frame.firstEvent = u32(events.size());
+}
+
+void InputRecording::Add(const SDL_Event& event)
+{
+    if (frames.empty())
+        BeginFrame();
+    if (event.type == SDL_DROPFILE || event.type == SDL_DROPTEXT || event.type >= SDL_USEREVENT)
+        return;
+    events.push_back(event);
+    frames.back().eventCount++;
+}
+
+void InputRecording::SetFrameDeltaTime(f32 deltaTime)
+{
+    if (frames.size())
+        frames.back().deltaTime = deltaTime;
+}
+
+void SaveInputRecording(const std::string& filename, const InputRecording& recording)
+{
+    RecordingHeader header = {};
+    header.magic = recordingMagic;
+    header.version = recordingVersion;
+    header.eventSize = sizeof(SDL_Event);
+    header.windowWidth = recording.windowWidth;
+    header.windowHeight = recording.windowHeight;
+    header.buildQueuePaused = recording.buildQueuePaused;
+    header.configSize = u32(recording.config.size());
+    header.appSettingsSize = u32(recording.appSettings.size());
+    header.buildQueueSize = u32(recording.buildQueue.size());
+    header.frameCount = u32(recording.frames.size());
+    header.eventCount = u32(recording.events.size());
+
+    std::string data;
+    data.reserve(sizeof(header) + recording.config.size() + recording.appSettings.size() + recording.buildQueue.size() + recording.frames.size() * sizeof(RecordedFrame) + recording.events.size() * sizeof(SDL_Event));
+    data.append((const char*)&header, sizeof(header));
+    data += recording.config;
+    data += recording.appSettings;
+    data += recording.buildQueue;
+    data.append((const char*)recording.frames.data(), recording.frames.size() * sizeof(RecordedFrame));
+    data.append((const char*)recording.events.data(), recording.events.size() * sizeof(SDL_Event));
+    AsyncFileWriter::GetInstance().Write(filename, std::move(data));
+}
+
+bool LoadInputRecording(const std::string& filename, InputRecording& out)
+{
+    out = {};
+    std::string data;
+    if (!ReadEntireFile(filename, data) || data.size() < sizeof(RecordingHeader))
+        return false;
+    RecordingHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != recordingMagic || header.version != recordingVersion || header.eventSize != sizeof(SDL_Event))
+        return false;
+    u64 expectedSize = sizeof(header) + u64(header.configSize) + u64(header.appSettingsSize) + u64(header.buildQueueSize) + u64(header.frameCount) * sizeof(RecordedFrame) + u64(header.eventCount) * sizeof(SDL_Event);
+    if (data.size() != expectedSize)
+        return false;
+
+    out.windowWidth = header.windowWidth;
+    out.windowHeight = header.windowHeight;
+    out.buildQueuePaused = header.buildQueuePaused != 0;
+    const char* cursor = data.data() + sizeof(header);
+    out.config.assign(cursor, header.configSize);
+    cursor += header.configSize;
+    out.appSettings.assign(cursor, header.appSettingsSize);
+    cursor += header.appSettingsSize;
+    out.buildQueue.assign(cursor, header.buildQueueSize);
+    cursor += header.buildQueueSize;
+    out.frames.resize(header.frameCount);
+    memcpy(out.frames.data(), cursor, header.frameCount * sizeof(RecordedFrame));
+    cursor += header.frameCount * sizeof(RecordedFrame);
+    out.events.resize(header.eventCount);
+    memcpy(out.events.data(), cursor, header.eventCount * sizeof(SDL_Event));
+
+    for (const RecordedFrame& frame : out.frames)
+    {
+        if (u64(frame.firstEvent) + frame.eventCount > out.events.size())
+        {
+            out = {};
+            return false;
+        }
+    }
+    return true;
+}
+
+//Only the keys the UI can react to, the SDL backend maps the rest of the keyboard
+ImGuiKey KeycodeToImGuiKey(SDL_Keycode keycode)
+{
+    if (keycode >= SDLK_a && keycode <= SDLK_z)
+        return ImGuiKey(ImGuiKey_A + (keycode - SDLK_a));
+    if (keycode >= SDLK_0 && keycode <= SDLK_9)
+        return ImGuiKey(ImGuiKey_0 + (keycode - SDLK_0));
+    if (keycode >= SDLK_F1 && keycode <= SDLK_F12)
+        return ImGuiKey(ImGuiKey_F1 + (keycode - SDLK_F1));
+    switch (keycode)
+    {
+    case SDLK_TAB:          return ImGuiKey_Tab;
+    case SDLK_LEFT:         return ImGuiKey_LeftArrow;
+    case SDLK_RIGHT:        return ImGuiKey_RightArrow;
+    case SDLK_UP:           return ImGuiKey_UpArrow;
+    case SDLK_DOWN:         return ImGuiKey_DownArrow;
+    case SDLK_PAGEUP:       return ImGuiKey_PageUp;
+    case SDLK_PAGEDOWN:     return ImGuiKey_PageDown;
+    case SDLK_HOME:         return ImGuiKey_Home;
+    case SDLK_END:          return ImGuiKey_End;
+    case SDLK_INSERT:       return ImGuiKey_Insert;
+    case SDLK_DELETE:       return ImGuiKey_Delete;
+    case SDLK_BACKSPACE:    return ImGuiKey_Backspace;
+    case SDLK_SPACE:        return ImGuiKey_Space;
+    case SDLK_RETURN:       return ImGuiKey_Enter;
+    case SDLK_KP_ENTER:     return ImGuiKey_KeypadEnter;
+    case SDLK_ESCAPE:       return ImGuiKey_Escape;
+    case SDLK_LCTRL:        return ImGuiKey_LeftCtrl;
+    case SDLK_LSHIFT:       return ImGuiKey_LeftShift;
+    case SDLK_LALT:         return ImGuiKey_LeftAlt;
+    case SDLK_LGUI:         return ImGuiKey_LeftSuper;
+    case SDLK_RCTRL:        return ImGuiKey_RightCtrl;
+    case SDLK_RSHIFT:       return ImGuiKey_RightShift;
+    case SDLK_RALT:         return ImGuiKey_RightAlt;
+    case SDLK_RGUI:         return ImGuiKey_RightSuper;
+    case SDLK_APPLICATION:  return ImGuiKey_Menu;
+    }
+    return ImGuiKey_None;
+}
+
+void ReplayEvent(const SDL_Event& event)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    switch (event.type)
+    {
+    case SDL_MOUSEMOTION:
+    {
+        io.AddMousePosEvent(f32(event.motion.x), f32(event.motion.y));
+        break;
+    }
+    case SDL_MOUSEWHEEL:
+    {
+        io.AddMouseWheelEvent(-f32(event.wheel.x), f32(event.wheel.y));
+        break;
+    }
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+    {
+        s32 button = -1;
+        switch (event.button.button)
+        {
+        case SDL_BUTTON_LEFT:   button = 0; break;
+        case SDL_BUTTON_RIGHT:  button = 1; break;
+        case SDL_BUTTON_MIDDLE: button = 2; break;
+        case SDL_BUTTON_X1:     button = 3; break;
+        case SDL_BUTTON_X2:     button = 4; break;
+        }
+        if (button != -1)
+            io.AddMouseButtonEvent(button, event.type == SDL_MOUSEBUTTONDOWN);
+        break;
+    }
+    case SDL_TEXTINPUT:
+    {
+        io.AddInputCharactersUTF8(event.text.text);
+        break;
+    }
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+    {
+        const u16 mod = event.key.keysym.mod;
+        io.AddKeyEvent(ImGuiMod_Ctrl, (mod & KMOD_CTRL) != 0);
+        io.AddKeyEvent(ImGuiMod_Shift, (mod & KMOD_SHIFT) != 0);
+        io.AddKeyEvent(ImGuiMod_Alt, (mod & KMOD_ALT) != 0);
+        io.AddKeyEvent(ImGuiMod_Super, (mod & KMOD_GUI) != 0);
+        ImGuiKey key = KeycodeToImGuiKey(event.key.keysym.sym);
+        if (key != ImGuiKey_None)
+            io.AddKeyEvent(key, event.type == SDL_KEYDOWN);
+        break;
+    }
+    case SDL_WINDOWEVENT:
+    {
+        switch (event.window.event)
+        {
+        case SDL_WINDOWEVENT_LEAVE:         io.AddMousePosEvent(-FLT_MAX, -FLT_MAX); break;
+        case SDL_WINDOWEVENT_FOCUS_GAINED:  io.AddFocusEvent(true); break;
+        case SDL_WINDOWEVENT_FOCUS_LOST:    io.AddFocusEvent(false); break;
+        case SDL_WINDOWEVENT_SIZE_CHANGED:  io.DisplaySize = ImVec2(f32(event.window.data1), f32(event.window.data2)); break;
+        }
+        break;
+    }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "Math.h"
+
+#include <SDL.h>
+
+#include <string>
+#include <vector>
+
+//NOTE(CSH): the SDL events of a session grouped by the frame they were polled in, with the delta time of that
+//frame, so a replay sees the same input on the same frame no matter how fast it runs. The config, the app settings
+//and the build queue the session started with are stored with it so the clicks land on the same widgets.
+//Recorded with UATHelper -record <file>, replayed with UATHelperBench replay <file>
+struct RecordedFrame {
+    f32 deltaTime = 0;
+    u32 firstEvent = 0;
+    u32 eventCount = 0;
+};
+
+struct InputRecording {
+    s32 windowWidth = 0;
+    s32 windowHeight = 0;
+    std::string config; //json, the same as a config file
+    std::string appSettings; //json, the same as the app settings file
+    std::string buildQueue; //json, the same as the build queue file
+    bool buildQueuePaused = false;
+    std::vector<RecordedFrame> frames;
+    std::vector<SDL_Event> events;
+
+    void BeginFrame();
+    //Drop and user events point to memory that is gone by the time they are replayed, they are skipped
+    void Add(const SDL_Event& event);
+    void SetFrameDeltaTime(f32 deltaTime);
+};
+
+void SaveInputRecording(const std::string& filename, const InputRecording& recording);
+//returns false if the file can't be read or was recorded with another SDL_Event layout
+bool LoadInputRecording(const std::string& filename, InputRecording& out);
+
+//Hands a recorded event to ImGui the way the SDL backend does, for replays without a window
+void ReplayEvent(const SDL_Event& event);
@@ -0,0 +1,507 @@
+#include "JsonStream.h"
+
+#include <charconv>
+#include <cmath>
+
+JsonReader::JsonReader(std::string_view text)
+    : m_at(text.data())
+    , m_end(text.data() + text.size())
+{
+    //UTF-8 BOM from editors like notepad
+    if (text.starts_with("\xEF\xBB\xBF"))
+        m_at += 3;
+}
+
+bool JsonReader::Fail()
+{
+    m_failed = true;
+    m_at = m_end;
+    return false;
+}
+
+void JsonReader::SkipWhitespace()
+{
+    while (m_at < m_end && (*m_at == ' ' || *m_at == '\n' || *m_at == '\r' || *m_at == '\t'))
+        m_at++;
+}
+
+bool JsonReader::Expect(char c)
+{
+    SkipWhitespace();
+    if (m_at == m_end || *m_at != c)
+        return Fail();
+    m_at++;
+    return true;
+}
+
+JsonType JsonReader::Peek()
+{
+    SkipWhitespace();
+    if (m_at == m_end)
+        return JsonType_Invalid;
+    switch (*m_at)
+    {
+    case '{': return JsonType_Object;
+    case '[': return JsonType_Array;
+    case '\"': return JsonType_String;
+    case 't':
+    case 'f': return JsonType_Bool;
+    case 'n': return JsonType_Null;
+    }
+    if (*m_at == '-' || (*m_at >= '0' && *m_at <= '9'))
+        return JsonType_Number;
+    return JsonType_Invalid;
+}
+
+bool JsonReader::BeginObject()
+{
+    return Expect('{');
+}
+
+//NOTE(CSH): the separators aren't tracked, a comma before the first element is accepted
+bool JsonReader::NextKey(std::string_view& key)
+{
+    SkipWhitespace();
+    if (m_at < m_end && *m_at == ',')
+        m_at++;
+    SkipWhitespace();
+    if (m_at < m_end && *m_at == '}')
+    {
+        m_at++;
+        return false;
+    }
+    if (m_at == m_end || *m_at != '\"')
+        return Fail();
+
+    //keys almost never have escapes, point into the text when they don't
+    const char* start = m_at + 1;
+    const char* end = start;
+    while (end < m_end && *end != '\"' && *end != '\\')
+        end++;
+    if (end < m_end && *end == '\"')
+    {
+        key = std::string_view(start, end - start);
+        m_at = end + 1;
+    }
+    else
+    {
+        if (!ParseString(m_scratch))
+            return false;
+        key = m_scratch;
+    }
+    return Expect(':');
+}
+
+bool JsonReader::BeginArray()
+{
+    return Expect('[');
+}
+
+bool JsonReader::NextElement()
+{
+    SkipWhitespace();
+    if (m_at < m_end && *m_at == ',')
+        m_at++;
+    SkipWhitespace();
+    if (m_at < m_end && *m_at == ']')
+    {
+        m_at++;
+        return false;
+    }
+    if (m_at == m_end)
+        return Fail();
+    return true;
+}
+
+void AppendUTF8(std::string& out, u32 codepoint)
+{
+    if (codepoint < 0x80)
+    {
+        out += char(codepoint);
+    }
+    else if (codepoint < 0x800)
+    {
+        out += char(0xC0 | (codepoint >> 6));
+        out += char(0x80 | (codepoint & 0x3F));
+    }
+    else if (codepoint < 0x10000)
+    {
+        out += char(0xE0 | (codepoint >> 12));
+        out += char(0x80 | ((codepoint >> 6) & 0x3F));
+        out += char(0x80 | (codepoint & 0x3F));
+    }
+    else
+    {
+        out += char(0xF0 | (codepoint >> 18));
+        out += char(0x80 | ((codepoint >> 12) & 0x3F));
+        out += char(0x80 | ((codepoint >> 6) & 0x3F));
+        out += char(0x80 | (codepoint & 0x3F));
+    }
+}
+
+bool ParseHex4(const char*& at, const char* end, u32& out)
+{
+    if (end - at < 4)
+        return false;
+    auto result = std::from_chars(at, at + 4, out, 16);
+    if (result.ptr != at + 4)
+        return false;
+    at += 4;
+    return true;
+}
+
+bool JsonReader::ParseString(std::string& out)
+{
+    out.clear();
+    if (!Expect('\"'))
+        return false;
+    while (m_at < m_end)
+    {
+        //copy the runs without escapes at once
+        const char* run = m_at;
+        while (m_at < m_end && *m_at != '\"' && *m_at != '\\')
+            m_at++;
+        out.append(run, m_at - run);
+        if (m_at == m_end)
+            break;
+        if (*m_at == '\"')
+        {
+            m_at++;
+            return true;
+        }
+
+        m_at++;
+        if (m_at == m_end)
+            break;
+        char c = *m_at++;
+        switch (c)
+        {
+        case '\"': out += '\"'; break;
+        case '\\': out += '\\'; break;
+        case '/':  out += '/';  break;
+        case 'b':  out += '\b'; break;
+        case 'f':  out += '\f'; break;
+        case 'n':  out += '\n'; break;
+        case 'r':  out += '\r'; break;
+        case 't':  out += '\t'; break;
+        case 'u':
+        {
+            u32 codepoint = 0;
+            if (!ParseHex4(m_at, m_end, codepoint))
+                return Fail();
+            if (codepoint >= 0xD800 && codepoint < 0xDC00)
+            {
+                u32 low = 0;
+                if (m_end - m_at < 2 || m_at[0] != '\\' || m_at[1] != 'u')
+                    return Fail();
+                m_at += 2;
+                if (!ParseHex4(m_at, m_end, low) || low < 0xDC00 || low > 0xDFFF)
+                    return Fail();
+                codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+            }
+            AppendUTF8(out, codepoint);
+            break;
+        }
+        default:
+            return Fail();
+        }
+    }
+    return Fail();
+}
+
+bool JsonReader::ReadString(std::string& out)
+{
+    if (Peek() != JsonType_String)
+        return Fail();
+    return ParseString(out);
+}
+
+bool JsonReader::ReadBool(bool& out)
+{
+    SkipWhitespace();
+    std::string_view rest(m_at, m_end - m_at);
+    if (rest.starts_with("true"))
+    {
+        out = true;
+        m_at += 4;
+        return true;
+    }
+    if (rest.starts_with("false"))
+    {
+        out = false;
+        m_at += 5;
+        return true;
+    }
+    return Fail();
+}
+
+bool JsonReader::ReadNull()
+{
+    SkipWhitespace();
+    if (std::string_view(m_at, m_end - m_at).starts_with("null"))
+    {
+        m_at += 4;
+        return true;
+    }
+    return false;
+}
+
+//Skips the fraction and exponent of a number that was read as an integer
+void SkipNumberRest(const char*& at, const char* end)
+{
+    while (at < end && ((*at >= '0' && *at <= '9') || *at == '.' || *at == 'e' || *at == 'E' || *at == '+' || *at == '-'))
+        at++;
+}
+
+bool JsonReader::ReadInt(s64& out)
+{
+    if (Peek() != JsonType_Number)
+        return Fail();
+    auto result = std::from_chars(m_at, m_end, out);
+    if (result.ec != std::errc())
+    {
+        f64 f = 0;
+        if (!ReadFloat(f))
+            return false;
+        out = s64(f);
+        return true;
+    }
+    m_at = result.ptr;
+    SkipNumberRest(m_at, m_end);
+    return true;
+}
+
+bool JsonReader::ReadUInt(u64& out)
+{
+    if (Peek() != JsonType_Number)
+        return Fail();
+    if (*m_at == '-')
+    {
+        s64 i = 0;
+        if (!ReadInt(i))
+            return false;
+        out = u64(i);
+        return true;
+    }
+    auto result = std::from_chars(m_at, m_end, out);
+    if (result.ec != std::errc())
+        return Fail();
+    m_at = result.ptr;
+    SkipNumberRest(m_at, m_end);
+    return true;
+}
+
+bool JsonReader::ReadFloat(f64& out)
+{
+    if (Peek() != JsonType_Number)
+        return Fail();
+    auto result = std::from_chars(m_at, m_end, out);
+    if (result.ec != std::errc())
+        return Fail();
+    m_at = result.ptr;
+    return true;
+}
+
+void JsonReader::Skip()
+{
+    switch (Peek())
+    {
+    case JsonType_Null:
+    {
+        if (!ReadNull())
+            Fail();
+        break;
+    }
+    case JsonType_Bool:
+    {
+        bool b;
+        ReadBool(b);
+        break;
+    }
+    case JsonType_Number:
+    {
+        m_at++;
+        SkipNumberRest(m_at, m_end);
+        break;
+    }
+    case JsonType_String:
+    {
+        ParseString(m_scratch);
+        break;
+    }
+    case JsonType_Array:
+    {
+        if (m_skipDepth >= jsonMaxSkipDepth)
+        {
+            Fail();
+            break;
+        }
+        m_skipDepth++;
+        BeginArray();
+        while (NextElement())
+            Skip();
+        m_skipDepth--;
+        break;
+    }
+    case JsonType_Object:
+    {
+        if (m_skipDepth >= jsonMaxSkipDepth)
+        {
+            Fail();
+            break;
+        }
+        m_skipDepth++;
+        BeginObject();
+        std::string_view key;
+        while (NextKey(key))
+            Skip();
+        m_skipDepth--;
+        break;
+    }
+    default:
+        Fail();
+    }
+}
+
+void JsonWriter::BeginValue()
+{
+    if (m_afterKey)
+    {
+        m_afterKey = false;
+        return;
+    }
+    if (m_counts.empty())
+        return;
+    if (m_counts.back()++)
+        m_out += ',';
+    m_out += '\n';
+    m_out.append(m_counts.size() * 4, ' ');
+}
+
+void JsonWriter::Close(char c)
+{
+    s32 count = m_counts.back();
+    m_counts.pop_back();
+    if (count)
+    {
+        m_out += '\n';
+        m_out.append(m_counts.size() * 4, ' ');
+    }
+    m_out += c;
+}
+
+void JsonWriter::BeginObject()
+{
+    BeginValue();
+    m_out += '{';
+    m_counts.push_back(0);
+}
+
+void JsonWriter::EndObject()
+{
+    Close('}');
+}
+
+void JsonWriter::BeginArray()
+{
+    BeginValue();
+    m_out += '[';
+    m_counts.push_back(0);
+}
+
+void JsonWriter::EndArray()
+{
+    Close(']');
+}
+
+void JsonWriter::Key(std::string_view key)
+{
+    BeginValue();
+    Escaped(key);
+    m_out += ": ";
+    m_afterKey = true;
+}
+
+void JsonWriter::Escaped(std::string_view s)
+{
+    m_out += '\"';
+    for (char c : s)
+    {
+        switch (c)
+        {
+        case '\"': m_out += "\\\""; break;
+        case '\\': m_out += "\\\\"; break;
+        case '\b': m_out += "\\b";  break;
+        case '\f': m_out += "\\f";  break;
+        case '\n': m_out += "\\n";  break;
+        case '\r': m_out += "\\r";  break;
+        case '\t': m_out += "\\t";  break;
+        default:
+        {
+            if (u8(c) < 0x20)
+            {
+                const char* hex = "0123456789abcdef";
+                m_out += "\\u00";
+                m_out += hex[u8(c) >> 4];
+                m_out += hex[u8(c) & 0xF];
+            }
+            else
+            {
+                m_out += c;
+            }
+        }
+        }
+    }
+    m_out += '\"';
+}
+
+void JsonWriter::String(std::string_view s)
+{
+    BeginValue();
+    Escaped(s);
+}
+
+void JsonWriter::Bool(bool b)
+{
+    BeginValue();
+    m_out += b ? "true" : "false";
+}
+
+void JsonWriter::Int(s64 i)
+{
+    BeginValue();
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), i);
+    m_out.append(buffer, result.ptr);
+}
+
+void JsonWriter::UInt(u64 u)
+{
+    BeginValue();
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), u);
+    m_out.append(buffer, result.ptr);
+}
+
+void JsonWriter::Float(f64 f)
+{
+    BeginValue();
+    if (!std::isfinite(f))
+    {
+        m_out += "null";
+        return;
+    }
+    char buffer[64];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), f);
+    std::string_view s(buffer, result.ptr - buffer);
+    m_out += s;
+    //nlohmann writes 60.0 instead of 60 so the number stays a float when it is read back
+    if (s.find_first_of(".eE") == std::string_view::npos)
+        m_out += ".0";
+}
+
+void JsonWriter::Null()
+{
+    BeginValue();
+    m_out += "null";
+}
@@ -0,0 +1,239 @@
+#pragma once
+#include "Math.h"
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+const s32 jsonMaxSkipDepth = 256;
+
+enum JsonType : s32 {
+    JsonType_Invalid,
+    JsonType_Null,
+    JsonType_Bool,
+    JsonType_Number,
+    JsonType_String,
+    JsonType_Array,
+    JsonType_Object,
+};
+
+//NOTE(CSH): pull parser that reads values straight into the destination without building a DOM.
+//Objects are read with BeginObject + NextKey until it returns false, arrays with BeginArray + NextElement.
+//Any value that isn't needed has to be skipped with Skip. A syntax error makes every call fail from then on
+struct JsonReader {
+    const char* m_at = nullptr;
+    const char* m_end = nullptr;
+    bool m_failed = false;
+    s32 m_skipDepth = 0;
+    std::string m_scratch; //keys with escapes are unescaped into this
+
+    JsonReader(std::string_view text);
+    bool Failed() const
+    {
+        return m_failed;
+    }
+    JsonType Peek();
+    bool BeginObject();
+    //key stays valid until the next call
+    bool NextKey(std::string_view& key);
+    bool BeginArray();
+    bool NextElement();
+    bool ReadString(std::string& out);
+    bool ReadBool(bool& out);
+    bool ReadInt(s64& out);
+    bool ReadUInt(u64& out);
+    bool ReadFloat(f64& out);
+    //Consumes a null, returns false without consuming anything else
+    bool ReadNull();
+    //Fails on anything nested deeper than jsonMaxSkipDepth so a broken file can't run out of stack
+    void Skip();
+
+    void SkipWhitespace();
+    bool Fail();
+    bool Expect(char c);
+    bool ParseString(std::string& out);
+};
+
+//Writes the same layout as nlohmann::json::dump(4)
+struct JsonWriter {
+    std::string m_out;
+    std::vector<s32> m_counts; //elements written per open object/array
+    bool m_afterKey = false;
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+    void Key(std::string_view key);
+    void String(std::string_view s);
+    void Bool(bool b);
+    void Int(s64 i);
+    void UInt(u64 u);
+    void Float(f64 f);
+    void Null();
+
+    void BeginValue();
+    void Close(char c);
+    void Escaped(std::string_view s);
+};
+
+//NOTE(CSH): field tables map json keys to members so a struct is read and written without a DOM.
+//write gets the key so it can leave out fields that are empty, read is only called for values that aren't null
+template <typename T>
+struct JsonField {
+    const char* name;
+    void (*read)(JsonReader& r, T& out);
+    void (*write)(JsonWriter& w, const char* key, const T& in);
+};
+
+inline void JsonRead(JsonReader& r, s32& out)
+{
+    s64 i = 0;
+    r.ReadInt(i);
+    out = s32(i);
+}
+inline void JsonRead(JsonReader& r, u64& out)
+{
+    r.ReadUInt(out);
+}
+inline void JsonRead(JsonReader& r, bool& out)
+{
+    r.ReadBool(out);
+}
+inline void JsonRead(JsonReader& r, f32& out)
+{
+    f64 f = 0;
+    r.ReadFloat(f);
+    out = f32(f);
+}
+inline void JsonRead(JsonReader& r, std::string& out)
+{
+    r.ReadString(out);
+}
+inline void JsonRead(JsonReader& r, std::vector<std::string>& out)
+{
+    out.clear();
+    if (!r.BeginArray())
+        return;
+    while (r.NextElement())
+        r.ReadString(out.emplace_back());
+}
+
+inline void JsonWrite(JsonWriter& w, s32 in)
+{
+    w.Int(in);
+}
+inline void JsonWrite(JsonWriter& w, u64 in)
+{
+    w.UInt(in);
+}
+inline void JsonWrite(JsonWriter& w, bool in)
+{
+    w.Bool(in);
+}
+inline void JsonWrite(JsonWriter& w, f32 in)
+{
+    w.Float(in);
+}
+inline void JsonWrite(JsonWriter& w, const std::string& in)
+{
+    w.String(in);
+}
+inline void JsonWrite(JsonWriter& w, const std::vector<std::string>& in)
+{
+    w.BeginArray();
+    for (const std::string& s : in)
+        w.String(s);
+    w.EndArray();
+}
+
+template <typename M>
+struct JsonMemberTraits;
+template <typename T, typename V>
+struct JsonMemberTraits<V T::*> {
+    using Type = T;
+};
+
+//Field for a member that has JsonRead/JsonWrite overloads
+template <auto Member>
+constexpr JsonField<typename JsonMemberTraits<decltype(Member)>::Type> JsonMember(const char* name)
+{
+    using T = typename JsonMemberTraits<decltype(Member)>::Type;
+    return {
+        name,
+        [](JsonReader& r, T& out)
+        {
+            JsonRead(r, out.*Member);
+        },
+        [](JsonWriter& w, const char* key, const T& in)
+        {
+            w.Key(key);
+            JsonWrite(w, in.*Member);
+        },
+    };
+}
+
+//Unknown keys are skipped, returns false on a syntax error
+template <typename T, size_t N>
+bool JsonReadObject(JsonReader& r, T& out, const JsonField<T> (&fields)[N])
+{
+    if (!r.BeginObject())
+        return false;
+    //files are written in table order so the next field is almost always the one after the last
+    size_t next = 0;
+    std::string_view key;
+    while (r.NextKey(key))
+    {
+        const JsonField<T>* field = nullptr;
+        for (size_t i = 0; i < N && !field; i++)
+        {
+            const JsonField<T>& f = fields[(next + i) % N];
+            if (key == f.name)
+            {
+                field = &f;
+                next = (next + i + 1) % N;
+            }
+        }
+        if (!field)
+            r.Skip();
+        else if (!r.ReadNull())
+            field->read(r, out);
+    }
+    return !r.Failed();
+}
+
+//valid is called on every element read and can fix it up, elements it returns false for are dropped
+template <typename T, size_t N>
+void JsonReadArray(JsonReader& r, std::vector<T>& out, const JsonField<T> (&fields)[N], bool (*valid)(std::type_identity_t<T>& element))
+{
+    out.clear();
+    if (!r.BeginArray())
+        return;
+    while (r.NextElement())
+    {
+        T element;
+        if (r.ReadNull() || !JsonReadObject(r, element, fields))
+            continue;
+        if (valid(element))
+            out.push_back(std::move(element));
+    }
+}
+
+template <typename T, size_t N>
+void JsonWriteObject(JsonWriter& w, const T& in, const JsonField<T> (&fields)[N])
+{
+    w.BeginObject();
+    for (const JsonField<T>& f : fields)
+        f.write(w, f.name, in);
+    w.EndObject();
+}
+
+template <typename T, size_t N>
+void JsonWriteArray(JsonWriter& w, const std::vector<T>& in, const JsonField<T> (&fields)[N])
+{
+    w.BeginArray();
+    for (const T& element : in)
+        JsonWriteObject(w, element, fields);
+    w.EndArray();
+}
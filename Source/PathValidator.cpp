@@ -0,0 +1,149 @@
+#include "PathValidator.h"
+
+#include "SDL.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <thread>
+
+//paths that weren't queried for this long stop being watched
+const u64 pathExpireMilliseconds = 10000;
+
+PathStatus StatPath(const std::string& path)
+{
+    DWORD attributes = GetFileAttributesA(path.c_str());
+    if (attributes == INVALID_FILE_ATTRIBUTES)
+        return PathStatus_Missing;
+    return (attributes & FILE_ATTRIBUTE_DIRECTORY) ? PathStatus_Directory : PathStatus_File;
+}
+
+PathStatus PathValidator::Query(std::string_view path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_synchronous)
+    {
+        auto it = m_entries.find(path);
+        if (it == m_entries.end())
+            it = m_entries.emplace(std::string(path), Entry{ StatPath(std::string(path)) }).first;
+        return it->second.status;
+    }
+    if (!m_started)
+    {
+        m_started = true;
+        m_wakeEvent = CreateEventA(NULL, FALSE, FALSE, NULL);
+        std::thread([this]() { Run(); }).detach();
+    }
+    auto it = m_entries.find(path);
+    if (it == m_entries.end())
+    {
+        it = m_entries.emplace(std::string(path), Entry()).first;
+        m_queue.push_back(it->first);
+        SetEvent(m_wakeEvent);
+    }
+    it->second.lastQueryTicks = SDL_GetTicks64();
+    return it->second.status;
+}
+
+//The directory that gets a change notification when path is created or deleted
+std::string ClosestExistingParent(std::string path)
+{
+    while (true)
+    {
+        size_t slash = path.find_last_of("/\\");
+        if (slash == std::string::npos || slash == 0)
+            return {};
+        path.resize(slash);
+        DWORD attributes = GetFileAttributesA(path.c_str());
+        if (attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY))
+            return path;
+    }
+}
+
+void PathValidator::Run()
+{
+    //WaitForMultipleObjects takes at most 64 handles, one is the wake event
+    const s32 maxWatches = MAXIMUM_WAIT_OBJECTS - 1;
+    std::unordered_map<std::string, HANDLE> watches;
+    std::vector<std::string> queue;
+    std::vector<HANDLE> handles;
+    std::vector<std::string> handleDirectories;
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            queue.insert(queue.end(), m_queue.begin(), m_queue.end());
+            m_queue.clear();
+        }
+        for (const std::string& path : queue)
+        {
+            PathStatus status = StatPath(path);
+            std::string watchDirectory = ClosestExistingParent(path);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(path);
+            if (it == m_entries.end())
+                continue;
+            it->second.status = status;
+            it->second.watchDirectory = watchDirectory;
+        }
+        queue.clear();
+
+        //watch the directories of the paths that are still queried and drop the rest
+        std::unordered_map<std::string, HANDLE> stillWatched;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const u64 now = SDL_GetTicks64();
+            for (auto it = m_entries.begin(); it != m_entries.end();)
+            {
+                if (now - it->second.lastQueryTicks > pathExpireMilliseconds)
+                {
+                    it = m_entries.erase(it);
+                    continue;
+                }
+                const std::string& dir = it->second.watchDirectory;
+                if (dir.size() && !stillWatched.contains(dir) && stillWatched.size() < maxWatches)
+                {
+                    auto watch = watches.find(dir);
+                    if (watch != watches.end())
+                    {
+                        stillWatched[dir] = watch->second;
+                        watches.erase(watch);
+                    }
+                    else
+                    {
+                        HANDLE handle = FindFirstChangeNotificationA(dir.c_str(), FALSE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME);
+                        if (handle != INVALID_HANDLE_VALUE)
+                            stillWatched[dir] = handle;
+                    }
+                }
+                it++;
+            }
+        }
+        for (const auto& [dir, handle] : watches)
+            FindCloseChangeNotification(handle);
+        watches.swap(stillWatched);
+
+        handles.clear();
+        handleDirectories.clear();
+        handles.push_back(m_wakeEvent);
+        for (const auto& [dir, handle] : watches)
+        {
+            handles.push_back(handle);
+            handleDirectories.push_back(dir);
+        }
+        //wakes up once in a while to let unused paths expire
+        DWORD result = WaitForMultipleObjects(DWORD(handles.size()), handles.data(), FALSE, DWORD(pathExpireMilliseconds));
+        if (result <= WAIT_OBJECT_0 || result >= WAIT_OBJECT_0 + handles.size())
+            continue;
+
+        const std::string& changed = handleDirectories[result - WAIT_OBJECT_0 - 1];
+        FindNextChangeNotification(handles[result - WAIT_OBJECT_0]);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& [path, entry] : m_entries)
+        {
+            //the old status stays until the new one is known so the UI doesn't flicker
+            if (entry.watchDirectory == changed)
+                queue.push_back(path);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Math.h"
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+enum PathStatus : s32 {
+    PathStatus_Pending, //not checked yet
+    PathStatus_File,
+    PathStatus_Directory,
+    PathStatus_Missing,
+};
+
+//NOTE(CSH): the UI asks for the status of paths every frame without touching the file system,
+//a worker thread stats them and watches the directory of every path so a status is checked
+//again when something in that directory is created, deleted or renamed
+struct PathValidator {
+    struct Entry {
+        PathStatus status = PathStatus_Pending;
+        std::string watchDirectory; //closest existing parent that is watched
+        u64 lastQueryTicks = 0;
+    };
+    //transparent so a path built in the frame arena is looked up without a std::string
+    struct PathHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+    };
+    std::unordered_map<std::string, Entry, PathHash, std::equal_to<>> m_entries;
+    std::vector<std::string> m_queue;
+    std::mutex m_mutex;
+    void* m_wakeEvent = nullptr;
+    bool m_started = false;
+    //stats new paths on the calling thread and never watches them, so replays and benchmarks see the same status every run
+    bool m_synchronous = false;
+
+    static PathValidator& GetInstance()
+    {
+        static PathValidator instance;
+        return instance;
+    }
+    //Returns the last known status, a path that was never queried is Pending for a few frames
+    PathStatus Query(std::string_view path);
+    void Run();
+};
@@ -0,0 +1,76 @@
+#include "PatternMatcher.h"
+
+#include <algorithm>
+
+void PatternMatcher::Build(const std::vector<std::string>& patterns)
+{
+    m_next.assign(256, -1);
+    m_outputs.clear();
+    m_outputs.emplace_back();
+
+    for (s32 i = 0; i < patterns.size(); i++)
+    {
+        if (patterns[i].empty())
+            continue;
+        s32 node = 0;
+        for (char c : patterns[i])
+        {
+            size_t index = size_t(node) * 256 + u8(c);
+            if (m_next[index] == -1)
+            {
+                m_next[index] = s32(m_outputs.size());
+                m_outputs.emplace_back();
+                m_next.resize(m_next.size() + 256, -1);
+            }
+            node = m_next[index];
+        }
+        m_outputs[node].push_back(i);
+    }
+
+    //breadth first so the suffix of a node is always finished before the node itself
+    std::vector<s32> fail(m_outputs.size(), 0);
+    std::vector<s32> queue;
+    queue.reserve(m_outputs.size());
+    for (s32 c = 0; c < 256; c++)
+    {
+        s32& child = m_next[c];
+        if (child == -1)
+            child = 0;
+        else
+            queue.push_back(child);
+    }
+    for (s32 i = 0; i < queue.size(); i++)
+    {
+        s32 node = queue[i];
+        for (s32 c = 0; c < 256; c++)
+        {
+            s32 fallback = m_next[size_t(fail[node]) * 256 + c];
+            s32& child = m_next[size_t(node) * 256 + c];
+            if (child == -1)
+            {
+                child = fallback;
+                continue;
+            }
+            fail[child] = fallback;
+            const std::vector<s32>& inherited = m_outputs[fallback];
+            m_outputs[child].insert(m_outputs[child].end(), inherited.begin(), inherited.end());
+            queue.push_back(child);
+        }
+    }
+}
+
+void PatternMatcher::Match(std::string_view text, std::vector<s32>& found) const
+{
+    if (Empty())
+        return;
+    size_t start = found.size();
+    s32 node = 0;
+    for (char c : text)
+    {
+        node = m_next[size_t(node) * 256 + u8(c)];
+        const std::vector<s32>& outputs = m_outputs[node];
+        found.insert(found.end(), outputs.begin(), outputs.end());
+    }
+    std::sort(found.begin() + start, found.end());
+    found.erase(std::unique(found.begin() + start, found.end()), found.end());
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "Math.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+//NOTE(CSH): Aho-Corasick automaton with the full 256 entry transition table per node,
+//every pattern is found with a single pass over the text no matter how many patterns there are
+struct PatternMatcher {
+    std::vector<s32> m_next; //node * 256 + byte -> node
+    std::vector<std::vector<s32>> m_outputs; //patterns that end at the node, including through its suffixes
+
+    void Build(const std::vector<std::string>& patterns);
+    bool Empty() const
+    {
+        return m_outputs.size() <= 1;
+    }
+    //Adds the index of every pattern contained in text once
+    void Match(std::string_view text, std::vector<s32>& found) const;
+};
@@ -0,0 +1,170 @@
+#include "Prefetch.h"
+#include "FileSystem.h"
+#include "Fingerprint.h"
+#include "ArtifactCache.h"
+
+#include "SDL.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <algorithm>
+#include <thread>
+
+const u64 prefetchBatchBytes = 256ull * 1024 * 1024;
+const s32 prefetchBatchFiles = 256;
+const s32 prefetchThreads = 4;
+
+struct PrefetchBatch {
+    s32 first = 0;
+    s32 count = 0;
+};
+
+//Reads one byte of every page, false when a read failed (a network drive dropped etc.) which
+//shows up as an in-page exception instead of an error code. No C++ objects in here because of __try
+bool TouchPages(const volatile u8* data, u64 size)
+{
+    __try
+    {
+        u8 sum = 0;
+        for (u64 offset = 0; offset < size; offset += 4096)
+            sum += data[offset];
+        (void)sum;
+    }
+    __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH)
+    {
+        return false;
+    }
+    return true;
+}
+
+//Maps the files, asks the memory manager to read all of them in one go and
+//then waits for the reads by touching every page
+u64 PrefetchFiles(const FileEntry* files, s32 count)
+{
+    struct MappedFile {
+        HANDLE file;
+        HANDLE mapping;
+        void* view;
+        u64 size;
+    };
+    std::vector<MappedFile> mapped;
+    std::vector<WIN32_MEMORY_RANGE_ENTRY> ranges;
+    mapped.reserve(count);
+    ranges.reserve(count);
+    for (s32 i = 0; i < count; i++)
+    {
+        HANDLE file = CreateFileA(files[i].path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            continue;
+        //the file can have changed since the scan, the view and the reads stay inside what is there now
+        LARGE_INTEGER fileSize = {};
+        u64 size = GetFileSizeEx(file, &fileSize) ? Min<u64>(u64(fileSize.QuadPart), files[i].size) : 0;
+        if (size == 0)
+        {
+            CloseHandle(file);
+            continue;
+        }
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, SIZE_T(size)) : nullptr;
+        if (!view)
+        {
+            if (mapping)
+                CloseHandle(mapping);
+            CloseHandle(file);
+            continue;
+        }
+        mapped.push_back({ file, mapping, view, size });
+        ranges.push_back({ view, SIZE_T(size) });
+    }
+
+    u64 bytes = 0;
+    if (ranges.size())
+        PrefetchVirtualMemory(GetCurrentProcess(), ranges.size(), ranges.data(), 0);
+    for (const MappedFile& m : mapped)
+    {
+        if (TouchPages((const volatile u8*)m.view, m.size))
+            bytes += m.size;
+        UnmapViewOfFile(m.view);
+        CloseHandle(m.mapping);
+        CloseHandle(m.file);
+    }
+    return bytes;
+}
+
+//The thread outlives the job, once the build is over or cancelled the reads only compete with whatever runs next
+bool PrefetchStillWanted(const BuildRun& run)
+{
+    return !run.cancelled && run.state == BuildState_Running;
+}
+
+void PrefetchContent(const std::shared_ptr<BuildRun>& run)
+{
+    u64 startTicks = SDL_GetTicks64();
+    run->prefetchState = PrefetchState_Running;
+    DEFER
+    {
+        run->prefetchMilliseconds = SDL_GetTicks64() - startTicks;
+        run->prefetchState = PrefetchState_Finished;
+    };
+
+    std::vector<FileEntry> files;
+    if (!PrefetchStillWanted(*run))
+        return;
+    ScanFiles(ProjectDirectory(run->request.projectPath) + "Content", files);
+    ScanFiles(run->request.rootPath + "Engine/Content", files);
+    std::erase_if(files, [](const FileEntry& file)
+        {
+            return file.size == 0;
+        });
+    //largest first, those are the ones the cook would otherwise be waiting on the longest
+    std::sort(files.begin(), files.end(), [](const FileEntry& a, const FileEntry& b)
+        {
+            return a.size > b.size;
+        });
+
+    //don't push the compiler out of memory to fill the cache
+    MEMORYSTATUSEX memory = {};
+    memory.dwLength = sizeof(memory);
+    u64 budget = GlobalMemoryStatusEx(&memory) ? memory.ullAvailPhys / 2 : 0;
+    u64 totalBytes = 0;
+    std::erase_if(files, [&](const FileEntry& file)
+        {
+            if (totalBytes + file.size > budget)
+                return true;
+            totalBytes += file.size;
+            return false;
+        });
+    run->prefetchTotalBytes = totalBytes;
+
+    std::vector<PrefetchBatch> batches;
+    u64 batchBytes = 0;
+    for (s32 i = 0; i < files.size(); i++)
+    {
+        if (batches.empty() || batchBytes >= prefetchBatchBytes || batches.back().count >= prefetchBatchFiles)
+        {
+            batches.push_back({ i, 0 });
+            batchBytes = 0;
+        }
+        batches.back().count++;
+        batchBytes += files[i].size;
+    }
+
+    ParallelFor(s32(batches.size()), [&](s32 i)
+        {
+            if (!PrefetchStillWanted(*run))
+                return;
+            //background mode also lowers the IO priority so UAT's own reads go first
+            SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+            run->prefetchBytes += PrefetchFiles(&files[batches[i].first], batches[i].count);
+            SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+        }, prefetchThreads);
+}
+
+void PrefetchContentJob::RunJob()
+{
+    if (run->artifactState == ArtifactState_Restored)
+        return;
+    std::thread(PrefetchContent, run).detach();
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "Math.h"
+#include "BuildQueue.h"
+
+#include <memory>
+
+enum PrefetchState : s32 {
+    PrefetchState_None,
+    PrefetchState_Running,
+    PrefetchState_Finished,
+};
+
+//NOTE(CSH): reads the project and engine Content into the file cache on a background thread
+//while UAT compiles so the cook doesn't have to wait on the disk. The job itself returns right away
+struct PrefetchContentJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    virtual void RunJob() override;
+};
+
+void PrefetchContent(const std::shared_ptr<BuildRun>& run);
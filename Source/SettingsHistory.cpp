@@ -0,0 +1,175 @@
+#include "SettingsHistory.h"
+
+template <typename T>
+std::shared_ptr<const T> Share(const T& value, const std::shared_ptr<const T>* previous)
+{
+    if (previous && *previous && **previous == value)
+        return *previous;
+    return std::make_shared<const T>(value);
+}
+
+SettingsSnapshot TakeSettingsSnapshot(const Settings& settings, const SettingsSnapshot* previous)
+{
+    SettingsSnapshot result;
+    result.version = settings.version;
+    result.platformSelection = settings.platformSelection;
+    result.uatProcess = settings.uatProcess;
+    result.rootPath         = Share(settings.rootPath,          previous ? &previous->rootPath : nullptr);
+    result.projectPath      = Share(settings.projectPath,       previous ? &previous->projectPath : nullptr);
+    result.versionOptions   = Share(settings.versionOptions,    previous ? &previous->versionOptions : nullptr);
+    result.switchOptions    = Share(settings.switchOptions,     previous ? &previous->switchOptions : nullptr);
+    result.preBuildEvents   = Share(settings.preBuildEvents,    previous ? &previous->preBuildEvents : nullptr);
+    result.postBuildEvents  = Share(settings.postBuildEvents,   previous ? &previous->postBuildEvents : nullptr);
+    result.fatalPatterns    = Share(settings.fatalPatterns,     previous ? &previous->fatalPatterns : nullptr);
+    result.platformOptions.reserve(settings.platformOptions.size());
+    for (size_t i = 0; i < settings.platformOptions.size(); i++)
+    {
+        bool hasPrevious = previous && i < previous->platformOptions.size();
+        result.platformOptions.push_back(Share(settings.platformOptions[i], hasPrevious ? &previous->platformOptions[i] : nullptr));
+    }
+    return result;
+}
+
+template <typename T>
+void Restore(const std::shared_ptr<const T>& chunk, T& value)
+{
+    if (!(value == *chunk))
+        value = *chunk;
+}
+
+void RestoreSettingsSnapshot(const SettingsSnapshot& snapshot, Settings& settings)
+{
+    settings.version = snapshot.version;
+    settings.platformSelection = snapshot.platformSelection;
+    settings.uatProcess = snapshot.uatProcess;
+    Restore(snapshot.rootPath,          settings.rootPath);
+    Restore(snapshot.projectPath,       settings.projectPath);
+    Restore(snapshot.versionOptions,    settings.versionOptions);
+    Restore(snapshot.switchOptions,     settings.switchOptions);
+    Restore(snapshot.preBuildEvents,    settings.preBuildEvents);
+    Restore(snapshot.postBuildEvents,   settings.postBuildEvents);
+    Restore(snapshot.fatalPatterns,     settings.fatalPatterns);
+    settings.platformOptions.resize(snapshot.platformOptions.size());
+    for (size_t i = 0; i < snapshot.platformOptions.size(); i++)
+        Restore(snapshot.platformOptions[i], settings.platformOptions[i]);
+}
+
+bool SettingsMatchSnapshot(const Settings& settings, const SettingsSnapshot& snapshot)
+{
+    if (settings.version != snapshot.version ||
+        settings.platformSelection != snapshot.platformSelection ||
+        settings.uatProcess != snapshot.uatProcess ||
+        settings.rootPath != *snapshot.rootPath ||
+        settings.projectPath != *snapshot.projectPath ||
+        settings.versionOptions != *snapshot.versionOptions ||
+        settings.switchOptions != *snapshot.switchOptions ||
+        settings.preBuildEvents != *snapshot.preBuildEvents ||
+        settings.postBuildEvents != *snapshot.postBuildEvents ||
+        settings.fatalPatterns != *snapshot.fatalPatterns ||
+        settings.platformOptions.size() != snapshot.platformOptions.size())
+        return false;
+    for (size_t i = 0; i < settings.platformOptions.size(); i++)
+    {
+        if (!(settings.platformOptions[i] == *snapshot.platformOptions[i]))
+            return false;
+    }
+    return true;
+}
+
+SettingsHistory::SettingsHistory()
+{
+    m_undo.push_back(TakeSettingsSnapshot(Settings(), nullptr));
+    m_saved = m_undo.back();
+}
+
+void SettingsHistory::Loaded(const std::string& configFile, const Settings& settings, bool fromFile)
+{
+    SettingsSnapshot snapshot = TakeSettingsSnapshot(settings, &m_undo.back());
+    if (m_reloadAfterSave)
+    {
+        //same content as the save, the ids of the build events are new
+        m_undo.back() = snapshot;
+    }
+    else if (configFile != m_configFile)
+    {
+        m_undo.clear();
+        m_redo.clear();
+        m_undo.push_back(snapshot);
+    }
+    else if (!SettingsMatchSnapshot(settings, m_undo.back()))
+    {
+        //reloading the file throws away the edits, that can be undone as well
+        m_undo.push_back(snapshot);
+        m_redo.clear();
+    }
+    m_configFile = configFile;
+    m_reloadAfterSave = false;
+    m_saved = fromFile ? m_undo.back() : TakeSettingsSnapshot(Settings(), nullptr);
+}
+
+void SettingsHistory::Saved(const Settings& settings)
+{
+    Record(settings);
+    m_saved = m_undo.back();
+    m_reloadAfterSave = true;
+}
+
+bool SettingsHistory::IsSaved(const Settings& settings) const
+{
+    return SettingsMatchSnapshot(settings, m_saved);
+}
+
+void SettingsHistory::Update(const Settings& settings, bool editing)
+{
+    //comparing every frame would walk all of the options, edits only happen through an active item
+    if (editing)
+    {
+        m_wasEditing = true;
+        return;
+    }
+    if (!m_wasEditing)
+        return;
+    m_wasEditing = false;
+    Record(settings);
+}
+
+void SettingsHistory::Record(const Settings& settings)
+{
+    if (SettingsMatchSnapshot(settings, m_undo.back()))
+        return;
+    m_undo.push_back(TakeSettingsSnapshot(settings, &m_undo.back()));
+    m_redo.clear();
+}
+
+bool SettingsHistory::CanUndo() const
+{
+    return m_undo.size() > 1;
+}
+
+bool SettingsHistory::CanRedo() const
+{
+    return !m_redo.empty();
+}
+
+bool SettingsHistory::Undo(Settings& settings)
+{
+    //an edit that wasn't recorded yet is the step that gets undone
+    Record(settings);
+    if (!CanUndo())
+        return false;
+    m_redo.push_back(std::move(m_undo.back()));
+    m_undo.pop_back();
+    RestoreSettingsSnapshot(m_undo.back(), settings);
+    return true;
+}
+
+bool SettingsHistory::Redo(Settings& settings)
+{
+    Record(settings);
+    if (!CanRedo())
+        return false;
+    m_undo.push_back(std::move(m_redo.back()));
+    m_redo.pop_back();
+    RestoreSettingsSnapshot(m_undo.back(), settings);
+    return true;
+}
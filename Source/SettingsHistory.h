@@ -0,0 +1,59 @@
+#pragma once
+#include "Math.h"
+#include "Config.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+//NOTE(CSH): immutable copy of a Settings where every field (and every platform) is its own shared chunk.
+//A snapshot taken after an edit shares the chunks that didn't change with the snapshot before it
+//so the undo steps and the last saved state only cost the fields that were edited
+struct SettingsSnapshot {
+    s32 version = 0;
+    s32 platformSelection = 0;
+    ProcessSettings uatProcess;
+    std::shared_ptr<const std::string> rootPath;
+    std::shared_ptr<const std::string> projectPath;
+    std::shared_ptr<const std::vector<std::string>> versionOptions;
+    std::shared_ptr<const std::vector<std::string>> switchOptions;
+    std::shared_ptr<const BuildEvents> preBuildEvents;
+    std::shared_ptr<const BuildEvents> postBuildEvents;
+    std::vector<std::shared_ptr<const PlatformSettings>> platformOptions;
+    std::shared_ptr<const std::vector<FatalLogPattern>> fatalPatterns;
+};
+
+SettingsSnapshot TakeSettingsSnapshot(const Settings& settings, const SettingsSnapshot* previous);
+//Only the fields that differ are copied
+void RestoreSettingsSnapshot(const SettingsSnapshot& snapshot, Settings& settings);
+bool SettingsMatchSnapshot(const Settings& settings, const SettingsSnapshot& snapshot);
+
+//Undo/redo of the config edits and the state it was last loaded or saved in.
+//The UI edits Settings directly so an undo step is recorded once no item is active anymore,
+//a drag or typing into a field is one step. Only used from the main thread
+struct SettingsHistory {
+    std::vector<SettingsSnapshot> m_undo; //back is the current state
+    std::vector<SettingsSnapshot> m_redo;
+    SettingsSnapshot m_saved;
+    std::string m_configFile;
+    bool m_reloadAfterSave = false;
+    bool m_wasEditing = false;
+
+    static SettingsHistory& GetInstance()
+    {
+        static SettingsHistory instance;
+        return instance;
+    }
+    SettingsHistory();
+    //A different config starts a new history, the reload after a save keeps it
+    void Loaded(const std::string& configFile, const Settings& settings, bool fromFile);
+    void Saved(const Settings& settings);
+    bool IsSaved(const Settings& settings) const;
+    //Call once per frame after the UI
+    void Update(const Settings& settings, bool editing);
+    void Record(const Settings& settings);
+    bool CanUndo() const;
+    bool CanRedo() const;
+    bool Undo(Settings& settings);
+    bool Redo(Settings& settings);
+};
@@ -0,0 +1,177 @@
+#include "SizeAnalytics.h"
+#include "FileSystem.h"
+#include "Fingerprint.h"
+#include "ArtifactCache.h"
+
+#include "SDL.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+void SortedSizeEntries(const std::unordered_map<std::string, u64>& totals, std::vector<SizeEntry>& out)
+{
+    out.clear();
+    out.reserve(totals.size());
+    for (const auto& [name, bytes] : totals)
+        out.push_back({ name, bytes });
+    std::sort(out.begin(), out.end(), [](const SizeEntry& a, const SizeEntry& b)
+        {
+            return a.bytes > b.bytes;
+        });
+}
+
+bool MeasureOutputSize(const std::string& dir, const std::vector<std::string>& subDirectories, SizeReport& report)
+{
+    std::vector<FileEntry> files;
+    for (const std::string& subDirectory : subDirectories)
+        ScanFiles(dir + '/' + subDirectory, files);
+    if (files.empty())
+        return false;
+
+    std::unordered_map<std::string, u64> directories;
+    std::unordered_map<std::string, u64> extensions;
+    report.totalBytes = 0;
+    for (const FileEntry& file : files)
+    {
+        report.totalBytes += file.size;
+        std::string_view relativePath = std::string_view(file.path).substr(dir.size() + 1);
+        size_t fileStart = relativePath.find_last_of('/');
+
+        size_t end = 0;
+        for (s32 depth = 0; depth < sizeReportDirectoryDepth && end != fileStart; depth++)
+            end = relativePath.find('/', end + 1);
+        if (fileStart == std::string_view::npos)
+            directories["."] += file.size;
+        else
+            directories[std::string(relativePath.substr(0, end))] += file.size;
+
+        std::string_view name = fileStart == std::string_view::npos ? relativePath : relativePath.substr(fileStart + 1);
+        size_t dot = name.find_last_of('.');
+        std::string extension = dot == std::string_view::npos ? std::string() : std::string(name.substr(dot));
+        for (char& c : extension)
+            c = (char)tolower(c);
+        extensions[extension.size() ? extension : "(none)"] += file.size;
+    }
+    SortedSizeEntries(directories, report.directories);
+    SortedSizeEntries(extensions, report.extensions);
+    return true;
+}
+
+float GrowthPercent(u64 before, u64 after)
+{
+    if (before == 0)
+        return 0.0f;
+    return 100.0f * (float(after) - float(before)) / float(before);
+}
+
+const SizeEntry* FindSizeEntry(const std::vector<SizeEntry>& entries, const std::string& name)
+{
+    for (const SizeEntry& entry : entries)
+    {
+        if (entry.name == name)
+            return &entry;
+    }
+    return nullptr;
+}
+
+void SizeHistory::Load()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_loaded)
+        return;
+    m_loaded = true;
+    LoadSizeHistory(m_reports);
+    if (m_reports.size())
+        m_lastKey = m_reports.back().key;
+}
+
+void SizeHistory::Add(const SizeReport& report)
+{
+    Load();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_reports.push_back(report);
+    m_lastKey = report.key;
+    s32 count = 0;
+    for (s32 i = s32(m_reports.size()) - 1; i >= 0; i--)
+    {
+        if (m_reports[i].key == report.key && ++count > sizeReportsPerKey)
+            m_reports.erase(m_reports.begin() + i);
+    }
+    SaveSizeHistory(m_reports);
+}
+
+std::vector<std::string> SizeHistory::Keys()
+{
+    Load();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> keys;
+    for (const SizeReport& report : m_reports)
+    {
+        if (std::find(keys.begin(), keys.end(), report.key) == keys.end())
+            keys.push_back(report.key);
+    }
+    return keys;
+}
+
+std::string SizeHistory::LastKey()
+{
+    Load();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastKey;
+}
+
+s32 SizeHistory::GetLatest(const std::string& key, SizeReport& latest, SizeReport& previous)
+{
+    Load();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    s32 found = 0;
+    for (s32 i = s32(m_reports.size()) - 1; i >= 0 && found < 2; i--)
+    {
+        if (m_reports[i].key != key)
+            continue;
+        if (found++ == 0)
+            latest = m_reports[i];
+        else
+            previous = m_reports[i];
+    }
+    return found;
+}
+
+bool SizeHistory::TakeGrowthWarning(std::string& key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_grewKey.empty())
+        return false;
+    key = m_grewKey;
+    m_grewKey.clear();
+    return true;
+}
+
+void SizeReportJob::RunJob()
+{
+    SizeReport report;
+    report.key = FingerprintKey(run->request);
+    report.time = CurrentFileTime();
+    //NOTE(CSH): only the platforms this run staged (or restored), the staging directory
+    //also holds whatever other builds staged there
+    const std::string outputDirectory = ArtifactOutputDirectory(run->request);
+    std::vector<std::string> staged;
+    ChangedSubDirectories(outputDirectory, run->stagedSnapshot, staged);
+    if (!MeasureOutputSize(outputDirectory, staged, report))
+        return;
+
+    SizeHistory& history = SizeHistory::GetInstance();
+    SizeReport previous, beforePrevious;
+    bool hasPrevious = history.GetLatest(report.key, previous, beforePrevious) > 0;
+    history.Add(report);
+
+    if (!hasPrevious || run->sizeGrowthWarningPercent <= 0)
+        return;
+    float growth = GrowthPercent(previous.totalBytes, report.totalBytes);
+    if (growth > run->sizeGrowthWarningPercent)
+    {
+        SDL_Log("Staged size of %s grew %.1f%% to %llu MB", report.key.c_str(), growth, report.totalBytes / (1024 * 1024));
+        std::lock_guard<std::mutex> lock(history.m_mutex);
+        history.m_grewKey = report.key;
+    }
+}
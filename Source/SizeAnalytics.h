@@ -0,0 +1,50 @@
+#pragma once
+#include "Math.h"
+#include "Config.h"
+#include "BuildQueue.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//Files deeper than this are counted in their parent directory at this depth
+const s32 sizeReportDirectoryDepth = 4;
+const s32 sizeReportsPerKey = 20;
+
+//Adds up the bytes of every file in the given sub directories of dir per directory and per extension,
+//directories are named relative to dir
+bool MeasureOutputSize(const std::string& dir, const std::vector<std::string>& subDirectories, SizeReport& report);
+//Percent change from before to after, 0 if there is no before
+float GrowthPercent(u64 before, u64 after);
+const SizeEntry* FindSizeEntry(const std::vector<SizeEntry>& entries, const std::string& name);
+
+//NOTE(CSH): every successful staged build adds a report, the UI reads them from the main thread
+struct SizeHistory {
+    std::vector<SizeReport> m_reports; //oldest first
+    std::mutex m_mutex;
+    bool m_loaded = false;
+    std::string m_grewKey; //key of the last build that grew past the warning, cleared by TakeGrowthWarning
+    std::string m_lastKey;
+
+    static SizeHistory& GetInstance()
+    {
+        static SizeHistory instance;
+        return instance;
+    }
+    void Load();
+    void Add(const SizeReport& report);
+    std::vector<std::string> Keys();
+    std::string LastKey();
+    //returns the number of reports found, latest is the newest and previous the one before it
+    s32 GetLatest(const std::string& key, SizeReport& latest, SizeReport& previous);
+    //returns true once for every build that grew past the warning
+    bool TakeGrowthWarning(std::string& key);
+};
+
+struct SizeReportJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    virtual void RunJob() override;
+};
@@ -0,0 +1,159 @@
+#include "StringTable.h"
+#include "Hash.h"
+
+#include <algorithm>
+#include <cstring>
+
+const u64 stringChunkSize = 64 * 1024;
+
+StringTable::StringTable()
+{
+    m_entries.push_back({ "", 0, Hash64("", 0) });
+    m_slots.resize(1024);
+}
+
+u64 StringTable::FindSlot(std::string_view s, u64 hash) const
+{
+    u64 mask = m_slots.size() - 1;
+    u64 slot = hash & mask;
+    while (true)
+    {
+        StringHandle handle = m_slots[slot];
+        if (handle == 0)
+            return slot;
+        const Entry& e = m_entries[handle];
+        if (e.hash == hash && e.size == s.size() && memcmp(e.data, s.data(), s.size()) == 0)
+            return slot;
+        slot = (slot + 1) & mask;
+    }
+}
+
+const char* StringTable::Store(std::string_view s)
+{
+    u64 size = s.size() + 1;
+    char* dest;
+    if (size > stringChunkSize / 4)
+    {
+        //big strings get their own allocation so they don't waste the rest of a chunk
+        m_chunks.insert(m_chunks.begin(), std::make_unique<char[]>(size));
+        dest = m_chunks.front().get();
+    }
+    else
+    {
+        if (m_chunks.empty() || m_chunkUsed + size > m_chunkSize)
+        {
+            m_chunks.push_back(std::make_unique<char[]>(stringChunkSize));
+            m_chunkSize = stringChunkSize;
+            m_chunkUsed = 0;
+        }
+        dest = m_chunks.back().get() + m_chunkUsed;
+        m_chunkUsed += size;
+    }
+    memcpy(dest, s.data(), s.size());
+    dest[s.size()] = 0;
+    m_bytes += size;
+    return dest;
+}
+
+void StringTable::Grow()
+{
+    std::vector<StringHandle> old = std::move(m_slots);
+    m_slots.assign(old.size() * 2, 0);
+    u64 mask = m_slots.size() - 1;
+    for (StringHandle handle : old)
+    {
+        if (handle == 0)
+            continue;
+        u64 slot = m_entries[handle].hash & mask;
+        while (m_slots[slot])
+            slot = (slot + 1) & mask;
+        m_slots[slot] = handle;
+    }
+}
+
+StringHandle StringTable::Intern(std::string_view s)
+{
+    if (s.empty())
+        return 0;
+    u64 hash = Hash64(s.data(), s.size());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    u64 slot = FindSlot(s, hash);
+    if (m_slots[slot])
+        return m_slots[slot];
+
+    //keeping the table at most half full keeps the probes short
+    if ((m_entries.size() + 1) * 2 > m_slots.size())
+    {
+        Grow();
+        slot = FindSlot(s, hash);
+    }
+    StringHandle handle = StringHandle(m_entries.size());
+    m_entries.push_back({ Store(s), u32(s.size()), hash });
+    m_slots[slot] = handle;
+    return handle;
+}
+
+StringHandle StringTable::Find(std::string_view s) const
+{
+    if (s.empty())
+        return 0;
+    u64 hash = Hash64(s.data(), s.size());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slots[FindSlot(s, hash)];
+}
+
+std::string_view StringTable::View(StringHandle handle) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (handle >= m_entries.size())
+        return {};
+    const Entry& e = m_entries[handle];
+    return std::string_view(e.data, e.size);
+}
+
+const char* StringTable::CString(StringHandle handle) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (handle >= m_entries.size())
+        return "";
+    return m_entries[handle].data;
+}
+
+u64 StringTable::Hash(StringHandle handle) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (handle >= m_entries.size())
+        return m_entries[0].hash;
+    return m_entries[handle].hash;
+}
+
+u64 StringTable::Count() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+u64 StringTable::Bytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytes;
+}
+
+const char* InternLabel(std::string_view a, std::string_view b, std::string_view c)
+{
+    //labels are short, only the long ones need a heap string to be put together
+    char buffer[256];
+    u64 size = a.size() + b.size() + c.size();
+    std::unique_ptr<char[]> large;
+    char* dest = buffer;
+    if (size > sizeof(buffer))
+    {
+        large = std::make_unique<char[]>(size);
+        dest = large.get();
+    }
+    char* at = std::copy(a.begin(), a.end(), dest);
+    at = std::copy(b.begin(), b.end(), at);
+    std::copy(c.begin(), c.end(), at);
+    StringTable& table = StringTable::GetInstance();
+    return table.CString(table.Intern(std::string_view(dest, size)));
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "Math.h"
+
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+//NOTE(CSH): 0 is always the empty string
+typedef u32 StringHandle;
+
+//NOTE(CSH): one copy of every option, event and platform name across all of the configs that were loaded.
+//Handles stay valid until the app closes so names compare as integers, and the hash is only computed once.
+//The characters live in large chunks that are never freed or moved, a view is valid for the lifetime of the app
+struct StringTable {
+    struct Entry {
+        const char* data;
+        u32 size;
+        u64 hash;
+    };
+    std::vector<std::unique_ptr<char[]>> m_chunks;
+    u64 m_chunkUsed = 0;
+    u64 m_chunkSize = 0;
+    std::vector<Entry> m_entries;
+    std::vector<StringHandle> m_slots; //open addressing into m_entries, 0 = empty slot
+    u64 m_bytes = 0;
+    mutable std::mutex m_mutex;
+
+    static StringTable& GetInstance()
+    {
+        static StringTable instance;
+        return instance;
+    }
+    StringTable();
+    StringHandle Intern(std::string_view s);
+    //Doesn't add the string, 0 if it was never interned
+    StringHandle Find(std::string_view s) const;
+    std::string_view View(StringHandle handle) const;
+    //null terminated
+    const char* CString(StringHandle handle) const;
+    u64 Hash(StringHandle handle) const;
+    u64 Count() const;
+    u64 Bytes() const;
+
+private:
+    u64 FindSlot(std::string_view s, u64 hash) const;
+    const char* Store(std::string_view s);
+    void Grow();
+};
+
+inline StringHandle Intern(std::string_view s)
+{
+    return StringTable::GetInstance().Intern(s);
+}
+inline std::string_view InternedView(StringHandle handle)
+{
+    return StringTable::GetInstance().View(handle);
+}
+
+//A label like "Add##Platform" that is built the same every frame.
+//Returns a pointer that stays valid instead of allocating a new string each frame
+const char* InternLabel(std::string_view a, std::string_view b, std::string_view c = {});
@@ -67,7 +67,8 @@ s32 Threading::ThreadFunction(void* data)
         if (job == nullptr)
             continue;
 
-        job->RunJob();
+        if (!job->cancelled || !*job->cancelled)
+            job->RunJob();
 
         MT.m_jobsInFlight--;
         delete job;
@@ -80,3 +81,23 @@ bool OnMainThread()
 {
     return mainThreadID == std::this_thread::get_id();
 }
+
+void ParallelFor(s32 count, const std::function<void(s32 index)>& func, s32 maxThreads)
+{
+    if (count <= 0)
+        return;
+    std::atomic<s32> next = 0;
+    auto worker = [&]()
+    {
+        for (s32 i = next++; i < count; i = next++)
+            func(i);
+    };
+    s32 threadCount = Min<s32>(maxThreads > 0 ? maxThreads : SDL_GetCPUCount(), count) - 1;
+    std::vector<std::thread> threads;
+    threads.reserve(Max(threadCount, 0));
+    for (s32 i = 0; i < threadCount; i++)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (std::thread& thread : threads)
+        thread.join();
+}
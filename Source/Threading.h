@@ -2,6 +2,8 @@
 #include "Math.h"
 
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <semaphore>
 #include <thread>
@@ -9,7 +11,10 @@
 
 struct Job
 {
+    virtual ~Job() = default;
     virtual void RunJob() = 0;
+    //set for the jobs of a build, the worker skips them once it is true
+    std::shared_ptr<const std::atomic<bool>> cancelled;
 };
 
 struct Threading {
@@ -38,6 +43,12 @@ public:
     {
         return m_jobsInFlight;
     }
+    //true when nothing is queued and nothing is being ran (or cleared)
+    bool IsIdle()
+    {
+        std::lock_guard<std::mutex> lock(m_jobVectorMutex);
+        return m_jobs.empty() && m_jobsInFlight == 0;
+    }
     void ClearJobs()
     {
         while (true)
@@ -55,4 +66,7 @@ public:
 	void SubmitJob(Job* job);
 };
 
-bool OnMainThread();
\ No newline at end of file
+bool OnMainThread();
+//Runs func for every index in [0, count) on all cores (or maxThreads) and returns once every call finished,
+//meant for jobs that need to go wide for a moment (hashing, scanning directories, etc.)
+void ParallelFor(s32 count, const std::function<void(s32 index)>& func, s32 maxThreads = 0);
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include "UATLog.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+const char* uatPhaseNames[UATPhase_Count] = {
+    "Build",
+    "Cook",
+    "Stage",
+    "Package",
+    "Archive",
+    "Deploy",
+    "Run",
+};
+
+//Phase names as UAT prints them in the start/complete markers
+const char* uatPhaseMarkers[UATPhase_Count] = {
+    "BUILD",
+    "COOK",
+    "STAGE",
+    "PACKAGE",
+    "ARCHIVE",
+    "DEPLOY",
+    "RUN",
+};
+
+void UATPhaseTracker::ParseLine(std::string_view line)
+{
+    const std::string_view stars = "********** ";
+    size_t start = line.find(stars);
+    if (start == std::string_view::npos)
+        return;
+    std::string_view marker = line.substr(start + stars.size());
+    size_t commandPos = marker.find(" COMMAND ");
+    if (commandPos == std::string_view::npos)
+        return;
+    std::string_view phaseName = marker.substr(0, commandPos);
+    std::string_view status = marker.substr(commandPos + 9);
+
+    for (s32 i = 0; i < UATPhase_Count; i++)
+    {
+        if (phaseName != uatPhaseMarkers[i])
+            continue;
+        if (status.starts_with("STARTED"))
+        {
+            started |= 1 << i;
+            current = i;
+        }
+        else if (status.starts_with("COMPLETED"))
+        {
+            completed |= 1 << i;
+            if (current == i)
+                current = UATPhase_None;
+        }
+        return;
+    }
+}
+
+//NOTE(CSH): failures that usually go away when the same command is ran again
+const char* transientFailurePatterns[] = {
+    "being used by another process",
+    "The network path was not found",
+    "The specified network name is no longer available",
+    "An existing connection was forcibly closed",
+    "The semaphore timeout period has expired",
+};
+
+bool IsTransientFailureLine(std::string_view line)
+{
+    for (const char* pattern : transientFailurePatterns)
+    {
+        if (line.find(pattern) != std::string_view::npos)
+            return true;
+    }
+    return false;
+}
+
+//returns the position right after the name or std::string::npos
+size_t FindSwitch(const std::string& commandLine, const char* name)
+{
+    std::string lowerCommandLine = commandLine;
+    for (char& c : lowerCommandLine)
+        c = (char)tolower(c);
+    std::string s = std::string(" -") + name;
+    for (char& c : s)
+        c = (char)tolower(c);
+    size_t pos = lowerCommandLine.find(s);
+    while (pos != std::string::npos)
+    {
+        size_t end = pos + s.size();
+        if (end == lowerCommandLine.size() || lowerCommandLine[end] == ' ' || lowerCommandLine[end] == '=')
+            return end;
+        pos = lowerCommandLine.find(s, end);
+    }
+    return std::string::npos;
+}
+
+bool ContainsSwitch(const std::string& commandLine, const char* name)
+{
+    return FindSwitch(commandLine, name) != std::string::npos;
+}
+
+std::string GetSwitchValue(const std::string& commandLine, const char* name)
+{
+    size_t pos = FindSwitch(commandLine, name);
+    if (pos == std::string::npos || pos == commandLine.size() || commandLine[pos] != '=')
+        return {};
+    pos++;
+    if (pos < commandLine.size() && commandLine[pos] == '\"')
+    {
+        size_t end = commandLine.find('\"', pos + 1);
+        return commandLine.substr(pos + 1, end == std::string::npos ? std::string::npos : end - (pos + 1));
+    }
+    size_t end = commandLine.find(' ', pos);
+    return commandLine.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+}
+
+std::string BuildResumeCommandLine(const std::string& commandLine, u32 completedPhases)
+{
+    struct SkipSwitch {
+        s32 phase;
+        const char* name;
+    };
+    const SkipSwitch skips[] = {
+        { UATPhase_Build, "skipbuild" },
+        { UATPhase_Cook,  "skipcook" },
+        { UATPhase_Stage, "skipstage" },
+    };
+
+    std::string result = commandLine;
+    for (const SkipSwitch& skip : skips)
+    {
+        if (!(completedPhases & (1 << skip.phase)))
+            continue;
+        if (ContainsSwitch(result, skip.name))
+            continue;
+        result += " -";
+        result += skip.name;
+    }
+    return result;
+}
+
+u64 FileTimeValue(const FILETIME& time)
+{
+    ULARGE_INTEGER value;
+    value.LowPart  = time.dwLowDateTime;
+    value.HighPart = time.dwHighDateTime;
+    return value.QuadPart;
+}
+
+void LogTail::Start(const std::string& path)
+{
+    m_path = path;
+    m_partialLine.clear();
+    m_fileIndex = 0;
+    m_offset = 0;
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    m_startTime = FileTimeValue(now);
+}
+
+void LogTail::Read(std::vector<std::string>& lines)
+{
+    HANDLE file = CreateFileA(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+    DEFER { CloseHandle(file); };
+
+    BY_HANDLE_FILE_INFORMATION info = {};
+    if (!GetFileInformationByHandle(file, &info))
+        return;
+    if (FileTimeValue(info.ftLastWriteTime) < m_startTime)
+        return;
+
+    //UAT moves the old log aside and starts a new file, start over when the file changes
+    u64 fileIndex = (u64(info.nFileIndexHigh) << 32) | u64(info.nFileIndexLow);
+    u64 fileSize = (u64(info.nFileSizeHigh) << 32) | u64(info.nFileSizeLow);
+    if (fileIndex != m_fileIndex || fileSize < m_offset)
+    {
+        m_fileIndex = fileIndex;
+        m_offset = 0;
+        m_partialLine.clear();
+    }
+    if (fileSize == m_offset)
+        return;
+
+    LARGE_INTEGER offset = {};
+    offset.QuadPart = LONGLONG(m_offset);
+    if (!SetFilePointerEx(file, offset, NULL, FILE_BEGIN))
+        return;
+
+    char buffer[64 * 1024];
+    while (m_offset < fileSize)
+    {
+        DWORD bytesRead = 0;
+        if (!ReadFile(file, buffer, sizeof(buffer), &bytesRead, NULL) || bytesRead == 0)
+            break;
+        m_offset += bytesRead;
+        for (DWORD i = 0; i < bytesRead; i++)
+        {
+            if (buffer[i] == '\n')
+            {
+                if (m_partialLine.size() && m_partialLine[m_partialLine.size() - 1] == '\r')
+                    m_partialLine.pop_back();
+                lines.push_back(m_partialLine);
+                m_partialLine.clear();
+            }
+            else
+            {
+                m_partialLine += buffer[i];
+            }
+        }
+    }
+}
+
+UATLogMonitor::UATLogMonitor(const std::shared_ptr<BuildRun>& run, const std::string& rootPath)
+    : m_run(run)
+{
+    m_tail.Start(rootPath + "Engine/Programs/AutomationTool/Saved/Logs/Log.txt");
+    if (m_run)
+    {
+        std::vector<std::string> patterns;
+        for (const FatalLogPattern& pattern : m_run->request.fatalPatterns)
+            patterns.push_back(pattern.text);
+        m_fatalMatcher.Build(patterns);
+        m_fatalHits.resize(patterns.size(), 0);
+    }
+}
+
+bool UATLogMonitor::Poll()
+{
+    m_lines.clear();
+    m_tail.Read(m_lines);
+    bool keepRunning = true;
+    if (m_run && m_run->cancelled)
+    {
+        abortReason = "Cancelled";
+        m_run->abortReason = abortReason;
+        keepRunning = false;
+    }
+    for (const std::string& line : m_lines)
+    {
+        m_phases.ParseLine(line);
+        if (!m_run)
+            continue;
+        if (IsTransientFailureLine(line))
+            m_run->transientFailure = true;
+
+        m_found.clear();
+        m_fatalMatcher.Match(line, m_found);
+        for (s32 index : m_found)
+        {
+            const FatalLogPattern& pattern = m_run->request.fatalPatterns[index];
+            if (++m_fatalHits[index] < pattern.count)
+                continue;
+            abortReason = pattern.count > 1 ? ToString("\"%s\" was logged %i times:\n%s", pattern.text.c_str(), pattern.count, line.c_str())
+                                            : line;
+            m_run->abortReason = abortReason;
+            keepRunning = false;
+            break;
+        }
+        if (!keepRunning)
+            break;
+    }
+    if (m_run)
+    {
+        m_run->phasesCompleted = m_phases.completed;
+        m_run->currentPhase = m_phases.current;
+    }
+    return keepRunning;
+}
+
+bool UATLogMonitor::ShowExitCodeError()
+{
+    //the queue retries it on its own and a cancel was asked for, don't block the build thread on a popup
+    return !(m_run && (m_run->WillRetry() || m_run->cancelled));
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "Math.h"
+#include "Windows.h"
+#include "BuildQueue.h"
+#include "PatternMatcher.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//BuildCookRun phases in the order UAT runs them
+enum UATPhase : s32 {
+    UATPhase_None = -1,
+    UATPhase_Build,
+    UATPhase_Cook,
+    UATPhase_Stage,
+    UATPhase_Package,
+    UATPhase_Archive,
+    UATPhase_Deploy,
+    UATPhase_Run,
+    UATPhase_Count,
+};
+extern const char* uatPhaseNames[UATPhase_Count];
+
+//Follows the "********** COOK COMMAND STARTED **********" markers UAT logs around every phase
+struct UATPhaseTracker {
+    u32 started = 0; //bit per UATPhase
+    u32 completed = 0; //bit per UATPhase
+    s32 current = UATPhase_None;
+
+    void ParseLine(std::string_view line);
+};
+
+bool IsTransientFailureLine(std::string_view line);
+//name is the switch without the '-', matching is case insensitive like UAT
+bool ContainsSwitch(const std::string& commandLine, const char* name);
+std::string GetSwitchValue(const std::string& commandLine, const char* name);
+//Adds the -skip switches for every phase that completed
+std::string BuildResumeCommandLine(const std::string& commandLine, u32 completedPhases);
+
+//Reads the lines that get appended to a log file that another process is writing
+struct LogTail {
+    std::string m_path;
+    std::string m_partialLine;
+    u64 m_startTime = 0;
+    u64 m_fileIndex = 0;
+    u64 m_offset = 0;
+
+    //Logs last written before this call are from a previous run and are ignored
+    void Start(const std::string& path);
+    void Read(std::vector<std::string>& lines);
+};
+
+struct UATLogMonitor : ProcessMonitor
+{
+    std::shared_ptr<BuildRun> m_run;
+    LogTail m_tail;
+    UATPhaseTracker m_phases;
+    PatternMatcher m_fatalMatcher;
+    std::vector<s32> m_fatalHits; //lines matched per fatal pattern
+    std::vector<s32> m_found;
+    std::vector<std::string> m_lines;
+
+    UATLogMonitor(const std::shared_ptr<BuildRun>& run, const std::string& rootPath);
+    virtual bool Poll() override;
+    virtual bool ShowExitCodeError() override;
+};
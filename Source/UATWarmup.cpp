@@ -0,0 +1,153 @@
+#include "UATWarmup.h"
+#include "FileSystem.h"
+#include "UATLog.h"
+#include "PathValidator.h"
+#include "FrameArena.h"
+
+#include "SDL.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <thread>
+
+const char* uatWarmupStateNames[] = {
+    "Not Checked",
+    "Checking",
+    "Building",
+    "Up To Date",
+    "Failed",
+};
+
+const char* automationToolBinaries[] = {
+    "Engine/Binaries/DotNET/AutomationTool/AutomationTool.dll", //UE5
+    "Engine/Binaries/DotNET/AutomationTool.exe", //UE4
+};
+
+const char* automationToolSources[] = {
+    "Engine/Source/Programs/AutomationTool",
+    "Engine/Source/Programs/UnrealBuildTool",
+};
+
+std::string BuildUATPath(const std::string& rootPath)
+{
+    return rootPath + "Engine/Build/BatchFiles/BuildUAT.bat";
+}
+
+bool AutomationToolIsStale(const std::string& rootPath)
+{
+    u64 binaryTime = 0;
+    for (const char* binary : automationToolBinaries)
+    {
+        FileEntry entry;
+        if (GetFileEntry(rootPath + binary, entry))
+        {
+            binaryTime = entry.lastWriteTime;
+            break;
+        }
+    }
+    if (binaryTime == 0)
+        return true;
+
+    std::vector<FileEntry> files;
+    for (const char* dir : automationToolSources)
+        ScanFiles(rootPath + dir, files);
+    for (const FileEntry& file : files)
+    {
+        if (file.lastWriteTime <= binaryTime)
+            continue;
+        if (file.path.ends_with(".cs") || file.path.ends_with(".csproj") || file.path.ends_with(".props"))
+            return true;
+    }
+    return false;
+}
+
+//No console window and no popups, a failed warm up only means UAT compiles like it always did
+bool RunHiddenProcess(const std::string& path, const std::string& logPath)
+{
+    std::string commandLine = "cmd.exe /S /C \"\"" + path + "\" > \"" + logPath + "\" 2>&1\"";
+    STARTUPINFOA startupInfo = {};
+    startupInfo.cb = sizeof(startupInfo);
+    PROCESS_INFORMATION processInfo = {};
+    if (!CreateProcessA(NULL, commandLine.data(), NULL, NULL, FALSE, CREATE_NO_WINDOW | BELOW_NORMAL_PRIORITY_CLASS,
+                        NULL, NULL, &startupInfo, &processInfo))
+        return false;
+    DEFER
+    {
+        CloseHandle(processInfo.hThread);
+        CloseHandle(processInfo.hProcess);
+    };
+    WaitForSingleObject(processInfo.hProcess, INFINITE);
+    DWORD exitCode = 1;
+    GetExitCodeProcess(processInfo.hProcess, &exitCode);
+    return exitCode == 0;
+}
+
+void WarmUpAutomationTool(std::string rootPath)
+{
+    UATWarmup& warmup = UATWarmup::GetInstance();
+    s32 state = UATWarmupState_UpToDate;
+    if (AutomationToolIsStale(rootPath))
+    {
+        warmup.m_state = UATWarmupState_Building;
+        u64 startTicks = SDL_GetTicks64();
+        if (RunHiddenProcess(BuildUATPath(rootPath), "UATWarmup.log") && !AutomationToolIsStale(rootPath))
+        {
+            SDL_Log("AutomationTool warmed up in %.1fs", (SDL_GetTicks64() - startTicks) / 1000.0f);
+        }
+        else
+        {
+            SDL_Log("AutomationTool warm up failed, see UATWarmup.log");
+            state = UATWarmupState_Failed;
+        }
+    }
+    warmup.m_state = state;
+}
+
+void UATWarmup::Request(const std::string& rootPath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (rootPath == m_rootPath)
+        return;
+    if (m_state == UATWarmupState_Checking || m_state == UATWarmupState_Building)
+        return;
+    //the path is typed in one character at a time, only real engine roots are warmed up.
+    //Requested every frame so the check goes through the PathValidator instead of the file system
+    if (PathValidator::GetInstance().Query(FrameConcat(rootPath, "Engine/Build/BatchFiles/BuildUAT.bat")) != PathStatus_File)
+        return;
+    m_rootPath = rootPath;
+    m_state = UATWarmupState_Checking;
+    std::thread(WarmUpAutomationTool, rootPath).detach();
+}
+
+bool UATWarmup::WaitUntilReady(const std::string& rootPath)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (rootPath != m_rootPath)
+            return false;
+    }
+    while (m_state == UATWarmupState_Checking || m_state == UATWarmupState_Building)
+        Sleep(250);
+    //scripts could have been synced since the warm up
+    return m_state == UATWarmupState_UpToDate && !AutomationToolIsStale(rootPath);
+}
+
+UATWarmupState UATWarmup::GetState(const std::string& rootPath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (rootPath != m_rootPath)
+        return UATWarmupState_None;
+    return UATWarmupState(s32(m_state));
+}
+
+void UATWarmupJob::RunJob()
+{
+    const std::string& commandLine = run->request.commandLine;
+    if (ContainsSwitch(commandLine, "nocompile") || ContainsSwitch(commandLine, "nocompileuat") || ContainsSwitch(commandLine, "compile"))
+        return;
+    //NOTE(CSH): not -nocompile, that also skips the project and plugin *.Automation.csproj script modules
+    //which the warm up doesn't build, UAT still compiles those when they changed
+    if (UATWarmup::GetInstance().WaitUntilReady(run->request.rootPath))
+        run->extraArguments += " -nocompileuat";
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Math.h"
+#include "BuildQueue.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+enum UATWarmupState : s32 {
+    UATWarmupState_None,
+    UATWarmupState_Checking,
+    UATWarmupState_Building,
+    UATWarmupState_UpToDate,
+    UATWarmupState_Failed,
+};
+extern const char* uatWarmupStateNames[];
+
+//True when the AutomationTool scripts changed after the AutomationTool binaries were built
+bool AutomationToolIsStale(const std::string& rootPath);
+
+//NOTE(CSH): builds AutomationTool with BuildUAT.bat in the background as soon as a root path is
+//loaded so RUN doesn't start with the script compile, the build then runs UAT with -nocompileuat
+struct UATWarmup {
+    std::mutex m_mutex;
+    std::string m_rootPath; //root of the last warm up
+    std::atomic<s32> m_state = UATWarmupState_None;
+
+    static UATWarmup& GetInstance()
+    {
+        static UATWarmup instance;
+        return instance;
+    }
+    //Call every frame, starts a warm up when the root path changed and nothing is building
+    void Request(const std::string& rootPath);
+    //Waits for a running warm up of rootPath,
+    //returns true when the AutomationTool binaries are up to date with the scripts
+    bool WaitUntilReady(const std::string& rootPath);
+    UATWarmupState GetState(const std::string& rootPath);
+};
+
+//Adds -nocompileuat when the warm up made building AutomationTool unnecessary
+struct UATWarmupJob : Job
+{
+    std::shared_ptr<BuildRun> run;
+    virtual void RunJob() override;
+};
@@ -0,0 +1,1645 @@
+#include "UI.h"
+
+#include "imgui.h"
+#include "Tracy.hpp"
+
+#include "Windows.h"
+#include "Math.h"
+#include "Threading.h"
+#include "Config.h"
+#include "Themes.h"
+#include "BuildQueue.h"
+#include "UATLog.h"
+#include "Fingerprint.h"
+#include "ArtifactCache.h"
+#include "Prefetch.h"
+#include "SizeAnalytics.h"
+#include "UATWarmup.h"
+#include "PathValidator.h"
+#include "AsyncFileWriter.h"
+#include "SettingsHistory.h"
+#include "StringTable.h"
+#include "FrameArena.h"
+
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+[[nodiscard]] inline ImVec2 HadamardProduct(const ImVec2& a, const ImVec2& b)
+{
+    return { a.x * b.x, a.y * b.y };
+}
+
+bool FindNumberInVector(const std::vector<s32>& data, const s32 val)
+{
+    for (s32 i = 0; i < data.size(); i++)
+    {
+        if (data[i] == val)
+            return true;
+    }
+    return false;
+}
+
+void RemoveNumberInVector(std::vector<s32>& data, const s32 val)
+{
+    std::erase_if(data,
+        [val](s32 a)
+        {
+            return a == val;
+        });
+}
+void RemoveNullElements(std::vector<PlatformSettings>& data)
+{
+    std::erase_if(data,
+        [](const PlatformSettings& ps)
+        {
+            return ps.name.empty();
+        });
+}
+int DynamicTextCallback(ImGuiInputTextCallbackData* data)
+{
+    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize)
+    {
+        assert(data->UserData);
+        if (!data->UserData)
+            return 1;
+        std::string* string = (std::string*)data->UserData;
+        string->resize(data->BufTextLen);
+        data->Buf = string->data();
+    }
+    return 0;
+}
+bool InputTextDynamicSize(const char* title, std::string& s, ImGuiInputTextFlags flags = ImGuiInputTextFlags_None)
+{
+    return ImGui::InputText(title, s.data(), s.capacity(), flags | ImGuiInputTextFlags_CallbackResize, DynamicTextCallback, &s);
+}
+bool InputTextMultilineDynamicSize(const std::string& title, std::string& s, ImGuiInputTextFlags flags = ImGuiInputTextFlags_None)
+{
+    return ImGui::InputTextMultiline(title.c_str(), const_cast<char*>(title.data()), s.capacity(), ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 2), flags | ImGuiInputTextFlags_CallbackResize, DynamicTextCallback, &s);
+}
+
+void TextCentered(const char* text)
+{
+    float win_width = ImGui::GetWindowSize().x;
+    float text_width = ImGui::CalcTextSize(text).x;
+
+    // calculate the indentation that centers the text on one line, relative
+    // to window left, regardless of the `ImGuiStyleVar_WindowPadding` value
+    float text_indentation = (win_width - text_width) * 0.5f;
+
+    // if text is too long to be drawn on one line, `text_indentation` can
+    // become too small or even negative, so we check a minimum indentation
+    float min_indentation = 20.0f;
+    if (text_indentation <= min_indentation) {
+        text_indentation = min_indentation;
+    }
+
+    ImGui::SameLine(text_indentation);
+    ImGui::PushTextWrapPos(win_width - text_indentation);
+    ImGui::TextUnformatted(text);
+    ImGui::PopTextWrapPos();
+}
+
+std::string* s_modifyingText = nullptr;
+std::string s_unmodifiedText;
+ProcessSettings* s_modifyingProcess = nullptr;
+ProcessSettings s_unmodifiedProcess;
+void EditProcessSettings(ProcessSettings& process)
+{
+    s_unmodifiedProcess = process;
+    s_modifyingProcess = &process;
+}
+void OpenModifyingPrompt(std::string& s, ProcessSettings* process = nullptr)
+{
+    if (ImGui::BeginPopupContextItem())
+    {
+        if (ImGui::Selectable("Edit"))
+        {
+            s_unmodifiedText = s;
+            s_modifyingText = &s;
+            ImGui::CloseCurrentPopup();
+        }
+
+        if (process && ImGui::Selectable("Process Settings"))
+        {
+            EditProcessSettings(*process);
+            ImGui::CloseCurrentPopup();
+        }
+
+        if (ImGui::Selectable("Delete"))
+        {
+            s.clear();
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
+    }
+}
+s32* s_modifyingTextIndex = nullptr;
+void EditModifyingPromptFile(std::string& s, s32* index)
+{
+    s_unmodifiedText = s;
+    s_modifyingText = &s;
+    s_modifyingTextIndex = index;
+
+}
+//void OpenModifyingPromptFile(std::string& s, s32* index)
+//{
+//    if (ImGui::BeginPopupContextItem())
+//    {
+//        if (ImGui::Selectable("Edit"))
+//        {
+//            s_unmodifiedText = s;
+//            s_modifyingText = &s;
+//            ImGui::CloseCurrentPopup();
+//        }
+//
+//        if (ImGui::Selectable("Delete"))
+//        {
+//            s.clear();
+//            ImGui::CloseCurrentPopup();
+//        }
+//        ImGui::EndPopup();
+//    }
+//}
+
+//bool s_openConfigSelectionPopup = false;
+void SaveCurrentOrCreateNewConfig(AppSettings& appSettings, Settings& settings)
+{
+    if (appSettings.fileNames.size())
+    {
+        if (appSettings.currentFileNameIndex >= 0 && appSettings.currentFileNameIndex < appSettings.fileNames.size())
+        {
+            SaveConfig(settings, appSettings.fileNames[appSettings.currentFileNameIndex]);
+            LoadConfig(settings, appSettings);//clear any out of bounds indices
+        }
+        else
+        {
+            std::string blah;
+            appSettings.fileNames.push_back(blah);
+            appSettings.currentFileNameIndex = s32(appSettings.fileNames.size() - 1);
+            EditModifyingPromptFile(appSettings.fileNames[appSettings.currentFileNameIndex], &appSettings.currentFileNameIndex);
+        }
+    }
+    else
+    {
+        std::string blah;
+        appSettings.fileNames.push_back(blah);
+        appSettings.currentFileNameIndex = s32(appSettings.fileNames.size() - 1);
+        EditModifyingPromptFile(appSettings.fileNames[appSettings.currentFileNameIndex], &appSettings.currentFileNameIndex);
+    }
+}
+bool GetStringFromSTDVector(void* data, int idx, const char** out_text)
+{
+    if (!data)
+        return false;
+    
+    std::vector<std::string>* d = (std::vector<std::string>*)data;
+    if (idx <= d->size())
+        return false;
+    
+    *out_text = (*d)[idx].c_str();
+    return true;
+}
+
+
+
+bool NameStatusButtonAdd(const std::string& buttonName, std::string& text, float length = 125.0f)
+{
+    ImGui::SameLine();
+    float buttonSize = 25.0f;
+#if 1
+    float availableWidth = ImGui::GetContentRegionAvail().x;
+    if (availableWidth < length)
+    {
+        ImGui::NewLine();
+    }
+#else
+    float inputSize = 20.0f;
+    //Scaling input size based on region left
+    float availableWidth = ImGui::GetContentRegionAvail().x;
+    if (availableWidth < inputSize)
+    {
+        ImGui::NewLine();
+    }
+    availableWidth = ImGui::GetContentRegionAvail().x;
+    inputSize = availableWidth * 0.25f
+#endif
+    ImGui::SetNextItemWidth(length - buttonSize);
+    InputTextDynamicSize(InternLabel("##", buttonName), text);
+    ImGui::SameLine();
+    return ImGui::Button(InternLabel("Add##", buttonName)) && text.size();
+}
+
+void RemoveStartAndEndSpaces(std::string& s)
+{
+    while (s[0] == ' ')
+    {
+        s.erase(0, 1);
+    }
+    while (s[s.size() - 1] == ' ')
+    {
+        s.erase(s.size() - 1, 1);
+    }
+}
+
+void ExecutionSection(const std::string& sectionTitle, BuildEvents& be, std::vector<s32>& enables, std::string& inputString)
+{
+    //ImGui::SetNextItemOpen(true, ImGuiCond_FirstUseEver);
+    ImGui::SetNextItemOpen(true, ImGuiCond_Once);
+    if (ImGui::TreeNode(InternLabel(sectionTitle, " Events:")))
+    {
+        DEFER{ ImGui::TreePop(); };
+        bool inputSuccess = false;
+        inputSuccess |= InputTextDynamicSize(InternLabel("##", sectionTitle, " Event"), inputString, ImGuiInputTextFlags_EnterReturnsTrue);
+        ImGui::SameLine();
+        inputSuccess |= ImGui::Button("Add");
+        if (inputSuccess)
+        {
+            if (inputString.size())
+            {
+                RemoveStartAndEndSpaces(inputString);
+                if (inputString.size())
+                {
+                    be.Add(inputString);
+                    inputString.clear();
+                }
+            }
+        }
+        if (be.m_events.size() == 0)
+            return;
+
+
+        ImGuiTableFlags tableFlags =
+            ImGuiTableFlags_RowBg |
+            ImGuiTableFlags_BordersV |
+            ImGuiTableFlags_BordersOuterV |
+            ImGuiTableFlags_BordersInnerV |
+            ImGuiTableFlags_BordersH |
+            ImGuiTableFlags_BordersOuterH |
+            ImGuiTableFlags_BordersInnerH |
+            ImGuiTableFlags_ScrollX |
+            ImGuiTableFlags_ScrollY;
+            //ImGuiTableFlags_NoSavedSettings;
+
+        //NOTE(CSH): 1 larger than the array to have size leftover for the horizontal scroll bar
+        //capping the height at 5 so you can see the top row while scrolling horizontally
+        //TODO: change the max height to varry with the size of the child window
+        const int maxTableHeight = 5;
+        ImVec2 tableSize = ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * (Min(maxTableHeight, (int)be.m_events.size()) + 1)); 
+        const int tableColumnCount = 2;
+        if (ImGui::BeginTable("table_advanced", tableColumnCount, tableFlags, tableSize, 0.0f))
+        {
+            DEFER{ ImGui::EndTable(); };
+
+            const ImGuiTableColumnFlags columnFlags = ImGuiTableColumnFlags_WidthFixed;
+            float longestText = 0;
+            for (const auto& item : be.m_events)
+            {
+                if (item.name.empty())
+                    continue;
+                ImVec2 textSize = ImGui::CalcTextSize(item.name.c_str());
+                longestText = Max(longestText, textSize.x);
+            }
+            ImGui::TableSetupScrollFreeze(1, 0);
+            ImGui::TableSetupColumn("Status",   columnFlags | ImGuiTableColumnFlags_NoHide);
+            ImGui::TableSetupColumn("String",   columnFlags, longestText);
+
+            //ImGui::PushButtonRepeat(true);
+            {
+                for (int row_n = 0; row_n < be.m_events.size(); row_n++)
+                {
+                    if (be.m_events[row_n].name.empty())
+                        continue;
+                    const BuildEvent& item = be.m_events[row_n];
+
+                    ImGui::PushID(item.name.c_str());
+                    DEFER{ ImGui::PopID(); };
+
+                    ImGui::TableNextRow(ImGuiTableRowFlags_None, 0);
+                    if (ImGui::TableSetColumnIndex(0))
+                    {
+                        const char* buttonLabel = "Disabled";
+                        float color = 0.0f;
+                        const bool enabled = FindNumberInVector(enables, item.id);
+                        if (enabled)
+                        {
+                            color = 2.0f / 7.0f;
+                            buttonLabel = "Enabled";
+                        }
+                        
+                        ImGui::PushStyleColor(ImGuiCol_Button,          (ImVec4)ImColor::HSV(color, 0.6f, 0.6f));
+                        ImGui::PushStyleColor(ImGuiCol_ButtonHovered,   (ImVec4)ImColor::HSV(color, 0.7f, 0.7f));
+                        ImGui::PushStyleColor(ImGuiCol_ButtonActive,    (ImVec4)ImColor::HSV(color, 0.8f, 0.8f));
+                        if (ImGui::SmallButton(buttonLabel))
+                        {
+                            if (enabled)
+                                RemoveNumberInVector(enables, item.id);
+                            else
+                                enables.push_back(item.id);
+                        }
+                        ImGui::PopStyleColor(3);
+                    }
+
+
+                    ImGui::TableSetColumnIndex(1);
+                    ImGuiSelectableFlags selectable_flags = ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowItemOverlap;
+                    ImGui::Selectable(item.name.c_str(), false, selectable_flags, ImVec2(0, 0));
+                    if (ImGui::IsItemActive() && !ImGui::IsItemHovered())
+                    {
+                        int nextIndex = row_n + (ImGui::GetMouseDragDelta(0).y < 0.f ? -1 : 1);
+                        if (nextIndex >= 0 && nextIndex < be.m_events.size())
+                        {
+                            std::swap(be.m_events[row_n], be.m_events[nextIndex]);
+                            ImGui::ResetMouseDragDelta();
+                        }
+                    }
+                    OpenModifyingPrompt(be.m_events[row_n].name, &be.m_events[row_n].process);
+                }
+            }
+        }
+        be.RemoveNullElements();
+    }
+}
+
+void WrapInQuotes(std::string& s)
+{
+    if (s.size())
+    {
+        if (s[0] != '\"')
+            s = '\"' + s;
+        if (s[s.size() - 1] != '\"')
+            s = s + '\"';
+    }
+}
+
+void CleanPathString(std::string& s)
+{
+    size_t pos = s.find('\\');
+    while (pos != std::string::npos)
+    {
+        s.replace(pos, 1, "/", 1);
+        pos = s.find('\\');
+    }
+}
+
+void HelpMarker(const char* desc)
+{
+    ImGui::TextDisabled("(?)");
+    if (ImGui::IsItemHovered())
+    {
+        ImGui::BeginTooltip();
+        ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+        ImGui::TextUnformatted(desc);
+        ImGui::PopTextWrapPos();
+        ImGui::EndTooltip();
+    }
+}
+
+bool GetCStringFromPlatformSettings(void* data, int idx, const char** out_text)
+{
+    if (!data)
+        return false;
+    const std::vector<PlatformSettings>& d = *(std::vector<PlatformSettings>*)data;
+    if (idx >= d.size())
+        return false;
+    if (d[idx].name.empty())
+        return false;
+    *out_text = d[idx].name.c_str();
+    return true;
+}
+
+bool GetCStringFromThemes(void* data, int idx, const char** out_text)
+{
+    if (!data)
+        return false;
+    const Theme* d = (Theme*)data;
+    *out_text = d[idx].name;
+    return true;
+}
+
+void FatalPatternsSection(std::vector<FatalLogPattern>& patterns, std::string& inputString)
+{
+    if (!ImGui::TreeNode("Fatal Log Patterns:"))
+        return;
+    DEFER{ ImGui::TreePop(); };
+    ImGui::SameLine();
+    HelpMarker("UAT and everything it started is stopped as soon as a log line contains one of these, "
+               "Count is the number of lines that need to contain it before stopping");
+
+    bool inputSuccess = InputTextDynamicSize("##Fatal Log Pattern", inputString, ImGuiInputTextFlags_EnterReturnsTrue);
+    ImGui::SameLine();
+    inputSuccess |= ImGui::Button("Add");
+    if (inputSuccess && inputString.size())
+    {
+        patterns.push_back({ inputString });
+        inputString.clear();
+    }
+
+    s32 removeIndex = -1;
+    for (s32 i = 0; i < patterns.size(); i++)
+    {
+        FatalLogPattern& pattern = patterns[i];
+        ImGui::PushID(i);
+        DEFER{ ImGui::PopID(); };
+        if (ImGui::SmallButton("Remove"))
+            removeIndex = i;
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(90.0f);
+        if (ImGui::InputInt("##Count", &pattern.count))
+            pattern.count = Max(pattern.count, 1);
+        ImGui::SameLine();
+        InputTextDynamicSize("##Pattern", pattern.text);
+    }
+    if (removeIndex != -1)
+        patterns.erase(patterns.begin() + removeIndex);
+}
+
+void BuildQueueSection(BuildQueue& queue)
+{
+    if (!ImGui::TreeNode(FrameFormat("Build Queue (%i)###Build Queue", (s32)queue.m_requests.size())))
+        return;
+    DEFER{ ImGui::TreePop(); };
+
+    ImGui::Checkbox("Paused", &queue.m_paused);
+    ImGui::SameLine();
+    HelpMarker("Builds run in order, a failed build pauses the queue. Identical builds that are already running or waiting are not added again");
+
+    s32 removeIndex = -1;
+    bool cancel = false;
+    s32 moveIndex = -1;
+    s32 moveOffset = 0;
+    for (s32 i = 0; i < queue.m_requests.size(); i++)
+    {
+        const BuildRequest& request = queue.m_requests[i];
+        ImGui::PushID(i);
+        DEFER{ ImGui::PopID(); };
+
+        const bool running = (i == 0 && queue.IsRunning());
+        if (running)
+            ImGui::BeginDisabled();
+        if (ImGui::ArrowButton("##Up", ImGuiDir_Up))
+        {
+            moveIndex = i;
+            moveOffset = -1;
+        }
+        ImGui::SameLine();
+        if (ImGui::ArrowButton("##Down", ImGuiDir_Down))
+        {
+            moveIndex = i;
+            moveOffset = 1;
+        }
+        ImGui::SameLine();
+        if (running)
+        {
+            ImGui::EndDisabled();
+            if (ImGui::SmallButton("Cancel"))
+                cancel = true;
+        }
+        else if (ImGui::SmallButton("Remove"))
+        {
+            removeIndex = i;
+        }
+        ImGui::SameLine();
+        ImGui::Text("%s %s %s", running ? "[Running]" : "[Pending]", request.platform.c_str(), request.configFile.c_str());
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::BeginTooltip();
+            ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+            ImGui::TextUnformatted(request.commandLine.c_str());
+            ImGui::PopTextWrapPos();
+            ImGui::EndTooltip();
+        }
+    }
+    if (moveIndex != -1)
+        queue.Move(moveIndex, moveOffset);
+    if (removeIndex != -1)
+        queue.Remove(removeIndex);
+    if (cancel)
+        queue.Cancel();
+}
+
+f32 BytesToMB(u64 bytes)
+{
+    return f32(bytes) / (1024.0f * 1024.0f);
+}
+
+struct TreemapRect {
+    ImVec2 min;
+    ImVec2 max;
+};
+
+//Splits the entries (largest first) into two halves of about the same size along the longer side of rect
+void LayoutTreemap(const std::vector<SizeEntry>& entries, s32 begin, s32 end, u64 bytes, TreemapRect rect, std::vector<TreemapRect>& out)
+{
+    if (end - begin == 1)
+    {
+        out[begin] = rect;
+        return;
+    }
+    s32 split = begin + 1;
+    u64 half = entries[begin].bytes;
+    while (split < end - 1 && (half + entries[split].bytes) * 2 <= bytes)
+        half += entries[split++].bytes;
+
+    f32 t = bytes ? f32(half) / f32(bytes) : 0.5f;
+    TreemapRect a = rect;
+    TreemapRect b = rect;
+    if (rect.max.x - rect.min.x > rect.max.y - rect.min.y)
+    {
+        a.max.x = b.min.x = rect.min.x + (rect.max.x - rect.min.x) * t;
+    }
+    else
+    {
+        a.max.y = b.min.y = rect.min.y + (rect.max.y - rect.min.y) * t;
+    }
+    LayoutTreemap(entries, begin, split, half, a, out);
+    LayoutTreemap(entries, split, end, bytes - half, b, out);
+}
+
+void SizeTreemap(const SizeReport& report, const SizeReport* previous, s32 warningPercent, f32 height)
+{
+    //the smallest directories are merged, they would only be slivers
+    const s32 maxEntries = 64;
+    std::vector<SizeEntry> entries(report.directories.begin(), report.directories.begin() + Min<s32>(maxEntries, s32(report.directories.size())));
+    if (report.directories.size() > maxEntries)
+    {
+        SizeEntry other = { "(other)", 0 };
+        for (s32 i = maxEntries; i < report.directories.size(); i++)
+            other.bytes += report.directories[i].bytes;
+        entries.push_back(other);
+    }
+    if (entries.empty())
+        return;
+
+    ImVec2 size = { ImGui::GetContentRegionAvail().x, height };
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::InvisibleButton("##Treemap", size);
+    const bool hovered = ImGui::IsItemHovered();
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+
+    std::vector<TreemapRect> rects(entries.size());
+    LayoutTreemap(entries, 0, s32(entries.size()), report.totalBytes, { origin, { origin.x + size.x, origin.y + size.y } }, rects);
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    for (s32 i = 0; i < entries.size(); i++)
+    {
+        const SizeEntry& entry = entries[i];
+        const TreemapRect& rect = rects[i];
+        const SizeEntry* before = previous ? FindSizeEntry(previous->directories, entry.name) : nullptr;
+        f32 growth = before ? GrowthPercent(before->bytes, entry.bytes) : 0.0f;
+        bool grew = warningPercent > 0 && growth > warningPercent;
+
+        ImU32 color = grew ? ImColor::HSV(0.0f, 0.7f, 0.7f) : ImColor::HSV(0.55f + 0.1f * (i % 4), 0.4f, 0.35f + 0.05f * (i % 3));
+        drawList->AddRectFilled(rect.min, rect.max, color);
+        drawList->AddRect(rect.min, rect.max, ImGui::GetColorU32(ImGuiCol_Border));
+        ImVec2 textSize = ImGui::CalcTextSize(entry.name.c_str());
+        if (textSize.x + 4 < rect.max.x - rect.min.x && textSize.y + 4 < rect.max.y - rect.min.y)
+            drawList->AddText({ rect.min.x + 2, rect.min.y + 2 }, ImGui::GetColorU32(ImGuiCol_Text), entry.name.c_str());
+
+        if (hovered && mouse.x >= rect.min.x && mouse.x < rect.max.x && mouse.y >= rect.min.y && mouse.y < rect.max.y)
+        {
+            if (before)
+                ImGui::SetTooltip("%s\n%.1f MB (%+.1f MB, %+.1f%%)", entry.name.c_str(), BytesToMB(entry.bytes),
+                                  BytesToMB(entry.bytes) - BytesToMB(before->bytes), growth);
+            else
+                ImGui::SetTooltip("%s\n%.1f MB", entry.name.c_str(), BytesToMB(entry.bytes));
+        }
+    }
+}
+
+void SizeTable(const char* name, const std::vector<SizeEntry>& entries, const std::vector<SizeEntry>* previous, s32 warningPercent)
+{
+    ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    if (!ImGui::BeginTable(name, 4, flags))
+        return;
+    DEFER{ ImGui::EndTable(); };
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("MB", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+    ImGui::TableSetupColumn("Change MB", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+    ImGui::TableSetupColumn("Change %", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+    ImGui::TableHeadersRow();
+    for (const SizeEntry& entry : entries)
+    {
+        const SizeEntry* before = previous ? FindSizeEntry(*previous, entry.name) : nullptr;
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(entry.name.c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", BytesToMB(entry.bytes));
+        if (!previous)
+            continue;
+        u64 beforeBytes = before ? before->bytes : 0;
+        f32 growth = GrowthPercent(beforeBytes, entry.bytes);
+        ImVec4 color = (warningPercent > 0 && (growth > warningPercent || !before)) ? ImVec4(1.0f, 0.4f, 0.4f, 1.0f) : ImGui::GetStyleColorVec4(ImGuiCol_Text);
+        ImGui::TableNextColumn();
+        ImGui::TextColored(color, "%+.1f", BytesToMB(entry.bytes) - BytesToMB(beforeBytes));
+        ImGui::TableNextColumn();
+        if (before)
+            ImGui::TextColored(color, "%+.1f%%", growth);
+        else
+            ImGui::TextColored(color, "new");
+    }
+}
+
+void SizeReportWindow(bool* open, std::string& key, s32 warningPercent)
+{
+    ImGui::SetNextWindowSize(ImVec2(800, 600), ImGuiCond_FirstUseEver);
+    bool visible = ImGui::Begin("Size Report", open, ImGuiWindowFlags_NoSavedSettings);
+    DEFER{ ImGui::End(); };
+    if (!visible)
+        return;
+
+    SizeHistory& history = SizeHistory::GetInstance();
+    if (key.empty())
+        key = history.LastKey();
+    if (key.empty())
+    {
+        ImGui::TextWrapped("No staged builds have been measured yet, builds with -stage are measured after they succeed");
+        return;
+    }
+    ImGui::SetNextItemWidth(-FLT_MIN);
+    if (ImGui::BeginCombo("##Size Report Build", key.c_str()))
+    {
+        for (const std::string& k : history.Keys())
+        {
+            if (ImGui::Selectable(k.c_str(), k == key))
+                key = k;
+        }
+        ImGui::EndCombo();
+    }
+
+    SizeReport latest, previous;
+    s32 found = history.GetLatest(key, latest, previous);
+    if (found == 0)
+        return;
+    const SizeReport* compare = found > 1 ? &previous : nullptr;
+    if (compare)
+    {
+        f32 growth = GrowthPercent(previous.totalBytes, latest.totalBytes);
+        bool grew = warningPercent > 0 && growth > warningPercent;
+        ImVec4 color = grew ? ImVec4(1.0f, 0.4f, 0.4f, 1.0f) : ImGui::GetStyleColorVec4(ImGuiCol_Text);
+        ImGui::TextColored(color, "Total: %.1f MB (%+.1f MB, %+.1f%% since the previous build)", BytesToMB(latest.totalBytes),
+                           BytesToMB(latest.totalBytes) - BytesToMB(previous.totalBytes), growth);
+    }
+    else
+    {
+        ImGui::Text("Total: %.1f MB", BytesToMB(latest.totalBytes));
+    }
+
+    SizeTreemap(latest, compare, warningPercent, ImGui::GetContentRegionAvail().y * 0.5f);
+    if (ImGui::BeginTabBar("##Size Tables"))
+    {
+        if (ImGui::BeginTabItem("Directories"))
+        {
+            SizeTable("##Directories", latest.directories, compare ? &previous.directories : nullptr, warningPercent);
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Extensions"))
+        {
+            SizeTable("##Extensions", latest.extensions, compare ? &previous.extensions : nullptr, warningPercent);
+            ImGui::EndTabItem();
+        }
+        ImGui::EndTabBar();
+    }
+}
+
+const char* processPriorityNames[ProcessPriority_Count] = {
+    "Idle",
+    "Below Normal",
+    "Normal",
+    "Above Normal",
+    "High",
+};
+
+void ProcessSettingsEditor(ProcessSettings& process)
+{
+    const float inputWidth = 150.0f;
+    ImGui::Text("Priority:");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(inputWidth);
+    ImGui::Combo("##Priority", &process.priority, processPriorityNames, ProcessPriority_Count);
+
+    ImGui::Text("Affinity Mask:");
+    ImGui::SameLine();
+    HelpMarker(FrameFormat("Hex bit mask of the cores the process can run on, 0 uses every core (%i cores available)", SDL_GetCPUCount()));
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(inputWidth);
+    ImGui::InputScalar("##Affinity Mask", ImGuiDataType_U64, &process.affinityMask, nullptr, nullptr, "%llX", ImGuiInputTextFlags_CharsHexadecimal);
+
+    ImGui::Checkbox("Use Job Object", &process.useJobObject);
+    ImGui::SameLine();
+    HelpMarker("Runs the process and every process it starts inside of a job object so the limits below apply to the whole build");
+    if (!process.useJobObject)
+        ImGui::BeginDisabled();
+    ImGui::Text("CPU Rate Limit %%:");
+    ImGui::SameLine();
+    HelpMarker("Percent of the total CPU time of the machine the build can use, 0 is unlimited");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(inputWidth);
+    if (ImGui::InputInt("##CPU Rate", &process.cpuRatePercent))
+        process.cpuRatePercent = Clamp(process.cpuRatePercent, 0, 100);
+    ImGui::Text("Memory Limit MB:");
+    ImGui::SameLine();
+    HelpMarker("Committed memory limit for the whole build, 0 is unlimited");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(inputWidth);
+    if (ImGui::InputInt("##Memory Limit", &process.memoryLimitMB, 512, 4096))
+        process.memoryLimitMB = Max(process.memoryLimitMB, 0);
+    if (!process.useJobObject)
+        ImGui::EndDisabled();
+}
+
+
+void UpdateUI(UIState& ui, Settings& settings, AppSettings& appSettings, BuildQueue& buildQueue, Threading& threading)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGuiStyle& style = ImGui::GetStyle();
+    if (buildQueue.Update(threading, appSettings) != BuildState_Running)
+    {
+        //BuildFinished
+        NotifyWindowBuildFinished();
+    }
+    ui.buildRunning = buildQueue.IsRunning();
+    if (SizeHistory::GetInstance().TakeGrowthWarning(ui.sizeReportKey))
+        ui.showSizeReport = true;
+    //NOTE(CSH): a warm up next to a running UAT would compile the same scripts at the same time
+    if (appSettings.uatWarmup && !ui.buildRunning && !ui.dryRun)
+        UATWarmup::GetInstance().Request(settings.rootPath);
+
+
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(viewport->WorkPos, ImGuiCond_Always, {});
+    ImGui::SetNextWindowSize(viewport->WorkSize, ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(1.0f); // Transparent background
+    ImGuiWindowFlags windowFlags =
+        //ImGuiWindowFlags_NoBackground |
+#if 0
+        ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoCollapse |
+#else
+        ImGuiWindowFlags_NoDecoration |
+#endif
+        ImGuiWindowFlags_MenuBar |
+        ImGuiWindowFlags_NoSavedSettings |
+        ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoNav |
+        ImGuiWindowFlags_NoMove;
+
+    if (ImGui::Begin("Main", nullptr, windowFlags))
+    {
+        ZoneScopedN("Main");
+        if (ImGui::BeginMenuBar())
+        {
+            if (ImGui::BeginMenu("App Settings"))
+            {
+                ZoneScopedN("App Settings");
+                ImGui::Text("Color:");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(100);
+                s32 colorSelection = appSettings.colorSelection;
+                if (ImGui::Combo("##Color", &appSettings.colorSelection, GetCStringFromThemes, &ColorOptions, (s32)Color_Count))
+                {
+                    if (colorSelection != appSettings.colorSelection)
+                    {
+                        Color_Set(appSettings.colorSelection);
+                        MarkAppSettingsDirty();
+                    }
+                }
+                ImGui::Text("Style:");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(100);
+                s32 styleSelection = appSettings.styleSelection;
+                if (ImGui::Combo("##Style", &appSettings.styleSelection, GetCStringFromThemes, &StyleOptions, (s32)Style_Count))
+                {
+                    if (styleSelection != appSettings.styleSelection)
+                    {
+                        Style_Set(appSettings.styleSelection);
+                        MarkAppSettingsDirty();
+                    }
+                }
+                ImGui::Text("UPS:");
+                ImGui::SameLine();
+                HelpMarker("This changes the updates per second of the application");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(90.0f);
+                if (ImGui::InputFloat("##Updates Per Second", &appSettings.UPS, 1.0f, 10.0f, "%.1f"))
+                {
+                    MarkAppSettingsDirty();
+                }
+                ImGui::Text("Host Build Limit:");
+                ImGui::SameLine();
+                HelpMarker("Max number of UAT builds that every UATHelper on this machine can run at the same time, 0 is unlimited");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(90.0f);
+                if (ImGui::InputInt("##Host Build Limit", &appSettings.hostBudget.maxConcurrentBuilds))
+                {
+                    appSettings.hostBudget.maxConcurrentBuilds = Max(appSettings.hostBudget.maxConcurrentBuilds, 0);
+                    MarkAppSettingsDirty();
+                }
+                ImGui::Text("Host Memory Budget MB:");
+                ImGui::SameLine();
+                HelpMarker("Memory shared by every UAT build on this machine, 0 is unlimited. "
+                           "A build reserves the memory limit of its job object, a build without a limit reserves the whole budget");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(90.0f);
+                if (ImGui::InputInt("##Host Memory Budget", &appSettings.hostBudget.memoryBudgetMB, 1024, 8192))
+                {
+                    appSettings.hostBudget.memoryBudgetMB = Max(appSettings.hostBudget.memoryBudgetMB, 0);
+                    MarkAppSettingsDirty();
+                }
+                ImGui::Text("Transient Failure Retries:");
+                ImGui::SameLine();
+                HelpMarker("Times a build that failed with a transient error (locked files, network drops) is resumed automatically");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(90.0f);
+                if (ImGui::InputInt("##Transient Failure Retries", &appSettings.transientFailureRetries))
+                {
+                    appSettings.transientFailureRetries = Clamp(appSettings.transientFailureRetries, 0, 10);
+                    MarkAppSettingsDirty();
+                }
+                ImGui::Text("Skip Unchanged Phases:");
+                ImGui::SameLine();
+                HelpMarker("Hashes the Source and Content of the project before UAT runs and adds -skipbuild/-skipcook "
+                           "when nothing changed since the last successful build of the same platform and config");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(90.0f);
+                if (ImGui::Combo("##Skip Unchanged Phases", &appSettings.fingerprintMode, fingerprintModeNames, FingerprintMode_Count))
+                    MarkAppSettingsDirty();
+                if (ImGui::Checkbox("Artifact Cache", &appSettings.artifactCache))
+                    MarkAppSettingsDirty();
+                ImGui::SameLine();
+                HelpMarker("Stores the staged output of successful builds and restores it instead of running UAT "
+                           "when the command line, project fingerprints and engine version match a previous build. "
+                           "Restored files are hardlinks into the cache when it is on the same drive. "
+                           "Only builds that stage without -package, -archive, -deploy or -run are cached");
+                if (ImGui::Checkbox("Warm Up AutomationTool", &appSettings.uatWarmup))
+                    MarkAppSettingsDirty();
+                ImGui::SameLine();
+                HelpMarker("Builds AutomationTool in the background with BuildUAT.bat when the root path is loaded "
+                           "and its scripts changed, builds then run UAT with -nocompileuat");
+                if (ImGui::Checkbox("Prefetch Content", &appSettings.prefetchContent))
+                    MarkAppSettingsDirty();
+                ImGui::SameLine();
+                HelpMarker("Reads the project and engine Content into the file cache in the background while UAT compiles "
+                           "so the cook doesn't wait on the disk. Uses at most half of the free memory");
+                ImGui::Text("Artifact Cache Max GB:");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(90.0f);
+                if (ImGui::InputInt("##Artifact Cache Max GB", &appSettings.artifactCacheMaxGB, 10, 100))
+                {
+                    appSettings.artifactCacheMaxGB = Max(appSettings.artifactCacheMaxGB, 1);
+                    MarkAppSettingsDirty();
+                }
+                ImGui::Text("Size Growth Warning %%:");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(90.0f);
+                if (ImGui::InputInt("##Size Growth Warning", &appSettings.sizeGrowthWarningPercent))
+                {
+                    appSettings.sizeGrowthWarningPercent = Max(appSettings.sizeGrowthWarningPercent, 0);
+                    MarkAppSettingsDirty();
+                }
+                ImGui::SameLine();
+                HelpMarker("Opens the size report when the staged output of a build grew by more than this "
+                           "since the previous build of the same platform and config, 0 turns it off");
+                ImGui::EndMenu();
+            }
+            if (ImGui::BeginMenu("Config"))
+            {
+                ZoneScopedN("Config");
+                if (ImGui::MenuItem("Save"/*, "Ctrl+S"*/))
+                {
+                    SaveCurrentOrCreateNewConfig(appSettings, settings);
+                    //MarkAppSettingsDirty();
+                }
+                if (ImGui::BeginMenu("Load"))
+                {
+                    if (appSettings.fileNames.size() == 0)
+                    {
+                        ImGui::BeginDisabled();
+                        ImGui::Text("No Config Files Found");
+                        ImGui::EndDisabled();
+                    }
+                    else
+                    {
+                        for (s32 i = 0; i < appSettings.fileNames.size(); i++)
+                        {
+                            bool selected = (i == appSettings.currentFileNameIndex);
+                            if (ImGui::MenuItem(appSettings.fileNames[i].substr(9, appSettings.fileNames[i].size() - 9 - 5).c_str(), NULL, selected))
+                            {
+                                appSettings.currentFileNameIndex = i;
+                                LoadConfig(settings, appSettings);
+                                MarkAppSettingsDirty();
+                            }
+                        }
+                    }
+                    ImGui::EndMenu();
+                }
+                if (ImGui::MenuItem("New"))
+                {
+                    appSettings.currentFileNameIndex = -1;
+                    SaveCurrentOrCreateNewConfig(appSettings, settings);
+                }
+                if (ImGui::MenuItem("Clear"))
+                {
+                    ClearConfig(settings);
+                }
+                if (ImGui::MenuItem("Change Directory"))
+                {
+                    std::string dir;
+                    if (!ui.dryRun && GetDirectoryFromUser(appSettings.configDirectory, dir))
+                    {
+                        appSettings.configDirectory = dir;
+                        ScanDirectoryForConfigs(appSettings);
+                        MarkAppSettingsDirty();
+                    }
+                }
+                if (ImGui::MenuItem("Open Current File"))
+                {
+                    if (!ui.dryRun && appSettings.fileNames.size() && appSettings.currentFileNameIndex >= 0 && appSettings.currentFileNameIndex < appSettings.fileNames.size())
+                    {
+                        std::string filePath = appSettings.fileNames[appSettings.currentFileNameIndex];
+                        if (appSettings.configDirectory.size())
+                            filePath = appSettings.configDirectory + "/" + filePath;
+                        RunProcess(filePath.c_str(), nullptr, true);
+                    }
+                }
+                ImGui::EndMenu();
+            }
+            if (ImGui::BeginMenu("Edit"))
+            {
+                SettingsHistory& history = SettingsHistory::GetInstance();
+                //NOTE(CSH): the modifying prompt points into the settings that an undo would replace
+                if (ImGui::MenuItem("Undo", "Ctrl+Z", false, history.CanUndo() && !s_modifyingText))
+                    history.Undo(settings);
+                if (ImGui::MenuItem("Redo", "Ctrl+Y", false, history.CanRedo() && !s_modifyingText))
+                    history.Redo(settings);
+                ImGui::EndMenu();
+            }
+            if (ImGui::BeginMenu("Reports"))
+            {
+                ImGui::MenuItem("Size Report", nullptr, &ui.showSizeReport);
+                ImGui::EndMenu();
+            }
+            if (ImGui::BeginMenu("About"))
+            {
+                ZoneScopedN("About");
+                ImGui::Text("Version: %i.%02i", appSettings.majorRev, appSettings.minorRev);
+                if (ImGui::MenuItem("Github Releases") && !ui.dryRun)
+                    RunProcess("https://github.com/CharlesHenryVIII/UATHelper/releases", nullptr, true);
+                ImGui::EndMenu();
+            }
+            ImGui::EndMenuBar();
+        }
+        ImGuiWindowFlags sectionFlags =
+            ImGuiWindowFlags_NoResize |
+            ImGuiWindowFlags_NoSavedSettings |
+            ImGuiWindowFlags_NoCollapse |
+            ImGuiWindowFlags_NoFocusOnAppearing |
+            ImGuiWindowFlags_NoMove;
+
+        f32 xScale = 1.0f;
+        float topWindowHeightScale = 0.12f;
+        ImVec2 locationScale = { xScale / 2, topWindowHeightScale };
+        ImVec2 locationSize = HadamardProduct(viewport->WorkSize, locationScale);
+        locationSize.x -= 1.5f * style.WindowPadding.x;
+        if (ImGui::BeginChild("File Paths", locationSize, true, sectionFlags | ImGuiWindowFlags_NoScrollbar))
+        {
+            ZoneScopedN("File Paths");
+#ifdef DEBUG
+            ImGui::Checkbox("Show Demo Window", &ui.showDemoWindow);
+            ImGui::SameLine();
+#endif
+            TextCentered("File Paths");
+
+            ImGui::Text("Main Directory");
+            ImGui::SameLine();
+            const char* demoMainDir = "C:/UnrealEngine/Project/";
+            HelpMarker(demoMainDir);
+            ImGui::SameLine();
+            ImGui::PushItemWidth(-FLT_MIN);
+            InputTextDynamicSize(InternLabel("##", demoMainDir), settings.rootPath);
+            CleanPathString(settings.rootPath);
+            if (settings.rootPath.size() && settings.rootPath[settings.rootPath.size() - 1] != '/')
+                settings.rootPath = settings.rootPath + '/';
+
+            ImGui::Text("Path to .uproject");
+            const char* demoProjectPath = "C:/UnrealEngine/Project/Title/title.uproject";
+            ImGui::SameLine();
+            HelpMarker(demoProjectPath);
+            ImGui::SameLine();
+            InputTextDynamicSize(InternLabel("##", demoProjectPath), settings.projectPath);
+            CleanPathString(settings.projectPath);
+        }
+        ImGui::EndChild();
+        ImGui::SameLine();
+
+        ImVec2 platformScale = { xScale / 2, topWindowHeightScale };
+        ImVec2 platformSize = HadamardProduct(viewport->WorkSize, platformScale);
+        platformSize.x -= 1.5f * style.WindowPadding.x;
+        if (ImGui::BeginChild("Grouping", platformSize, true, sectionFlags))
+        {
+            ZoneScopedN("Grouping");
+            ImGui::Text("Platform Selection");
+            ImGui::SameLine();
+            HelpMarker("input build platforms you want, i.e. \"XSX\" or \"win32\" just without the quotes and only one per entry");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(150);
+            ImGui::Combo("##Platform Selection", &settings.platformSelection, GetCStringFromPlatformSettings,
+                &settings.platformOptions, (s32)settings.platformOptions.size());
+            static std::string platformAddText;
+            if (NameStatusButtonAdd("Platform", platformAddText))
+            {
+                settings.platformOptions.push_back({ platformAddText });
+                if (settings.platformOptions.size() == 1)
+                    settings.platformSelection = 0;
+                platformAddText.clear();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Delete## Platform"))
+            {
+                settings.platformOptions[settings.platformSelection].name.clear();
+                settings.platformSelection = Max(settings.platformSelection--, 0);
+                RemoveNullElements(settings.platformOptions);
+            }
+
+            ImGui::Text("Version Selection");
+            ImGui::SameLine();
+            HelpMarker("input versions you want to build, i.e. \"Test\" or \"Development\" just without the quotes and only one per entry");
+            ImGui::SameLine();
+            static std::string versionInputName;
+            if (NameStatusButtonAdd("Version", versionInputName))
+            {
+                settings.versionOptions.push_back({ versionInputName });
+                versionInputName.clear();
+            }
+            ImGui::NewLine();
+            float window_visible_x2 = ImGui::GetWindowPos().x + ImGui::GetWindowContentRegionMax().x;
+            float last_button_x2 = 0;
+            ImGuiStyle& style = ImGui::GetStyle();
+            for (int i = 0; i < settings.versionOptions.size(); i++)
+            {
+                if (settings.versionOptions[i].empty())
+                    continue;
+                //if youre hovering over itups
+                float button_szx = ImGui::CalcTextSize(settings.versionOptions[i].c_str()).x + 2 * style.FramePadding.x;
+                float next_button_x2 = last_button_x2 + style.ItemSpacing.x + button_szx;
+                if (next_button_x2 < window_visible_x2)
+                    ImGui::SameLine(0, 1);
+
+                bool found = (settings.platformSelection < settings.platformOptions.size()) ? FindNumberInVector(settings.platformOptions[settings.platformSelection].enabledVersions, i) : false;
+                bool checkbox = found;
+                ImGui::Checkbox(settings.versionOptions[i].c_str(), &checkbox);
+                if (checkbox != found)
+                {
+                    if (found)
+                        RemoveNumberInVector(settings.platformOptions[settings.platformSelection].enabledVersions, i);
+                    else
+                    {
+                        if (settings.platformSelection < settings.platformOptions.size())
+                            settings.platformOptions[settings.platformSelection].enabledVersions.push_back(i);
+                    }
+                }
+                last_button_x2 = ImGui::GetItemRectMax().x;
+                OpenModifyingPrompt(settings.versionOptions[i]);
+            }
+        }
+        ImGui::EndChild();
+
+        ImVec2 switchesScale = { 0, 0.2f };
+        ImVec2 switchesSize = HadamardProduct(viewport->WorkSize, switchesScale);
+        if (ImGui::BeginChild("Switches", switchesSize, true, sectionFlags))
+        {
+            ZoneScopedN("Switches");
+            TextCentered("Switch Selection");
+            ImGui::SameLine();
+            HelpMarker("Added switches for build here, excluding the starting \"-\"(dash)");
+            ImGui::NewLine();
+            static std::string localUniqueName;
+            if (NameStatusButtonAdd("Switch", localUniqueName, 400.0f))
+            {
+                if (localUniqueName.size())
+                {
+                    if (localUniqueName[0] == '-')
+                        localUniqueName.erase(0, 1);
+                    settings.switchOptions.push_back({ localUniqueName });
+                    localUniqueName.clear();
+                }
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Copy Active Switches"))
+            {
+                std::string s;
+                for (int i = 0; i < settings.switchOptions.size(); i++)
+                {
+                    if (!settings.switchOptions[i].size())
+                        continue;
+                    s = s + "-" + settings.switchOptions[i] + " ";
+                }
+                if (s.size())
+                {
+                    s.erase(s.size() - 1);
+                    SDL_SetClipboardText(s.c_str());
+                }
+            }
+            ImGui::NewLine();
+            float window_visible_x2 = ImGui::GetWindowPos().x + ImGui::GetWindowContentRegionMax().x;
+            float last_button_x2 = 0;
+            ImGuiStyle& style = ImGui::GetStyle();
+            for (int i = 0; i < settings.switchOptions.size(); i++)
+            {
+                if (!settings.switchOptions[i].size())
+                    continue;
+
+                float button_szx = ImGui::CalcTextSize(settings.switchOptions[i].c_str()).x + 2 * style.FramePadding.x;
+                float next_button_x2 = last_button_x2 + style.ItemSpacing.x + button_szx;
+                if (next_button_x2 < window_visible_x2)
+                    ImGui::SameLine(0, 1);
+                
+                bool found = (settings.platformSelection < settings.platformOptions.size()) ? FindNumberInVector(settings.platformOptions[settings.platformSelection].enabledSwitches, i) : false;
+                bool checkbox = found;
+                ImGui::Checkbox(settings.switchOptions[i].c_str(), &checkbox);
+                if (checkbox != found)
+                {
+                    if (found)
+                        RemoveNumberInVector(settings.platformOptions[settings.platformSelection].enabledSwitches, i);
+                    else
+                    {
+                        if (settings.platformSelection < settings.platformOptions.size())
+                            settings.platformOptions[settings.platformSelection].enabledSwitches.push_back(i);
+                    }
+                }
+                last_button_x2 = ImGui::GetItemRectMax().x;
+
+                OpenModifyingPrompt(settings.switchOptions[i]);
+            }
+        }
+        ImGui::EndChild();
+
+        ImVec2 executionScale = { 0, 0.35f };
+        ImVec2 executionSize = HadamardProduct(viewport->WorkSize, executionScale);
+        if (ImGui::BeginChild("Building", executionSize, true, sectionFlags))
+        {
+            ZoneScopedN("Building");
+            TextCentered("Build Events");
+            ImGui::SameLine();
+            HelpMarker("Add programs to be ran before or after the build\n"
+                       "@clean [-background] <dir>... deletes directories, relative to the project or using {Root}/{Project}\n"
+                       "@copy [-hash] <source> <dest> copies the files that changed since the last @copy\n"
+                       "@dedupe <dir>... hardlinks identical files of archived builds together");
+
+            static std::string preBuildInput;
+            if (settings.platformOptions.size())
+                ExecutionSection("Pre-Build", settings.preBuildEvents, settings.platformOptions[settings.platformSelection].enabledPreBuild, preBuildInput);
+
+            static std::string postBuildInput;
+            if (settings.platformOptions.size())
+                ExecutionSection("Post-Build", settings.postBuildEvents, settings.platformOptions[settings.platformSelection].enabledPostBuild, postBuildInput);
+
+            static std::string fatalPatternInput;
+            FatalPatternsSection(settings.fatalPatterns, fatalPatternInput);
+        }
+        ImGui::EndChild();
+
+        ImVec2 commandScale = { 0, 0.25f };
+        ImVec2 commandSize = HadamardProduct(viewport->WorkSize, commandScale);
+        if (ImGui::BeginChild("Command Line", ImVec2(0, 0), true, sectionFlags))
+        {
+            ZoneScopedN("Command Line");
+            TextCentered("Command Line Output");
+
+            //NOTE(CSH): paths that are still being checked count as valid so RUN doesn't flicker
+            PathValidator& pathValidator = PathValidator::GetInstance();
+            bool invalid_projectPath = settings.projectPath.size() < 10;
+            bool invalid_rootPath = settings.rootPath.size() < 3;
+            bool missing_runUAT = false;
+            bool missing_projectFile = false;
+            if (!invalid_rootPath)
+                missing_runUAT = pathValidator.Query(FrameConcat(settings.rootPath, "Engine/Build/BatchFiles/RunUAT.bat")) == PathStatus_Missing;
+            if (!invalid_projectPath)
+                missing_projectFile = pathValidator.Query(settings.projectPath) == PathStatus_Missing || !settings.projectPath.ends_with(".uproject");
+            invalid_rootPath |= missing_runUAT;
+            invalid_projectPath |= missing_projectFile;
+            bool invalid_platformOptions = !(settings.platformOptions.size());
+            bool invalid_versionSelected = true;
+            if (!invalid_platformOptions)
+                invalid_versionSelected = !(settings.platformOptions[settings.platformSelection].enabledVersions.size());
+            bool commandLineInvalid = invalid_projectPath || invalid_rootPath || invalid_platformOptions || invalid_versionSelected;
+
+            ui.finalCommandLine.clear();
+            if (commandLineInvalid)
+            {
+                if (missing_runUAT)
+                {
+                    ui.finalCommandLine = "Engine/Build/BatchFiles/RunUAT.bat Not Found In Main Directory";
+                }
+                else if (invalid_rootPath)
+                {
+                    ui.finalCommandLine = "Invalid Main Directory";
+                }
+                else if (missing_projectFile)
+                {
+                    ui.finalCommandLine = "Project Path Is Not An Existing .uproject";
+                }
+                else if (invalid_projectPath)
+                {
+                    ui.finalCommandLine = "Invalid Project Path";
+                }
+                else if (invalid_platformOptions)
+                {
+                    ui.finalCommandLine = "Invalid Platform Options";
+                }
+                else if (invalid_versionSelected)
+                {
+                    ui.finalCommandLine = "Invalid Version Selected";
+                }
+            }
+            else
+            {
+#if 1
+                ui.finalCommandLine += "\"";
+#else
+                if (ui.keepProcessWindowAlive)
+                    ui.finalCommandLine += "/K ";
+                else
+                    ui.finalCommandLine += "/c ";
+#endif
+                ui.finalCommandLine += settings.rootPath.c_str();
+                ui.finalCommandLine += "Engine/Build/BatchFiles/RunUAT.bat";
+                ui.finalCommandLine += "\"";
+                ui.finalCommandLine += " BuildCookRun";
+                ui.finalCommandLine += " -project=\"";
+                ui.finalCommandLine += settings.projectPath.c_str();
+                ui.finalCommandLine += "\"";
+                ui.finalCommandLine += " -targetplatform=";
+                ui.finalCommandLine += settings.platformOptions[settings.platformSelection].name;
+                ui.finalCommandLine += " -clientconfig=";
+                bool alreadyOneEnabled = false;
+                for (const auto& optionIndex : settings.platformOptions[settings.platformSelection].enabledVersions)
+                {
+                    if (settings.versionOptions[optionIndex].empty())
+                        continue;
+                    if (alreadyOneEnabled)
+                        ui.finalCommandLine += "+";
+                    ui.finalCommandLine += settings.versionOptions[optionIndex];
+                    alreadyOneEnabled = true;
+                }
+
+                for (const auto& optionIndex : settings.platformOptions[settings.platformSelection].enabledSwitches)
+                {
+                    ui.finalCommandLine += " -";
+                    ui.finalCommandLine += settings.switchOptions[optionIndex];
+                }
+            }
+
+            ImGui::TextWrapped(ui.finalCommandLine.c_str());
+
+            if (ImGui::Button("Copy To Clipboard"))
+            {
+                SDL_SetClipboardText(ui.finalCommandLine.c_str());
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Open Log") && !ui.dryRun)
+                RunProcess(FrameConcat(settings.rootPath, "Engine/Programs/AutomationTool/Saved/Logs/Log.txt"), nullptr, true);
+            ImGui::SameLine();
+            if (ImGui::Button("UAT Process Settings"))
+                EditProcessSettings(settings.uatProcess);
+            //ImGui::SameLine();
+            if (commandLineInvalid)
+                ImGui::BeginDisabled();
+            bool runButtonHit = ImGui::Button(ui.buildRunning ? "QUEUE" : "RUN", ImVec2(200.0f, 50.0f));
+            if (runButtonHit)
+            {
+                const PlatformSettings& platform = settings.platformOptions[settings.platformSelection];
+                BuildRequest request;
+                if (appSettings.currentFileNameIndex >= 0 && appSettings.currentFileNameIndex < appSettings.fileNames.size())
+                    request.configFile = appSettings.fileNames[appSettings.currentFileNameIndex];
+                request.platform    = platform.name;
+                request.rootPath    = settings.rootPath;
+                request.projectPath = settings.projectPath;
+                request.commandLine = ui.finalCommandLine;
+                request.uatProcess  = settings.uatProcess;
+                request.fatalPatterns = settings.fatalPatterns;
+                GetEnabledBuildEvents(settings.preBuildEvents,  platform.enabledPreBuild,   request.preBuildEvents);
+                GetEnabledBuildEvents(settings.postBuildEvents, platform.enabledPostBuild,  request.postBuildEvents);
+                ui.buildCoalesced = !buildQueue.Add(request);
+            }
+            if (commandLineInvalid)
+                ImGui::EndDisabled();
+            if (ui.buildCoalesced)
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled("Identical build is already running or queued");
+            }
+            //ImGui::Checkbox("Keep UAT CMD Window Open", &ui.keepProcessWindowAlive);
+
+            if (appSettings.uatWarmup)
+            {
+                UATWarmupState warmupState = UATWarmup::GetInstance().GetState(settings.rootPath);
+                if (warmupState != UATWarmupState_None)
+                {
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("AutomationTool: %s", uatWarmupStateNames[warmupState]);
+                }
+            }
+
+            HostSlotStatus hostStatus = GetHostSlotStatus();
+            if (hostStatus.waiting)
+            {
+                ImGui::SameLine();
+                ImGui::Text("Waiting for a host build slot (%i running, %i MB reserved)", hostStatus.buildsRunning, hostStatus.memoryReservedMB);
+            }
+
+            if (buildQueue.m_current)
+            {
+                const BuildRun& current = *buildQueue.m_current;
+                s32 phase = current.currentPhase;
+                const char* actionName = current.actionName;
+                if (actionName && !current.actionMilliseconds)
+                {
+                    ImGui::Text("%s: %i / %i files (%.1fs)", actionName, (s32)current.actionProgress, (s32)current.actionTotal,
+                                (SDL_GetTicks64() - current.actionStartTicks) / 1000.0f);
+                }
+                else if (actionName)
+                {
+                    ImGui::Text("%s took %.1fs", actionName, current.actionMilliseconds / 1000.0f);
+                    if (current.actionBytesSaved)
+                    {
+                        ImGui::SameLine();
+                        ImGui::Text("and reclaimed %llu MB", (u64)current.actionBytesSaved / (1024 * 1024));
+                    }
+                }
+                if (current.fingerprintTotal && !current.fingerprinted)
+                    ImGui::Text("Fingerprinting project: %i / %i files", (s32)current.fingerprintProgress, (s32)current.fingerprintTotal);
+                else if (current.artifactState == ArtifactState_Restoring)
+                    ImGui::Text("Restoring from the artifact cache: %i / %i files", (s32)current.artifactProgress, (s32)current.artifactTotal);
+                else if (current.artifactState == ArtifactState_Restored)
+                    ImGui::Text("Restored from the artifact cache, UAT was skipped");
+                else if (current.artifactState == ArtifactState_Storing)
+                    ImGui::Text("Storing in the artifact cache: %i / %i files", (s32)current.artifactProgress, (s32)current.artifactTotal);
+                else if (phase != UATPhase_None)
+                {
+                    ImGui::Text("UAT Phase: %s", uatPhaseNames[phase]);
+                    if (current.extraArguments.size())
+                    {
+                        ImGui::SameLine();
+                        ImGui::TextDisabled("(added%s)", current.extraArguments.c_str());
+                    }
+                }
+                if (current.prefetchState == PrefetchState_Running)
+                {
+                    ImGui::Text("Prefetching content: %llu / %llu MB", (u64)current.prefetchBytes / (1024 * 1024), (u64)current.prefetchTotalBytes / (1024 * 1024));
+                }
+                else if (current.prefetchState == PrefetchState_Finished)
+                {
+                    ImGui::Text("Prefetched %llu MB of content in %.1fs", (u64)current.prefetchBytes / (1024 * 1024), current.prefetchMilliseconds / 1000.0f);
+                }
+            }
+            if (buildQueue.m_lastFailed)
+            {
+                const BuildRun& failed = *buildQueue.m_lastFailed;
+                s32 phase = failed.currentPhase;
+                ImGui::Text("Last build failed during: %s", phase != UATPhase_None ? uatPhaseNames[phase] : "Unknown");
+                if (failed.abortReason.size() && ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Stopped on: %s", failed.abortReason.c_str());
+                if (failed.CanResume())
+                {
+                    ImGui::SameLine();
+                    if (ImGui::Button("Resume"))
+                        buildQueue.ResumeLastFailed();
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("%s", BuildResumeCommandLine(failed.request.commandLine, failed.phasesCompleted).c_str());
+                }
+            }
+
+            BuildQueueSection(buildQueue);
+
+            ImGui::Text("Application average %.3f ms/frame (%.1f FPS, Target: %.1f FPS)", 1000.0f / io.Framerate, io.Framerate, appSettings.UPS);
+#ifdef TRACK_ALLOCATIONS
+            ImGui::Text("Allocations last frame: %llu (%llu bytes)", ui.lastFrameAllocations.allocations, ui.lastFrameAllocations.bytes);
+#endif
+        }
+        ImGui::EndChild();
+
+        if (s_modifyingText)
+        {
+            if (s_modifyingTextIndex == nullptr)
+            {
+                const char* title = "Edit Text";
+                ImGui::SetNextWindowSize(ImVec2(500.0f, 0), ImGuiCond_Once);
+                ImGui::OpenPopup(title);
+                if (ImGui::BeginPopupModal(title))
+                {
+                    float buttonHeight = 30.0f;
+                    float width = -FLT_MIN;
+                    ImGui::SetNextItemWidth(width);
+                    InputTextDynamicSize("##Modifying Text", *s_modifyingText);
+                    ImVec2 popupSize = ImGui::GetWindowSize();
+                    //TODO: add proper padding (this doesn't properly pad when there is rounding)
+                    if (ImGui::Button("Save", ImVec2((popupSize.x / 2.0f) - (1.5f * style.WindowPadding.x), buttonHeight)))
+                    {
+                        s_modifyingText = nullptr;
+                        s_unmodifiedText.clear();
+                        ImGui::CloseCurrentPopup();
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("Close", ImVec2(-FLT_MIN, buttonHeight)))
+                    {
+                        *s_modifyingText = s_unmodifiedText;
+                        s_modifyingText = nullptr;
+                        s_unmodifiedText.clear();
+                        ImGui::CloseCurrentPopup();
+                    }
+                    ImGui::EndPopup();
+                }
+            }
+            else
+            {
+                const char* title = "Name New File";
+                ImGui::SetNextWindowSize(ImVec2(500.0f, 0), ImGuiCond_Once);
+                ImGui::OpenPopup(title);
+                if (ImGui::BeginPopupModal(title))
+                {
+                    ImGui::Text("Please enter the name of the new file excluding the prefix and the file type, full name of the file below:");
+                    ImGui::Text("File Name: UATHelper%s.json", s_modifyingText->c_str());
+                    float buttonHeight = 30.0f;
+                    float width = -FLT_MIN;
+                    ImGui::SetNextItemWidth(width);
+                    InputTextDynamicSize("##Modifying Text", *s_modifyingText);
+                    ImVec2 popupSize = ImGui::GetWindowSize();
+                    //TODO: add proper padding (this doesn't properly pad when there is rounding)
+                    if (s_modifyingText->size() == 0)
+                        ImGui::BeginDisabled();
+                    if (ImGui::Button("Save", ImVec2((popupSize.x / 2.0f) - (1.5f * style.WindowPadding.x), buttonHeight)))
+                    {
+                        s_modifyingText = nullptr;
+                        s_unmodifiedText.clear();
+                        appSettings.currentFileNameIndex = *s_modifyingTextIndex;
+                        s_modifyingTextIndex = nullptr;
+
+                        std::string& filename = appSettings.fileNames[appSettings.currentFileNameIndex];
+                        filename = "UATHelper" + filename + ".json";
+
+                        //The only time the s_modifyingTextIndex is used is when saving
+                        SaveConfig(settings, appSettings.fileNames[appSettings.currentFileNameIndex]);
+                        LoadConfig(settings, appSettings);
+                        MarkAppSettingsDirty();
+
+                        //If the save was triggered when the program was trying to close then close the program
+                        if (ui.exitProgram)
+                            ui.done = true;
+
+                        ImGui::CloseCurrentPopup();
+                    }
+                    if (s_modifyingText && s_modifyingText->size() == 0)
+                        ImGui::EndDisabled();
+                    ImGui::SameLine();
+                    if (ImGui::Button("Close", ImVec2(-FLT_MIN, buttonHeight)))
+                    {
+                        *s_modifyingText = s_unmodifiedText;
+                        s_modifyingText = nullptr;
+                        s_unmodifiedText.clear();
+                        if (*s_modifyingTextIndex >= 0 && *s_modifyingTextIndex < appSettings.fileNames.size() && 
+                            appSettings.fileNames[*s_modifyingTextIndex].size() < 9 + 5)
+                            appSettings.fileNames.erase(appSettings.fileNames.begin() + *s_modifyingTextIndex);
+                        s_modifyingTextIndex = nullptr;
+                        ImGui::CloseCurrentPopup();
+                    }
+                    ImGui::EndPopup();
+                }
+            }
+        }
+
+
+        if (s_modifyingProcess)
+        {
+            const char* title = "Process Settings";
+            ImGui::SetNextWindowSize(ImVec2(400.0f, 0), ImGuiCond_Once);
+            ImGui::OpenPopup(title);
+            if (ImGui::BeginPopupModal(title))
+            {
+                float buttonHeight = 30.0f;
+                ProcessSettingsEditor(*s_modifyingProcess);
+                ImVec2 popupSize = ImGui::GetWindowSize();
+                if (ImGui::Button("Save", ImVec2((popupSize.x / 2.0f) - (1.5f * style.WindowPadding.x), buttonHeight)))
+                {
+                    s_modifyingProcess = nullptr;
+                    ImGui::CloseCurrentPopup();
+                }
+                ImGui::SameLine();
+                if (ImGui::Button("Close", ImVec2(-FLT_MIN, buttonHeight)))
+                {
+                    *s_modifyingProcess = s_unmodifiedProcess;
+                    s_modifyingProcess = nullptr;
+                    ImGui::CloseCurrentPopup();
+                }
+                ImGui::EndPopup();
+            }
+        }
+
+        //if (s_openConfigSelectionPopup == true)
+        //{
+        //    ImGui::SetNextWindowSize(ImVec2(500.0f, 0), ImGuiCond_Once);
+        //    const char* title = "Select Config";
+        //    ImGui::OpenPopup(title);
+        //    if (ImGui::BeginPopupModal(title))
+        //    {
+        //        ImGui::ListBox("Options", &appSettings.currentFileNameIndex, GetStringFromSTDVector, &appSettings.fileNames, appSettings.fileNames.size()))
+        //        float buttonHeight = 30.0f;
+        //        float width = -FLT_MIN;
+        //        ImGui::SetNextItemWidth(width);
+        //        InputTextDynamicSize("##Modifying Text", *s_modifyingText);
+        //        ImVec2 popupSize = ImGui::GetWindowSize();
+        //        //TODO: add proper padding (this doesn't properly pad when there is rounding)
+        //        if (ImGui::Button("Save", ImVec2((popupSize.x / 2.0f) - (1.5f * style.WindowPadding.x), buttonHeight)))
+        //        {
+        //            s_modifyingText = nullptr;
+        //            s_unmodifiedText.clear();
+        //            if (s_modifyingTextIndex)
+        //            {
+        //                appSettings.currentFileNameIndex = *s_modifyingTextIndex;
+        //                s_modifyingTextIndex = nullptr;
+        //            }
+        //            ImGui::CloseCurrentPopup();
+        //        }
+        //        ImGui::SameLine();
+        //        if (ImGui::Button("Close", ImVec2(-FLT_MIN, buttonHeight)))
+        //        {
+        //            *s_modifyingText = s_unmodifiedText;
+        //            s_modifyingText = nullptr;
+        //            s_unmodifiedText.clear();
+        //            if (s_modifyingTextIndex)
+        //            {
+        //                if (appSettings.fileNames[*s_modifyingTextIndex].size() < 9 + 5 )
+        //                    appSettings.fileNames.erase(appSettings.fileNames.begin() + *s_modifyingTextIndex);
+        //                s_modifyingTextIndex = nullptr;
+        //            }
+        //            ImGui::CloseCurrentPopup();
+        //        }
+        //        ImGui::EndPopup();
+        //    }
+        //}
+
+        if (ui.exitProgram)
+        {
+            if (!ConfigIsSameAsLastLoad(settings))
+            {
+                ImGuiWindowFlags flags =
+                    ImGuiWindowFlags_NoCollapse |
+                    ImGuiWindowFlags_NoSavedSettings;
+                const ImVec2 min = { 260, 100 };
+                const ImVec2 windowSize = ImGui::GetMainViewport()->Size;
+                const ImVec2 max = { windowSize.x - 200, windowSize.y - 200 };
+                ImGui::SetNextWindowSizeConstraints(min, max);
+                ImGui::SetNextWindowPos(ImVec2(windowSize.x / 2, windowSize.y / 2), ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+                const char* popupName = "Unsaved Changes";
+                ImGui::OpenPopup(popupName, ImGuiPopupFlags_None);
+                if (ImGui::BeginPopupModal(popupName, &ui.exitProgram, flags))
+                {
+                    float buttonHeight = 30.0f;
+                    ImGui::TextWrapped("The application is being closed without being saved, are you sure you want to continue?");
+                    if (ImGui::Button("Save and Exit", ImVec2(-FLT_MIN, buttonHeight)))
+                    {
+                        SaveCurrentOrCreateNewConfig(appSettings, settings);
+                        //ui.done = true;
+                    }
+                    ImVec2 saveButtonSize = ImGui::GetItemRectSize();
+                    if (ImGui::Button("Exit Without Saving", ImVec2(saveButtonSize.x * (2.0f / 3.0f), buttonHeight)))
+                    {
+                        ui.done = true;
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("Cancel", ImVec2(-FLT_MIN, buttonHeight)))
+                    {
+                        ImGui::CloseCurrentPopup();
+                        ui.exitProgram = false;
+                    }
+                    ImGui::EndPopup();
+                }
+            }
+            else
+            {
+                ui.done = true;
+            }
+        }
+
+        ImGui::End();
+    }
+
+
+    //text fields have their own ctrl+z while they are typed in
+    if (io.KeyCtrl && !io.WantTextInput && !s_modifyingText)
+    {
+        SettingsHistory& history = SettingsHistory::GetInstance();
+        if (ImGui::IsKeyPressed(ImGuiKey_Z, false) && !io.KeyShift)
+            history.Undo(settings);
+        else if (ImGui::IsKeyPressed(ImGuiKey_Y, false) || (ImGui::IsKeyPressed(ImGuiKey_Z, false) && io.KeyShift))
+            history.Redo(settings);
+    }
+    SettingsHistory::GetInstance().Update(settings, ImGui::IsAnyItemActive());
+    UpdateAppSettingsSave(appSettings);
+
+    if (ui.showSizeReport)
+        SizeReportWindow(&ui.showSizeReport, ui.sizeReportKey, appSettings.sizeGrowthWarningPercent);
+    if (ui.showDemoWindow)
+        ImGui::ShowDemoWindow(&ui.showDemoWindow);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "Math.h"
+#include "Config.h"
+#include "AllocationTracker.h"
+
+#include <string>
+
+struct BuildQueue;
+struct Threading;
+
+//NOTE(CSH): what the main window keeps between frames, everything else it shows lives in Settings and AppSettings
+struct UIState {
+    std::string finalCommandLine;
+    std::string sizeReportKey;
+    bool buildCoalesced = false;
+    bool buildRunning = false;
+    bool showDemoWindow = false;
+    bool showSizeReport = false;
+    bool exitProgram = false; //closing was requested, asks to save first when there are unsaved changes
+    bool keepProcessWindowAlive = true;
+    bool done = false;
+    bool dryRun = false; //nothing that opens a program or a dialog runs, for replays and benchmarks
+    AllocationCounts lastFrameAllocations;
+};
+
+//The UI of one frame and the build queue update, between ImGui::NewFrame and ImGui::Render.
+//Doesn't touch SDL or OpenGL so it also runs without a window
+void UpdateUI(UIState& ui, Settings& settings, AppSettings& appSettings, BuildQueue& buildQueue, Threading& threading);
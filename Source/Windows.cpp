@@ -1,5 +1,7 @@
 #include "Windows.h"
 #include "Math.h"
+#include "UATLog.h"
+#include "ArtifactCache.h"
 #include "Windows/resource.h"
 
 #include "SDL_syswm.h"
@@ -9,6 +11,9 @@
 #include <shellapi.h>
 #include <combaseapi.h>
 
+#include <cstring>
+#include <string_view>
+
 std::string ToString(const char* fmt, ...)
 {
     va_list args;
@@ -19,6 +24,64 @@ std::string ToString(const char* fmt, ...)
     return buffer;
 }
 
+s32 WaitForProcess(HANDLE process, HANDLE job, const char* path, const char* args, ProcessMonitor* monitor = nullptr)
+{
+    bool aborted = false;
+    DWORD result = WaitForSingleObject(process, monitor ? 250 : INFINITE);
+    while (result == WAIT_TIMEOUT)
+    {
+        if (!monitor->Poll())
+        {
+            //NOTE(CSH): killing cmd alone would leave UAT and everything it started running
+            aborted = true;
+            if (!job || !TerminateJobObject(job, 1))
+                TerminateProcess(process, 1);
+            result = WaitForSingleObject(process, INFINITE);
+            break;
+        }
+        result = WaitForSingleObject(process, 250);
+    }
+    if (monitor && !aborted)
+        aborted = !monitor->Poll();
+    if (result)
+    {
+        std::string errorBoxTitle = ToString("WaitForSingleObject Error: %i", GetLastError());
+        std::string errorText = ToString("Application Path: %s\n"
+            "Command Line Params: %s", path, args);
+        ShowErrorWindow(errorBoxTitle, errorText);
+        assert(false);
+        return -1;
+    }
+    if (aborted)
+    {
+        if (!monitor->ShowExitCodeError())
+            return MessageBoxResponse_Continue;
+        std::string errorText = ToString("%s\n\n"
+            "Application Path: %s\n"
+            "Command Line Params: %s", monitor->abortReason.c_str(), path, args);
+        return ShowCustomErrorWindow("Stopped on a Fatal Log Pattern", errorText);
+    }
+    DWORD exitCode = {};
+    if (!GetExitCodeProcess(process, &exitCode))
+    {
+        std::string errorBoxTitle = ToString("GetExitCodeProcess Error: %i", GetLastError());
+        std::string errorText = ToString("Application Path: %s\n"
+            "Command Line Params: %s", path, args);
+        ShowErrorWindow(errorBoxTitle, errorText);
+        return -1;
+    }
+    if (exitCode)
+    {
+        if (monitor && !monitor->ShowExitCodeError())
+            return MessageBoxResponse_Continue;
+        std::string errorBoxTitle = ToString("Program Exited with Code: %i", exitCode);
+        std::string errorText = ToString("Application Path: %s\n"
+            "Command Line Params: %s", path, args);
+        return ShowCustomErrorWindow(errorBoxTitle, errorText);
+    }
+    return 0;
+}
+
 s32 RunProcess(const char* path, const char* args, bool async)
 {
     //TODO: Allow this to work for ASCII AND Unicode
@@ -51,42 +114,176 @@ s32 RunProcess(const char* path, const char* args, bool async)
         return 2;
     }
     if (!async)
+        return WaitForProcess(info.hProcess, NULL, info.lpFile, args);
+    return 0;
+}
+
+DWORD PriorityClassFromSetting(s32 priority)
+{
+    switch (priority)
     {
-        DWORD result = WaitForSingleObject(info.hProcess, INFINITE);
-        if (result)
-        {
-            std::string errorBoxTitle = ToString("WaitForSingleObject Error: %i", GetLastError());
-            std::string errorText = ToString("Application Path: %s\n"
-                "Command Line Params: %s", info.lpFile, args);
-            ShowErrorWindow(errorBoxTitle, errorText);
-            assert(false);
-            return -1;
-        }
-        DWORD exitCode = {};
-        if (!GetExitCodeProcess(info.hProcess, &exitCode))
-        {
-            std::string errorBoxTitle = ToString("GetExitCodeProcess Error: %i", GetLastError());
-            std::string errorText = ToString("Application Path: %s\n"
-                "Command Line Params: %s", info.lpFile, args);
-            ShowErrorWindow(errorBoxTitle, errorText);
-            return -1;
-        }
-        if (exitCode)
-        {
-            std::string errorBoxTitle = ToString("Program Exited with Code: %i", exitCode);
-            std::string errorText = ToString("Application Path: %s\n"
-                "Command Line Params: %s", info.lpFile, args);
-            return ShowCustomErrorWindow(errorBoxTitle, errorText);
-        }
+    case ProcessPriority_Idle:          return IDLE_PRIORITY_CLASS;
+    case ProcessPriority_BelowNormal:   return BELOW_NORMAL_PRIORITY_CLASS;
+    case ProcessPriority_AboveNormal:   return ABOVE_NORMAL_PRIORITY_CLASS;
+    case ProcessPriority_High:          return HIGH_PRIORITY_CLASS;
     }
-    return 0;
+    return NORMAL_PRIORITY_CLASS;
+}
+
+//Only cores that this process is allowed to run on can be handed to the child
+DWORD_PTR UsableAffinityMask(u64 mask)
+{
+    DWORD_PTR processMask = {};
+    DWORD_PTR systemMask = {};
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+        return 0;
+    return DWORD_PTR(mask) & processMask;
+}
+
+HANDLE CreateLimitedJobObject(const ProcessSettings& process)
+{
+    HANDLE job = CreateJobObjectA(NULL, NULL);
+    if (job == NULL)
+        return NULL;
+
+    JOBOBJECT_EXTENDED_LIMIT_INFORMATION limits = {};
+    //NOTE(CSH): raising the priority through the job needs SeIncreaseBasePriorityPrivilege,
+    //above normal is only applied to the first process through CreateProcess
+    if (process.priority < ProcessPriority_Normal)
+    {
+        limits.BasicLimitInformation.LimitFlags |= JOB_OBJECT_LIMIT_PRIORITY_CLASS;
+        limits.BasicLimitInformation.PriorityClass = PriorityClassFromSetting(process.priority);
+    }
+    DWORD_PTR affinity = UsableAffinityMask(process.affinityMask);
+    if (affinity)
+    {
+        limits.BasicLimitInformation.LimitFlags |= JOB_OBJECT_LIMIT_AFFINITY;
+        limits.BasicLimitInformation.Affinity = affinity;
+    }
+    if (process.memoryLimitMB > 0)
+    {
+        limits.BasicLimitInformation.LimitFlags |= JOB_OBJECT_LIMIT_JOB_MEMORY;
+        limits.JobMemoryLimit = SIZE_T(process.memoryLimitMB) * 1024 * 1024;
+    }
+    if (!SetInformationJobObject(job, JobObjectExtendedLimitInformation, &limits, sizeof(limits)))
+        SDL_Log("SetInformationJobObject limits failed: %i", GetLastError());
+
+    if (process.cpuRatePercent > 0)
+    {
+        //CpuRate is in 1/100ths of a percent of the whole machine
+        JOBOBJECT_CPU_RATE_CONTROL_INFORMATION rate = {};
+        rate.ControlFlags = JOB_OBJECT_CPU_RATE_CONTROL_ENABLE | JOB_OBJECT_CPU_RATE_CONTROL_HARD_CAP;
+        rate.CpuRate = Clamp<s32>(process.cpuRatePercent, 1, 100) * 100;
+        if (!SetInformationJobObject(job, JobObjectCpuRateControlInformation, &rate, sizeof(rate)))
+            SDL_Log("SetInformationJobObject cpu rate failed: %i", GetLastError());
+    }
+    return job;
+}
+
+//Programs, scripts and cmd commands are started by cmd itself, documents, shortcuts and urls need the file
+//associations. Only the first word of path is looked at, names without an extension are left to cmd
+bool IsDirectlyRunnable(std::string_view path)
+{
+    std::string_view program = path;
+    if (program.size() && program[0] == '"')
+    {
+        program.remove_prefix(1);
+        program = program.substr(0, program.find('"'));
+    }
+    else
+    {
+        program = program.substr(0, program.find(' '));
+    }
+    if (program.find("://") != std::string_view::npos)
+        return false;
+    size_t dot = program.find_last_of(".\\/");
+    if (dot == std::string_view::npos || program[dot] != '.')
+        return true;
+    std::string_view extension = program.substr(dot);
+    const char* runnable[] = { ".exe", ".bat", ".cmd", ".com" };
+    for (const char* r : runnable)
+    {
+        if (extension.size() == strlen(r) && _strnicmp(extension.data(), r, extension.size()) == 0)
+            return true;
+    }
+    return false;
+}
+
+s32 RunProcess(const char* path, const char* args, const ProcessSettings& process, ProcessMonitor* monitor)
+{
+    //nothing to limit or watch, ShellExecute also opens files that aren't programs
+    if (!monitor && process == ProcessSettings())
+        return RunProcess(path, args, false);
+
+    //NOTE(CSH): going through cmd to keep the ShellExecute behavior for .bat files and the console window,
+    // the process is started suspended so it is in the job object before it can start any children
+    std::string commandLine = "cmd.exe";
+    if (path || args)
+    {
+        commandLine += " /S /C \"";
+        if (path && !IsDirectlyRunnable(path))
+            commandLine += "start \"\" /WAIT "; //the associated program is started by cmd so it is still in the job
+        if (path)
+            commandLine += path;
+        if (path && args)
+            commandLine += ' ';
+        if (args)
+            commandLine += args;
+        commandLine += '\"';
+    }
+
+    HANDLE job = NULL;
+    if (process.useJobObject)
+        job = CreateLimitedJobObject(process);
+    else if (monitor)
+        job = CreateJobObjectA(NULL, NULL); //no limits, only used to stop the process tree
+    DEFER
+    {
+        if (job)
+            CloseHandle(job);
+    };
+
+    STARTUPINFOA startupInfo = {};
+    startupInfo.cb = sizeof(startupInfo);
+    PROCESS_INFORMATION processInfo = {};
+    DWORD creationFlags = CREATE_SUSPENDED | CREATE_NEW_CONSOLE | PriorityClassFromSetting(process.priority);
+    if (!CreateProcessA(NULL, commandLine.data(), NULL, NULL, FALSE, creationFlags, NULL, NULL, &startupInfo, &processInfo))
+    {
+        std::string errorBoxTitle = ToString("CreateProcess Error: %i", GetLastError());
+        std::string errorText     = ToString("Application Path: %s\n"
+                                             "Command Line Params: %s", path, args);
+        ShowErrorWindow(errorBoxTitle, errorText);
+        assert(false);
+        return 2;
+    }
+    DEFER
+    {
+        CloseHandle(processInfo.hThread);
+        CloseHandle(processInfo.hProcess);
+    };
+
+    if (job && !AssignProcessToJobObject(job, processInfo.hProcess))
+    {
+        SDL_Log("AssignProcessToJobObject failed: %i", GetLastError());
+        CloseHandle(job);
+        job = NULL;
+    }
+    if (!job || !process.useJobObject)
+    {
+        DWORD_PTR affinity = UsableAffinityMask(process.affinityMask);
+        if (affinity)
+            SetProcessAffinityMask(processInfo.hProcess, affinity);
+    }
+    ResumeThread(processInfo.hThread);
+
+    return WaitForProcess(processInfo.hProcess, job, path, args, monitor);
 }
 
 void StartProcessJob::RunJob()
 {
     const char* path = applicationPath.size()   ? applicationPath.c_str()   : nullptr;
     const char* args = arguments.size()         ? arguments.c_str()         : nullptr;
-    s32 result = RunProcess(path, args);
+    s32 result = RunProcess(path, args, process);
     if (result)
     {
         Threading::GetInstance().ClearJobs();
@@ -95,9 +292,22 @@ void StartProcessJob::RunJob()
 
 void RunUATJob::RunJob()
 {
+    if (run && run->artifactState == ArtifactState_Restored)
+        return;
     const char* path = applicationPath.size()   ? applicationPath.c_str()   : nullptr;
-    const char* args = arguments.size()         ? arguments.c_str()         : nullptr;
-    s32 result = RunProcess(path, args);
+    std::string fullArguments = arguments;
+    if (run)
+        fullArguments += run->extraArguments;
+    const char* args = fullArguments.size()     ? fullArguments.c_str()     : nullptr;
+    s32 hostSlot = AcquireHostBuildSlot(hostBudget, process.useJobObject ? process.memoryLimitMB : 0, run ? &run->cancelled : nullptr);
+    DEFER { ReleaseHostBuildSlot(hostSlot); };
+    if (hostSlot == hostSlotCancelled)
+    {
+        Threading::GetInstance().ClearJobs();
+        return;
+    }
+    UATLogMonitor monitor(run, rootPath);
+    s32 result = RunProcess(path, args, process, &monitor);
     if (result)
     {
         Threading::GetInstance().ClearJobs();
@@ -189,6 +399,12 @@ s32 ShowCustomErrorWindow(const std::string& title, const std::string& text)
     return buttonID;
 }
 
+bool ShowQuestionWindow(const std::string& title, const std::string& text)
+{
+    int msgboxID = MessageBox(NULL, text.c_str(), title.c_str(), MB_YESNO | MB_ICONQUESTION | MB_APPLMODAL);
+    return msgboxID == IDYES;
+}
+
 void ShowErrorWindow(const std::string& title, const std::string& text)
 {
 #if 1
@@ -1,17 +1,37 @@
 #pragma once
 #include "Threading.h"
+#include "Config.h"
 #include "SDL.h"
 #include "imgui.h"
 
+#include <memory>
 #include <string>
 
+//Gets polled from the thread waiting on a process started by RunProcess
+struct ProcessMonitor
+{
+    std::string abortReason;
+
+    virtual ~ProcessMonitor() = default;
+    //Called periodically while the process runs and once after it exited,
+    //returning false kills the whole process tree and reports abortReason
+    virtual bool Poll() = 0;
+    //Returning false skips the error popup for a non zero exit code or an abort
+    virtual bool ShowExitCodeError()
+    {
+        return true;
+    }
+};
+
 std::string ToString(const char* fmt, ...);
 s32         RunProcess(const char* path, const char* args = nullptr, bool async = false);
+s32         RunProcess(const char* path, const char* args, const ProcessSettings& process, ProcessMonitor* monitor = nullptr);
 void        InitOS(SDL_Window* window);
 
 static bool keepOpen = true;
 void ShowErrorWindow        (const std::string& title, const std::string& text);
 s32 ShowCustomErrorWindow  (const std::string& title, const std::string& text);
+bool ShowQuestionWindow     (const std::string& title, const std::string& text);
 void NotifyWindowBuildFinished();
 void ScanDirectoryForFileNames(const std::string& dir, std::vector<std::string>& out);
 bool GetDirectoryFromUser(const std::string& currentDir, std::string& dir);
@@ -27,13 +47,18 @@ struct StartProcessJob : Job
 {
     std::string applicationPath;
     std::string arguments;
+    ProcessSettings process;
     virtual void RunJob() override;
 };
 
+struct BuildRun;
 struct RunUATJob : Job
 {
     std::string applicationPath;
     std::string arguments;
     std::string rootPath;
+    ProcessSettings process;
+    HostBudget hostBudget;
+    std::shared_ptr<BuildRun> run;
     virtual void RunJob() override;
 };
@@ -15,8 +15,15 @@
 #include "Threading.h"
 #include "Config.h"
 #include "Themes.h"
+#include "BuildQueue.h"
+#include "AsyncFileWriter.h"
+#include "FrameArena.h"
+#include "AllocationTracker.h"
+#include "UI.h"
+#include "InputRecording.h"
 
 #include <stdio.h>
+#include <string.h>
 #include <string>
 #include <vector>
 
@@ -28,459 +35,18 @@
 #endif
 
 
-[[nodiscard]] inline ImVec2 HadamardProduct(const ImVec2& a, const ImVec2& b)
-{
-    return { a.x * b.x, a.y * b.y };
-}
-
-bool FindNumberInVector(const std::vector<s32>& data, const s32 val)
-{
-    for (s32 i = 0; i < data.size(); i++)
-    {
-        if (data[i] == val)
-            return true;
-    }
-    return false;
-}
-
-void RemoveNumberInVector(std::vector<s32>& data, const s32 val)
-{
-    std::erase_if(data,
-        [val](s32 a)
-        {
-            return a == val;
-        });
-}
-void RemoveNullElements(std::vector<PlatformSettings>& data)
-{
-    std::erase_if(data,
-        [](const PlatformSettings& ps)
-        {
-            return ps.name.empty();
-        });
-}
-int DynamicTextCallback(ImGuiInputTextCallbackData* data)
-{
-    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize)
-    {
-        assert(data->UserData);
-        if (!data->UserData)
-            return 1;
-        std::string* string = (std::string*)data->UserData;
-        string->resize(data->BufTextLen);
-        data->Buf = string->data();
-    }
-    return 0;
-}
-bool InputTextDynamicSize(const std::string& title, std::string& s, ImGuiInputTextFlags flags = ImGuiInputTextFlags_None)
-{
-    return ImGui::InputText(title.c_str(), s.data(), s.capacity(), flags | ImGuiInputTextFlags_CallbackResize, DynamicTextCallback, &s);
-}
-bool InputTextMultilineDynamicSize(const std::string& title, std::string& s, ImGuiInputTextFlags flags = ImGuiInputTextFlags_None)
-{
-    return ImGui::InputTextMultiline(title.c_str(), const_cast<char*>(title.data()), s.capacity(), ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 2), flags | ImGuiInputTextFlags_CallbackResize, DynamicTextCallback, &s);
-}
-
-void TextCentered(std::string text) 
-{
-    float win_width = ImGui::GetWindowSize().x;
-    float text_width = ImGui::CalcTextSize(text.c_str()).x;
-
-    // calculate the indentation that centers the text on one line, relative
-    // to window left, regardless of the `ImGuiStyleVar_WindowPadding` value
-    float text_indentation = (win_width - text_width) * 0.5f;
-
-    // if text is too long to be drawn on one line, `text_indentation` can
-    // become too small or even negative, so we check a minimum indentation
-    float min_indentation = 20.0f;
-    if (text_indentation <= min_indentation) {
-        text_indentation = min_indentation;
-    }
-
-    ImGui::SameLine(text_indentation);
-    ImGui::PushTextWrapPos(win_width - text_indentation);
-    ImGui::Text(text.c_str());
-    ImGui::PopTextWrapPos();
-}
-
-std::string* s_modifyingText = nullptr;
-std::string s_unmodifiedText;
-void OpenModifyingPrompt(std::string& s)
-{
-    if (ImGui::BeginPopupContextItem())
-    {
-        if (ImGui::Selectable("Edit"))
-        {
-            s_unmodifiedText = s;
-            s_modifyingText = &s;
-            ImGui::CloseCurrentPopup();
-        }
-
-        if (ImGui::Selectable("Delete"))
-        {
-            s.clear();
-            ImGui::CloseCurrentPopup();
-        }
-        ImGui::EndPopup();
-    }
-}
-s32* s_modifyingTextIndex = nullptr;
-void EditModifyingPromptFile(std::string& s, s32* index)
-{
-    s_unmodifiedText = s;
-    s_modifyingText = &s;
-    s_modifyingTextIndex = index;
-
-}
-//void OpenModifyingPromptFile(std::string& s, s32* index)
-//{
-//    if (ImGui::BeginPopupContextItem())
-//    {
-//        if (ImGui::Selectable("Edit"))
-//        {
-//            s_unmodifiedText = s;
-//            s_modifyingText = &s;
-//            ImGui::CloseCurrentPopup();
-//        }
-//
-//        if (ImGui::Selectable("Delete"))
-//        {
-//            s.clear();
-//            ImGui::CloseCurrentPopup();
-//        }
-//        ImGui::EndPopup();
-//    }
-//}
-
-//bool s_openConfigSelectionPopup = false;
-void SaveCurrentOrCreateNewConfig(AppSettings& appSettings, Settings& settings)
-{
-    if (appSettings.fileNames.size())
-    {
-        if (appSettings.currentFileNameIndex >= 0 && appSettings.currentFileNameIndex < appSettings.fileNames.size())
-        {
-            SaveConfig(settings, appSettings.fileNames[appSettings.currentFileNameIndex]);
-            LoadConfig(settings, appSettings);//clear any out of bounds indices
-        }
-        else
-        {
-            std::string blah;
-            appSettings.fileNames.push_back(blah);
-            appSettings.currentFileNameIndex = s32(appSettings.fileNames.size() - 1);
-            EditModifyingPromptFile(appSettings.fileNames[appSettings.currentFileNameIndex], &appSettings.currentFileNameIndex);
-        }
-    }
-    else
-    {
-        std::string blah;
-        appSettings.fileNames.push_back(blah);
-        appSettings.currentFileNameIndex = s32(appSettings.fileNames.size() - 1);
-        EditModifyingPromptFile(appSettings.fileNames[appSettings.currentFileNameIndex], &appSettings.currentFileNameIndex);
-    }
-}
-bool GetStringFromSTDVector(void* data, int idx, const char** out_text)
-{
-    if (!data)
-        return false;
-    
-    std::vector<std::string>* d = (std::vector<std::string>*)data;
-    if (idx <= d->size())
-        return false;
-    
-    *out_text = (*d)[idx].c_str();
-    return true;
-}
-
-
-
-bool NameStatusButtonAdd(const std::string& buttonName, std::string& text, float length = 125.0f)
-{
-    ImGui::SameLine();
-    std::string id = "##" + buttonName;
-    float buttonSize = 25.0f;
-#if 1
-    float availableWidth = ImGui::GetContentRegionAvail().x;
-    if (availableWidth < length)
-    {
-        ImGui::NewLine();
-    }
-#else
-    float inputSize = 20.0f;
-    //Scaling input size based on region left
-    float availableWidth = ImGui::GetContentRegionAvail().x;
-    if (availableWidth < inputSize)
-    {
-        ImGui::NewLine();
-    }
-    availableWidth = ImGui::GetContentRegionAvail().x;
-    inputSize = availableWidth * 0.25f
-#endif
-    ImGui::SetNextItemWidth(length - buttonSize);
-    InputTextDynamicSize(id, text);
-    ImGui::SameLine();
-    std::string fullButtonName = "Add##" + buttonName;
-    return ImGui::Button(fullButtonName.c_str()) && text.size();
-}
-
-void RemoveStartAndEndSpaces(std::string& s)
-{
-    while (s[0] == ' ')
-    {
-        s.erase(0, 1);
-    }
-    while (s[s.size() - 1] == ' ')
-    {
-        s.erase(s.size() - 1, 1);
-    }
-}
-
-void ExecutionSection(const std::string& sectionTitle, BuildEvents& be, std::vector<s32>& enables, std::string& inputString)
-{
-    std::string sectionTitleEvents = sectionTitle + " Events:";
-    //ImGui::SetNextItemOpen(true, ImGuiCond_FirstUseEver);
-    ImGui::SetNextItemOpen(true, ImGuiCond_Once);
-    if (ImGui::TreeNode(sectionTitleEvents.c_str()))
-    {
-        DEFER{ ImGui::TreePop(); };
-        bool inputSuccess = false;
-        std::string textInputTitle = "##" + sectionTitle + " Event";
-        inputSuccess |= InputTextDynamicSize(textInputTitle.c_str(), inputString, ImGuiInputTextFlags_EnterReturnsTrue);
-        ImGui::SameLine();
-        inputSuccess |= ImGui::Button("Add");
-        if (inputSuccess)
-        {
-            if (inputString.size())
-            {
-                RemoveStartAndEndSpaces(inputString);
-                if (inputString.size())
-                {
-                    be.Add(inputString);
-                    inputString.clear();
-                }
-            }
-        }
-        if (be.m_events.size() == 0)
-            return;
-
-
-        ImGuiTableFlags tableFlags =
-            ImGuiTableFlags_RowBg |
-            ImGuiTableFlags_BordersV |
-            ImGuiTableFlags_BordersOuterV |
-            ImGuiTableFlags_BordersInnerV |
-            ImGuiTableFlags_BordersH |
-            ImGuiTableFlags_BordersOuterH |
-            ImGuiTableFlags_BordersInnerH |
-            ImGuiTableFlags_ScrollX |
-            ImGuiTableFlags_ScrollY;
-            //ImGuiTableFlags_NoSavedSettings;
-
-        //NOTE(CSH): 1 larger than the array to have size leftover for the horizontal scroll bar
-        //capping the height at 5 so you can see the top row while scrolling horizontally
-        //TODO: change the max height to varry with the size of the child window
-        const int maxTableHeight = 5;
-        ImVec2 tableSize = ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * (Min(maxTableHeight, (int)be.m_events.size()) + 1)); 
-        const int tableColumnCount = 2;
-        if (ImGui::BeginTable("table_advanced", tableColumnCount, tableFlags, tableSize, 0.0f))
-        {
-            DEFER{ ImGui::EndTable(); };
-
-            const ImGuiTableColumnFlags columnFlags = ImGuiTableColumnFlags_WidthFixed;
-            float longestText = 0;
-            for (const auto& item : be.m_events)
-            {
-                if (item.name.empty())
-                    continue;
-                ImVec2 textSize = ImGui::CalcTextSize(item.name.c_str());
-                longestText = Max(longestText, textSize.x);
-            }
-            ImGui::TableSetupScrollFreeze(1, 0);
-            ImGui::TableSetupColumn("Status",   columnFlags | ImGuiTableColumnFlags_NoHide);
-            ImGui::TableSetupColumn("String",   columnFlags, longestText);
-
-            //ImGui::PushButtonRepeat(true);
-            {
-                for (int row_n = 0; row_n < be.m_events.size(); row_n++)
-                {
-                    if (be.m_events[row_n].name.empty())
-                        continue;
-                    auto item = be.m_events[row_n];
-
-                    ImGui::PushID(item.name.c_str());
-                    DEFER{ ImGui::PopID(); };
-
-                    ImGui::TableNextRow(ImGuiTableRowFlags_None, 0);
-                    if (ImGui::TableSetColumnIndex(0))
-                    {
-                        std::string buttonLabel = "Disabled";
-                        float color = 0.0f;
-                        const bool enabled = FindNumberInVector(enables, item.id);
-                        if (enabled)
-                        {
-                            color = 2.0f / 7.0f;
-                            buttonLabel = "Enabled";
-                        }
-                        
-                        ImGui::PushStyleColor(ImGuiCol_Button,          (ImVec4)ImColor::HSV(color, 0.6f, 0.6f));
-                        ImGui::PushStyleColor(ImGuiCol_ButtonHovered,   (ImVec4)ImColor::HSV(color, 0.7f, 0.7f));
-                        ImGui::PushStyleColor(ImGuiCol_ButtonActive,    (ImVec4)ImColor::HSV(color, 0.8f, 0.8f));
-                        if (ImGui::SmallButton(buttonLabel.c_str()))
-                        {
-                            if (enabled)
-                                RemoveNumberInVector(enables, item.id);
-                            else
-                                enables.push_back(item.id);
-                        }
-                        ImGui::PopStyleColor(3);
-                    }
-
-
-                    ImGui::TableSetColumnIndex(1);
-                    ImGuiSelectableFlags selectable_flags = ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowItemOverlap;
-                    ImGui::Selectable(item.name.c_str(), false, selectable_flags, ImVec2(0, 0));
-                    if (ImGui::IsItemActive() && !ImGui::IsItemHovered())
-                    {
-                        int nextIndex = row_n + (ImGui::GetMouseDragDelta(0).y < 0.f ? -1 : 1);
-                        if (nextIndex >= 0 && nextIndex < be.m_events.size())
-                        {
-                            be.m_events[row_n] = be.m_events[nextIndex];
-                            be.m_events[nextIndex] = item;
-                            ImGui::ResetMouseDragDelta();
-                        }
-                    }
-                    OpenModifyingPrompt(be.m_events[row_n].name);
-                }
-            }
-        }
-        be.RemoveNullElements();
-    }
-}
-
-bool SeperatePathAndArguments(const std::string& input, std::string& path, std::string& args)
-{
-    char charSeperator = ' ';
-    if (input[0] == '\"')
-    {
-        charSeperator = '\"';
-    }
-    //look for end quote or space
-    s32 i = 1;
-    for (; i < input.size(); i++)
-    {
-        if (input[i] == charSeperator)
-            break;
-    }
-#if 0
-    //NOTE(CSH): finding if there is an included name without a '-' after the exe name.
-    //This needs to be included in the path not the args
-    if (charSeperator == ' ')
-    {
-        for (; i < input.size() && input[i] != '-'; i++)
-        { }
-        if (input[i] == '-')
-            i--;
-    }
-#endif
-    s32 maxValue = Min<s32>((s32)input.size(), i + 1);
-    path = input.substr(0, maxValue);
-    if (maxValue == input.size())
-    {
-        args.clear();
-        return false;
-    }
-
-    args = input.substr(maxValue,   input.size() - (maxValue));
-    return true;
-}
-
-void WrapInQuotes(std::string& s)
-{
-    if (s.size())
-    {
-        if (s[0] != '\"')
-            s = '\"' + s;
-        if (s[s.size() - 1] != '\"')
-            s = s + '\"';
-    }
-}
-
-void SubmitProcessSingle(const std::string& name, Threading& thread)//, bool keepAlive)
-{
-    //TODO: Make this function and surrounding code more robust
-
-    if (name.size() < 2)
-    {
-        ShowErrorWindow("RunProcess Error", "Trying to run process with path.size() < 2");
-        assert(false);
-        return;
-    }
-
-    StartProcessJob* job = new StartProcessJob();
-    SeperatePathAndArguments(name, job->applicationPath, job->arguments);
-    thread.SubmitJob(job);
-}
-
-void SubmitProcessList(const BuildEvents& be, const std::vector<s32>& enabledIDs, Threading& thread)
-{
-    for (s32 i = 0; i < enabledIDs.size(); i++)
-    {
-        BuildEvent b;
-        if (be.Get(b, enabledIDs[i]))
-        {
-            SubmitProcessSingle(b.name, thread);
-        }
-    }
-}
 
-void CleanPathString(std::string& s)
-{
-    size_t pos = s.find('\\');
-    while (pos != std::string::npos)
-    {
-        s.replace(pos, 1, "/", 1);
-        pos = s.find('\\');
-    }
-}
-
-void HelpMarker(const std::string& desc)
+// Main code
+int main(int argc, char** argv)
 {
-    ImGui::TextDisabled("(?)");
-    if (ImGui::IsItemHovered())
+    //NOTE(CSH): -record <file> saves the input of this session for UATHelperBench replay
+    const char* recordFile = nullptr;
+    for (s32 i = 1; i + 1 < argc; i++)
     {
-        ImGui::BeginTooltip();
-        ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
-        ImGui::TextUnformatted(desc.c_str());
-        ImGui::PopTextWrapPos();
-        ImGui::EndTooltip();
+        if (strcmp(argv[i], "-record") == 0)
+            recordFile = argv[i + 1];
     }
-}
-
-bool GetCStringFromPlatformSettings(void* data, int idx, const char** out_text)
-{
-    if (!data)
-        return false;
-    const std::vector<PlatformSettings>& d = *(std::vector<PlatformSettings>*)data;
-    if (idx >= d.size())
-        return false;
-    if (d[idx].name.empty())
-        return false;
-    *out_text = d[idx].name.c_str();
-    return true;
-}
-
-bool GetCStringFromThemes(void* data, int idx, const char** out_text)
-{
-    if (!data)
-        return false;
-    const Theme* d = (Theme*)data;
-    *out_text = d[idx].name;
-    return true;
-}
-
 
-// Main code
-int main(int, char**)
-{
     // Setup SDL
     // (Some versions of SDL before <2.0.10 appears to have performance/stalling issues on a minority of Windows systems,
     // depending on whether SDL_INIT_GAMECONTROLLER is enabled or disabled.. updating to latest version of SDL is recommended!)
@@ -553,7 +119,6 @@ int main(int, char**)
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     io.IniFilename = NULL;
-    ImGuiStyle& style = ImGui::GetStyle();
     //io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     // Enable Keyboard Controls
     //io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
 
@@ -574,6 +139,7 @@ int main(int, char**)
     }
 
 
+
     //ImFont* mainFont = io.Fonts->AddFontFromFileTTF("Assets/DroidSans.ttf", 16);
     //io.Fonts->Build();
 
@@ -592,21 +158,32 @@ int main(int, char**)
     //ImFont* font = io.Fonts->AddFontFromFileTTF("c:\\Windows\\Fonts\\ArialUni.ttf", 18.0f, NULL, io.Fonts->GetGlyphRangesJapanese());
     //IM_ASSERT(font != NULL);
 
-    std::string finalCommandLine;
-    bool buildRunning = false;
-    bool show_demo_window = false;
-    bool exitProgram = false;
-    bool keepProcessWindowAlive = true;
+    BuildQueue buildQueue;
+    buildQueue.Load();
+
+    InputRecording recording;
+    if (recordFile)
+    {
+        Settings recorded = settings;
+        recording.config = WriteConfigText(recorded);
+        recording.appSettings = WriteAppSettingsText(appSettings);
+        recording.buildQueue = WriteBuildQueueText(buildQueue.m_requests);
+        recording.buildQueuePaused = buildQueue.m_paused;
+        SDL_GetWindowSize(window, &recording.windowWidth, &recording.windowHeight);
+    }
+    UIState ui;
     ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
     u64 frameStartTicks = 0;
+    AllocationCounts frameStartAllocations;
 
     // Main loop
-    bool done = false;
-    while (!done)
+    while (!ui.done)
     {
         {
             ZoneScopedN("Frame Update:");
             frameStartTicks = SDL_GetTicks64();
+            FrameArena::GetInstance().Reset();
+            frameStartAllocations = GetThreadAllocations();
             // Poll and handle events (inputs, window resize, etc.)
             // You can read the io.WantCaptureMouse, io.WantCaptureKeyboard flags to tell if dear imgui wants to use your inputs.
             // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application, or clear/overwrite your copy of the mouse data.
@@ -616,17 +193,23 @@ int main(int, char**)
                 ZoneScopedN("Poll Events");
                 SDL_Event event;
                 u64 i = 0;
+                if (recordFile)
+                    recording.BeginFrame();
                 while (SDL_PollEvent(&event))
                 {
                     i++;
+                    if (recordFile)
+                        recording.Add(event);
                     ImGui_ImplSDL2_ProcessEvent(&event);
                     if (event.type == SDL_QUIT)
-                        exitProgram = true;
+                        ui.exitProgram = true;
                     if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE && event.window.windowID == SDL_GetWindowID(window))
-                        exitProgram = true;
+                        ui.exitProgram = true;
                 }
-                std::string r = ToString("Poll Events Count: %i", i);
-                TracyMessage(r.c_str(), r.size());
+#ifdef TRACY_ENABLE
+                const char* r = FrameFormat("Poll Events Count: %llu", i);
+                TracyMessage(r, strlen(r));
+#endif
             }
 
 
@@ -637,648 +220,10 @@ int main(int, char**)
                 ImGui_ImplSDL2_NewFrame();
                 ImGui::NewFrame();
                 //ImGui::PushFont(mainFont);
+                if (recordFile)
+                    recording.SetFrameDeltaTime(io.DeltaTime);
             }
-#if 1
-            if (buildRunning && threading.GetJobsInFlight() == 0)
-            {
-                //BuildFinished
-                NotifyWindowBuildFinished();
-            }
-            buildRunning = threading.GetJobsInFlight();
-#else
-            if (!threading.GetJobsInFlight())
-                buildRunning = false;
-#endif
-
-
-            const ImGuiViewport* viewport = ImGui::GetMainViewport();
-            ImGui::SetNextWindowPos(viewport->WorkPos, ImGuiCond_Always, {});
-            ImGui::SetNextWindowSize(viewport->WorkSize, ImGuiCond_Always);
-            ImGui::SetNextWindowBgAlpha(1.0f); // Transparent background
-            ImGuiWindowFlags windowFlags =
-                //ImGuiWindowFlags_NoBackground |
-#if 0
-                ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoCollapse |
-#else
-                ImGuiWindowFlags_NoDecoration |
-#endif
-                ImGuiWindowFlags_MenuBar |
-                ImGuiWindowFlags_NoSavedSettings |
-                ImGuiWindowFlags_NoFocusOnAppearing |
-                ImGuiWindowFlags_NoNav |
-                ImGuiWindowFlags_NoMove;
-
-            if (ImGui::Begin("Main", nullptr, windowFlags))
-            {
-                ZoneScopedN("Main");
-                if (ImGui::BeginMenuBar())
-                {
-                    if (ImGui::BeginMenu("App Settings"))
-                    {
-                        ZoneScopedN("App Settings");
-                        ImGui::Text("Color:");
-                        ImGui::SameLine();
-                        ImGui::SetNextItemWidth(100);
-                        s32 colorSelection = appSettings.colorSelection;
-                        if (ImGui::Combo("##Color", &appSettings.colorSelection, GetCStringFromThemes, &ColorOptions, (s32)Color_Count))
-                        {
-                            if (colorSelection != appSettings.colorSelection)
-                            {
-                                Color_Set(appSettings.colorSelection);
-                                SaveAppSettings(appSettings);
-                            }
-                        }
-                        ImGui::Text("Style:");
-                        ImGui::SameLine();
-                        ImGui::SetNextItemWidth(100);
-                        s32 styleSelection = appSettings.styleSelection;
-                        if (ImGui::Combo("##Style", &appSettings.styleSelection, GetCStringFromThemes, &StyleOptions, (s32)Style_Count))
-                        {
-                            if (styleSelection != appSettings.styleSelection)
-                            {
-                                Style_Set(appSettings.styleSelection);
-                                SaveAppSettings(appSettings);
-                            }
-                        }
-                        ImGui::Text("UPS:");
-                        ImGui::SameLine();
-                        HelpMarker("This changes the updates per second of the application");
-                        ImGui::SameLine();
-                        ImGui::SetNextItemWidth(90.0f);
-                        if (ImGui::InputFloat("##Updates Per Second", &appSettings.UPS, 1.0f, 10.0f, "%.1f"))
-                        {
-                            SaveAppSettings(appSettings);
-                        }
-                        ImGui::EndMenu();
-                    }
-                    if (ImGui::BeginMenu("Config"))
-                    {
-                        ZoneScopedN("Config");
-                        if (ImGui::MenuItem("Save"/*, "Ctrl+S"*/))
-                        {
-                            SaveCurrentOrCreateNewConfig(appSettings, settings);
-                            //SaveAppSettings(appSettings);
-                        }
-                        if (ImGui::BeginMenu("Load"))
-                        {
-                            if (appSettings.fileNames.size() == 0)
-                            {
-                                ImGui::BeginDisabled();
-                                ImGui::Text("No Config Files Found");
-                                ImGui::EndDisabled();
-                            }
-                            else
-                            {
-                                for (s32 i = 0; i < appSettings.fileNames.size(); i++)
-                                {
-                                    bool selected = (i == appSettings.currentFileNameIndex);
-                                    if (ImGui::MenuItem(appSettings.fileNames[i].substr(9, appSettings.fileNames[i].size() - 9 - 5).c_str(), NULL, selected))
-                                    {
-                                        appSettings.currentFileNameIndex = i;
-                                        LoadConfig(settings, appSettings);
-                                        SaveAppSettings(appSettings);
-                                    }
-                                }
-                            }
-                            ImGui::EndMenu();
-                        }
-                        if (ImGui::MenuItem("New"))
-                        {
-                            appSettings.currentFileNameIndex = -1;
-                            SaveCurrentOrCreateNewConfig(appSettings, settings);
-                        }
-                        if (ImGui::MenuItem("Clear"))
-                        {
-                            ClearConfig(settings);
-                        }
-                        if (ImGui::MenuItem("Change Directory"))
-                        {
-                            std::string dir;
-                            if (GetDirectoryFromUser(appSettings.configDirectory, dir))
-                            {
-                                appSettings.configDirectory = dir;
-                                SaveAppSettings(appSettings);
-                            }
-                        }
-                        if (ImGui::MenuItem("Open Current File"))
-                        {
-                            if (appSettings.fileNames.size() && appSettings.currentFileNameIndex >= 0 && appSettings.currentFileNameIndex < appSettings.fileNames.size())
-                            {
-                                std::string filePath = appSettings.fileNames[appSettings.currentFileNameIndex];
-                                if (appSettings.configDirectory.size())
-                                    filePath = appSettings.configDirectory + "/" + filePath;
-                                RunProcess(filePath.c_str(), nullptr, true);
-                            }
-                        }
-                        ImGui::EndMenu();
-                    }
-                    if (ImGui::BeginMenu("About"))
-                    {
-                        ZoneScopedN("About");
-                        ImGui::Text(ToString("Version: %i.%02i", appSettings.majorRev, appSettings.minorRev).c_str());
-                        if (ImGui::MenuItem("Github Releases"))
-                            RunProcess("https://github.com/CharlesHenryVIII/UATHelper/releases", nullptr, true);
-                        ImGui::EndMenu();
-                    }
-                    ImGui::EndMenuBar();
-                }
-                ImGuiWindowFlags sectionFlags =
-                    ImGuiWindowFlags_NoResize |
-                    ImGuiWindowFlags_NoSavedSettings |
-                    ImGuiWindowFlags_NoCollapse |
-                    ImGuiWindowFlags_NoFocusOnAppearing |
-                    ImGuiWindowFlags_NoMove;
-
-                f32 xScale = 1.0f;
-                float topWindowHeightScale = 0.12f;
-                ImVec2 locationScale = { xScale / 2, topWindowHeightScale };
-                ImVec2 locationSize = HadamardProduct(viewport->WorkSize, locationScale);
-                locationSize.x -= 1.5f * style.WindowPadding.x;
-                if (ImGui::BeginChild("File Paths", locationSize, true, sectionFlags | ImGuiWindowFlags_NoScrollbar))
-                {
-                    ZoneScopedN("File Paths");
-#ifdef DEBUG
-                    ImGui::Checkbox("Show Demo Window", &show_demo_window);
-                    ImGui::SameLine();
-#endif
-                    TextCentered("File Paths");
-
-                    ImGui::Text("Main Directory");
-                    ImGui::SameLine();
-                    std::string demoMainDir = "C:/UnrealEngine/Project/";
-                    HelpMarker(demoMainDir);
-                    ImGui::SameLine();
-                    ImGui::PushItemWidth(-FLT_MIN);
-                    InputTextDynamicSize("##" + demoMainDir, settings.rootPath);
-                    CleanPathString(settings.rootPath);
-                    if (settings.rootPath.size() && settings.rootPath[settings.rootPath.size() - 1] != '/')
-                        settings.rootPath = settings.rootPath + '/';
-
-                    ImGui::Text("Path to .uproject");
-                    std::string demoProjectPath = "C:/UnrealEngine/Project/Title/title.uproject";
-                    ImGui::SameLine();
-                    HelpMarker(demoProjectPath);
-                    ImGui::SameLine();
-                    InputTextDynamicSize("##" + demoProjectPath, settings.projectPath);
-                    CleanPathString(settings.projectPath);
-                }
-                ImGui::EndChild();
-                ImGui::SameLine();
-
-                ImVec2 platformScale = { xScale / 2, topWindowHeightScale };
-                ImVec2 platformSize = HadamardProduct(viewport->WorkSize, platformScale);
-                platformSize.x -= 1.5f * style.WindowPadding.x;
-                if (ImGui::BeginChild("Grouping", platformSize, true, sectionFlags))
-                {
-                    ZoneScopedN("Grouping");
-                    ImGui::Text("Platform Selection");
-                    ImGui::SameLine();
-                    HelpMarker("input build platforms you want, i.e. \"XSX\" or \"win32\" just without the quotes and only one per entry");
-                    ImGui::SameLine();
-                    ImGui::SetNextItemWidth(150);
-                    ImGui::Combo("##Platform Selection", &settings.platformSelection, GetCStringFromPlatformSettings,
-                        &settings.platformOptions, (s32)settings.platformOptions.size());
-                    static std::string platformAddText;
-                    if (NameStatusButtonAdd("Platform", platformAddText))
-                    {
-                        settings.platformOptions.push_back({ platformAddText });
-                        if (settings.platformOptions.size() == 1)
-                            settings.platformSelection = 0;
-                        platformAddText.clear();
-                    }
-                    ImGui::SameLine();
-                    if (ImGui::Button("Delete## Platform"))
-                    {
-                        settings.platformOptions[settings.platformSelection].name.clear();
-                        settings.platformSelection = Max(settings.platformSelection--, 0);
-                        RemoveNullElements(settings.platformOptions);
-                    }
-
-                    ImGui::Text("Version Selection");
-                    ImGui::SameLine();
-                    HelpMarker("input versions you want to build, i.e. \"Test\" or \"Development\" just without the quotes and only one per entry");
-                    ImGui::SameLine();
-                    static std::string versionInputName;
-                    if (NameStatusButtonAdd("Version", versionInputName))
-                    {
-                        settings.versionOptions.push_back({ versionInputName });
-                        versionInputName.clear();
-                    }
-                    ImGui::NewLine();
-                    float window_visible_x2 = ImGui::GetWindowPos().x + ImGui::GetWindowContentRegionMax().x;
-                    float last_button_x2 = 0;
-                    ImGuiStyle& style = ImGui::GetStyle();
-                    for (int i = 0; i < settings.versionOptions.size(); i++)
-                    {
-                        if (settings.versionOptions[i].empty())
-                            continue;
-                        //if youre hovering over itups
-                        float button_szx = ImGui::CalcTextSize(settings.versionOptions[i].c_str()).x + 2 * style.FramePadding.x;
-                        float next_button_x2 = last_button_x2 + style.ItemSpacing.x + button_szx;
-                        if (next_button_x2 < window_visible_x2)
-                            ImGui::SameLine(0, 1);
-
-                        bool found = (settings.platformSelection < settings.platformOptions.size()) ? FindNumberInVector(settings.platformOptions[settings.platformSelection].enabledVersions, i) : false;
-                        bool checkbox = found;
-                        ImGui::Checkbox(settings.versionOptions[i].c_str(), &checkbox);
-                        if (checkbox != found)
-                        {
-                            if (found)
-                                RemoveNumberInVector(settings.platformOptions[settings.platformSelection].enabledVersions, i);
-                            else
-                            {
-                                if (settings.platformSelection < settings.platformOptions.size())
-                                    settings.platformOptions[settings.platformSelection].enabledVersions.push_back(i);
-                            }
-                        }
-                        last_button_x2 = ImGui::GetItemRectMax().x;
-                        OpenModifyingPrompt(settings.versionOptions[i]);
-                    }
-                }
-                ImGui::EndChild();
-
-                ImVec2 switchesScale = { 0, 0.2f };
-                ImVec2 switchesSize = HadamardProduct(viewport->WorkSize, switchesScale);
-                if (ImGui::BeginChild("Switches", switchesSize, true, sectionFlags))
-                {
-                    ZoneScopedN("Switches");
-                    TextCentered("Switch Selection");
-                    ImGui::SameLine();
-                    HelpMarker("Added switches for build here, excluding the starting \"-\"(dash)");
-                    ImGui::NewLine();
-                    static std::string localUniqueName;
-                    if (NameStatusButtonAdd("Switch", localUniqueName, 400.0f))
-                    {
-                        if (localUniqueName.size())
-                        {
-                            if (localUniqueName[0] == '-')
-                                localUniqueName.erase(0, 1);
-                            settings.switchOptions.push_back({ localUniqueName });
-                            localUniqueName.clear();
-                        }
-                    }
-                    ImGui::SameLine();
-                    if (ImGui::Button("Copy Active Switches"))
-                    {
-                        std::string s;
-                        for (int i = 0; i < settings.switchOptions.size(); i++)
-                        {
-                            if (!settings.switchOptions[i].size())
-                                continue;
-                            s = s + "-" + settings.switchOptions[i] + " ";
-                        }
-                        if (s.size())
-                        {
-                            s.erase(s.size() - 1);
-                            SDL_SetClipboardText(s.c_str());
-                        }
-                    }
-                    ImGui::NewLine();
-                    float window_visible_x2 = ImGui::GetWindowPos().x + ImGui::GetWindowContentRegionMax().x;
-                    float last_button_x2 = 0;
-                    ImGuiStyle& style = ImGui::GetStyle();
-                    for (int i = 0; i < settings.switchOptions.size(); i++)
-                    {
-                        if (!settings.switchOptions[i].size())
-                            continue;
-
-                        float button_szx = ImGui::CalcTextSize(settings.switchOptions[i].c_str()).x + 2 * style.FramePadding.x;
-                        float next_button_x2 = last_button_x2 + style.ItemSpacing.x + button_szx;
-                        if (next_button_x2 < window_visible_x2)
-                            ImGui::SameLine(0, 1);
-                        
-                        bool found = (settings.platformSelection < settings.platformOptions.size()) ? FindNumberInVector(settings.platformOptions[settings.platformSelection].enabledSwitches, i) : false;
-                        bool checkbox = found;
-                        ImGui::Checkbox(settings.switchOptions[i].c_str(), &checkbox);
-                        if (checkbox != found)
-                        {
-                            if (found)
-                                RemoveNumberInVector(settings.platformOptions[settings.platformSelection].enabledSwitches, i);
-                            else
-                            {
-                                if (settings.platformSelection < settings.platformOptions.size())
-                                    settings.platformOptions[settings.platformSelection].enabledSwitches.push_back(i);
-                            }
-                        }
-                        last_button_x2 = ImGui::GetItemRectMax().x;
-
-                        OpenModifyingPrompt(settings.switchOptions[i]);
-                    }
-                }
-                ImGui::EndChild();
-
-                ImVec2 executionScale = { 0, 0.35f };
-                ImVec2 executionSize = HadamardProduct(viewport->WorkSize, executionScale);
-                if (ImGui::BeginChild("Building", executionSize, true, sectionFlags))
-                {
-                    ZoneScopedN("Building");
-                    TextCentered("Build Events");
-                    ImGui::SameLine();
-                    HelpMarker("Add programs to be ran before or after the build");
-
-                    static std::string preBuildInput;
-                    if (settings.platformOptions.size())
-                        ExecutionSection("Pre-Build", settings.preBuildEvents, settings.platformOptions[settings.platformSelection].enabledPreBuild, preBuildInput);
-
-                    static std::string postBuildInput;
-                    if (settings.platformOptions.size())
-                        ExecutionSection("Post-Build", settings.postBuildEvents, settings.platformOptions[settings.platformSelection].enabledPostBuild, postBuildInput);
-                }
-                ImGui::EndChild();
-
-                ImVec2 commandScale = { 0, 0.25f };
-                ImVec2 commandSize = HadamardProduct(viewport->WorkSize, commandScale);
-                if (ImGui::BeginChild("Command Line", ImVec2(0, 0), true, sectionFlags))
-                {
-                    ZoneScopedN("Command Line");
-                    TextCentered("Command Line Output");
-
-                    bool invalid_projectPath = settings.projectPath.size() < 10;
-                    bool invalid_rootPath = settings.rootPath.size() < 3;
-                    bool invalid_platformOptions = !(settings.platformOptions.size());
-                    bool invalid_versionSelected = true;
-                    if (!invalid_platformOptions)
-                        invalid_versionSelected = !(settings.platformOptions[settings.platformSelection].enabledVersions.size());
-                    bool commandLineInvalid = invalid_projectPath || invalid_rootPath || invalid_platformOptions || invalid_versionSelected;
-
-                    finalCommandLine.clear();
-                    if (commandLineInvalid)
-                    {
-                        if (invalid_rootPath)
-                        {
-                            finalCommandLine = "Invalid Main Directory";
-                        }
-                        else if (invalid_projectPath)
-                        {
-                            finalCommandLine = "Invalid Project Path";
-                        }
-                        else if (invalid_platformOptions)
-                        {
-                            finalCommandLine = "Invalid Platform Options";
-                        }
-                        else if (invalid_versionSelected)
-                        {
-                            finalCommandLine = "Invalid Version Selected";
-                        }
-                    }
-                    else
-                    {
-#if 1
-                        finalCommandLine += "\"";
-#else
-                        if (keepProcessWindowAlive)
-                            finalCommandLine += "/K ";
-                        else
-                            finalCommandLine += "/c ";
-#endif
-                        finalCommandLine += settings.rootPath.c_str();
-                        finalCommandLine += "Engine/Build/BatchFiles/RunUAT.bat";
-                        finalCommandLine += "\"";
-                        finalCommandLine += " BuildCookRun";
-                        finalCommandLine += " -project=\"";
-                        finalCommandLine += settings.projectPath.c_str();
-                        finalCommandLine += "\"";
-                        finalCommandLine += " -targetplatform=";
-                        finalCommandLine += settings.platformOptions[settings.platformSelection].name;
-                        finalCommandLine += " -clientconfig=";
-                        bool alreadyOneEnabled = false;
-                        for (const auto& optionIndex : settings.platformOptions[settings.platformSelection].enabledVersions)
-                        {
-                            if (settings.versionOptions[optionIndex].empty())
-                                continue;
-                            if (alreadyOneEnabled)
-                                finalCommandLine += "+";
-                            finalCommandLine += settings.versionOptions[optionIndex];
-                            alreadyOneEnabled = true;
-                        }
-
-                        for (const auto& optionIndex : settings.platformOptions[settings.platformSelection].enabledSwitches)
-                        {
-                            finalCommandLine += " -";
-                            finalCommandLine += settings.switchOptions[optionIndex];
-                        }
-                    }
-
-                    ImGui::TextWrapped(finalCommandLine.c_str());
-
-                    if (ImGui::Button("Copy To Clipboard"))
-                    {
-                        SDL_SetClipboardText(finalCommandLine.c_str());
-                    }
-                    std::string logLoc = settings.rootPath + "Engine/Programs/AutomationTool/Saved/Logs/Log.txt";
-                    ImGui::SameLine();
-                    if (ImGui::Button("Open Log"))
-                        RunProcess(logLoc.c_str(), nullptr, true);
-                    //ImGui::SameLine();
-                    if (buildRunning || commandLineInvalid)
-                        ImGui::BeginDisabled();
-                    bool runButtonHit = ImGui::Button("RUN", ImVec2(200.0f, 50.0f));
-                    if (runButtonHit)
-                    {
-                        SubmitProcessList(settings.preBuildEvents,
-                            settings.platformOptions[settings.platformSelection].enabledPreBuild,
-                            threading);
-//#if NDEBUG
-                        //SubmitProcessSingle(finalCommandLine, threading);
-                        RunUATJob* job = new RunUATJob();
-                        SeperatePathAndArguments(finalCommandLine, job->applicationPath, job->arguments);
-                        job->rootPath = settings.rootPath;
-                        threading.SubmitJob(job);
-//#endif
-                        SubmitProcessList(settings.postBuildEvents,
-                            settings.platformOptions[settings.platformSelection].enabledPostBuild,
-                            threading);
-                    }
-                    if (buildRunning || commandLineInvalid)
-                        ImGui::EndDisabled();
-                    //ImGui::Checkbox("Keep UAT CMD Window Open", &keepProcessWindowAlive);
-
-                    ImGui::Text("Application average %.3f ms/frame (%.1f FPS, Target: %.1f FPS)", 1000.0f / io.Framerate, io.Framerate, appSettings.UPS);
-                }
-                ImGui::EndChild();
-
-                if (s_modifyingText)
-                {
-                    if (s_modifyingTextIndex == nullptr)
-                    {
-                        const char* title = "Edit Text";
-                        ImGui::SetNextWindowSize(ImVec2(500.0f, 0), ImGuiCond_Once);
-                        ImGui::OpenPopup(title);
-                        if (ImGui::BeginPopupModal(title))
-                        {
-                            float buttonHeight = 30.0f;
-                            float width = -FLT_MIN;
-                            ImGui::SetNextItemWidth(width);
-                            InputTextDynamicSize("##Modifying Text", *s_modifyingText);
-                            ImVec2 popupSize = ImGui::GetWindowSize();
-                            //TODO: add proper padding (this doesn't properly pad when there is rounding)
-                            if (ImGui::Button("Save", ImVec2((popupSize.x / 2.0f) - (1.5f * style.WindowPadding.x), buttonHeight)))
-                            {
-                                s_modifyingText = nullptr;
-                                s_unmodifiedText.clear();
-                                ImGui::CloseCurrentPopup();
-                            }
-                            ImGui::SameLine();
-                            if (ImGui::Button("Close", ImVec2(-FLT_MIN, buttonHeight)))
-                            {
-                                *s_modifyingText = s_unmodifiedText;
-                                s_modifyingText = nullptr;
-                                s_unmodifiedText.clear();
-                                ImGui::CloseCurrentPopup();
-                            }
-                            ImGui::EndPopup();
-                        }
-                    }
-                    else
-                    {
-                        const char* title = "Name New File";
-                        ImGui::SetNextWindowSize(ImVec2(500.0f, 0), ImGuiCond_Once);
-                        ImGui::OpenPopup(title);
-                        if (ImGui::BeginPopupModal(title))
-                        {
-                            ImGui::Text("Please enter the name of the new file excluding the prefix and the file type, full name of the file below:");
-                            ImGui::Text("File Name: UATHelper%s.json", s_modifyingText->c_str());
-                            float buttonHeight = 30.0f;
-                            float width = -FLT_MIN;
-                            ImGui::SetNextItemWidth(width);
-                            InputTextDynamicSize("##Modifying Text", *s_modifyingText);
-                            ImVec2 popupSize = ImGui::GetWindowSize();
-                            //TODO: add proper padding (this doesn't properly pad when there is rounding)
-                            if (s_modifyingText->size() == 0)
-                                ImGui::BeginDisabled();
-                            if (ImGui::Button("Save", ImVec2((popupSize.x / 2.0f) - (1.5f * style.WindowPadding.x), buttonHeight)))
-                            {
-                                s_modifyingText = nullptr;
-                                s_unmodifiedText.clear();
-                                appSettings.currentFileNameIndex = *s_modifyingTextIndex;
-                                s_modifyingTextIndex = nullptr;
-
-                                std::string& filename = appSettings.fileNames[appSettings.currentFileNameIndex];
-                                filename = "UATHelper" + filename + ".json";
-
-                                //The only time the s_modifyingTextIndex is used is when saving
-                                SaveConfig(settings, appSettings.fileNames[appSettings.currentFileNameIndex]);
-                                LoadConfig(settings, appSettings);
-                                SaveAppSettings(appSettings);
-
-                                //If the save was triggered when the program was trying to close then close the program
-                                if (exitProgram)
-                                    done = true;
-
-                                ImGui::CloseCurrentPopup();
-                            }
-                            if (s_modifyingText && s_modifyingText->size() == 0)
-                                ImGui::EndDisabled();
-                            ImGui::SameLine();
-                            if (ImGui::Button("Close", ImVec2(-FLT_MIN, buttonHeight)))
-                            {
-                                *s_modifyingText = s_unmodifiedText;
-                                s_modifyingText = nullptr;
-                                s_unmodifiedText.clear();
-                                if (*s_modifyingTextIndex >= 0 && *s_modifyingTextIndex < appSettings.fileNames.size() && 
-                                    appSettings.fileNames[*s_modifyingTextIndex].size() < 9 + 5)
-                                    appSettings.fileNames.erase(appSettings.fileNames.begin() + *s_modifyingTextIndex);
-                                s_modifyingTextIndex = nullptr;
-                                ImGui::CloseCurrentPopup();
-                            }
-                            ImGui::EndPopup();
-                        }
-                    }
-                }
-
-
-                //if (s_openConfigSelectionPopup == true)
-                //{
-                //    ImGui::SetNextWindowSize(ImVec2(500.0f, 0), ImGuiCond_Once);
-                //    const char* title = "Select Config";
-                //    ImGui::OpenPopup(title);
-                //    if (ImGui::BeginPopupModal(title))
-                //    {
-                //        ImGui::ListBox("Options", &appSettings.currentFileNameIndex, GetStringFromSTDVector, &appSettings.fileNames, appSettings.fileNames.size()))
-                //        float buttonHeight = 30.0f;
-                //        float width = -FLT_MIN;
-                //        ImGui::SetNextItemWidth(width);
-                //        InputTextDynamicSize("##Modifying Text", *s_modifyingText);
-                //        ImVec2 popupSize = ImGui::GetWindowSize();
-                //        //TODO: add proper padding (this doesn't properly pad when there is rounding)
-                //        if (ImGui::Button("Save", ImVec2((popupSize.x / 2.0f) - (1.5f * style.WindowPadding.x), buttonHeight)))
-                //        {
-                //            s_modifyingText = nullptr;
-                //            s_unmodifiedText.clear();
-                //            if (s_modifyingTextIndex)
-                //            {
-                //                appSettings.currentFileNameIndex = *s_modifyingTextIndex;
-                //                s_modifyingTextIndex = nullptr;
-                //            }
-                //            ImGui::CloseCurrentPopup();
-                //        }
-                //        ImGui::SameLine();
-                //        if (ImGui::Button("Close", ImVec2(-FLT_MIN, buttonHeight)))
-                //        {
-                //            *s_modifyingText = s_unmodifiedText;
-                //            s_modifyingText = nullptr;
-                //            s_unmodifiedText.clear();
-                //            if (s_modifyingTextIndex)
-                //            {
-                //                if (appSettings.fileNames[*s_modifyingTextIndex].size() < 9 + 5 )
-                //                    appSettings.fileNames.erase(appSettings.fileNames.begin() + *s_modifyingTextIndex);
-                //                s_modifyingTextIndex = nullptr;
-                //            }
-                //            ImGui::CloseCurrentPopup();
-                //        }
-                //        ImGui::EndPopup();
-                //    }
-                //}
-
-                if (exitProgram)
-                {
-                    if (!ConfigIsSameAsLastLoad(settings))
-                    {
-                        ImGuiWindowFlags flags =
-                            ImGuiWindowFlags_NoCollapse |
-                            ImGuiWindowFlags_NoSavedSettings;
-                        const ImVec2 min = { 260, 100 };
-                        const ImVec2 windowSize = ImGui::GetMainViewport()->Size;
-                        const ImVec2 max = { windowSize.x - 200, windowSize.y - 200 };
-                        ImGui::SetNextWindowSizeConstraints(min, max);
-                        ImGui::SetNextWindowPos(ImVec2(windowSize.x / 2, windowSize.y / 2), ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
-                        const char* popupName = "Unsaved Changes";
-                        ImGui::OpenPopup(popupName, ImGuiPopupFlags_None);
-                        if (ImGui::BeginPopupModal(popupName, &exitProgram, flags))
-                        {
-                            float buttonHeight = 30.0f;
-                            ImGui::TextWrapped("The application is being closed without being saved, are you sure you want to continue?");
-                            if (ImGui::Button("Save and Exit", ImVec2(-FLT_MIN, buttonHeight)))
-                            {
-                                SaveCurrentOrCreateNewConfig(appSettings, settings);
-                                //done = true;
-                            }
-                            ImVec2 saveButtonSize = ImGui::GetItemRectSize();
-                            if (ImGui::Button("Exit Without Saving", ImVec2(saveButtonSize.x * (2.0f / 3.0f), buttonHeight)))
-                            {
-                                done = true;
-                            }
-                            ImGui::SameLine();
-                            if (ImGui::Button("Cancel", ImVec2(-FLT_MIN, buttonHeight)))
-                            {
-                                ImGui::CloseCurrentPopup();
-                                exitProgram = false;
-                            }
-                            ImGui::EndPopup();
-                        }
-                    }
-                    else
-                    {
-                        done = true;
-                    }
-                }
-
-                ImGui::End();
-            }
-
-
-            if (show_demo_window)
-                ImGui::ShowDemoWindow(&show_demo_window);
+            UpdateUI(ui, settings, appSettings, buildQueue, threading);
 
             {
                 ZoneScopedN("ImGui Render");
@@ -1311,6 +256,8 @@ int main(int, char**)
             SDL_GL_SwapWindow(window);
         }
         FrameMark;
+        ui.lastFrameAllocations = GetThreadAllocations() - frameStartAllocations;
+        TracyPlot("Frame Allocations", s64(ui.lastFrameAllocations.allocations));
         u64 frameEndTicks = SDL_GetTicks64();
         float MSPerUpdate = ((1.0f / appSettings.UPS) * 1000.0f);
         u64 delayAmount = (u64)((u64)MSPerUpdate - (frameEndTicks - frameStartTicks));
@@ -1319,6 +266,13 @@ int main(int, char**)
     }
 
     // Cleanup
+    //NOTE(CSH): the build thread is joined on exit, a running build is stopped instead of waited on.
+    //Its request stays at the front of the saved queue so the next start runs it again
+    buildQueue.Cancel();
+    UpdateAppSettingsSave(appSettings, true);
+    if (recordFile)
+        SaveInputRecording(recordFile, recording);
+    AsyncFileWriter::GetInstance().Flush();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
@@ -15,6 +15,7 @@ project "UATHelper"
        "SDL2",
        "SDL2main",
        "OpenGL32",
+       "Advapi32",
    }
 
    libdirs {
@@ -60,6 +61,77 @@ project "UATHelper"
     }
 
 
+   filter "configurations:Debug"
+      defines { "DEBUG", "TRACY_ENABLE"}
+      symbols  "On"
+      optimize "Off"
+
+   filter "configurations:Profile"
+      defines { "NDEBUG", "TRACY_ENABLE", "TRACK_ALLOCATIONS"}
+      symbols  "on"
+      optimize "Speed"
+
+   filter "configurations:Release"
+      defines { "NDEBUG" }
+      symbols  "on"
+      optimize "Speed"
+
+--NOTE(CSH): benchmarks link everything but main.cpp so they run the same code as the app
+project "UATHelperBench"
+   kind "ConsoleApp"
+   language "C++"
+   cppdialect "C++latest"
+   targetdir "Build/%{cfg.platform}/%{cfg.buildcfg}"
+   objdir "Build/obj/%{cfg.platform}/%{cfg.buildcfg}/Bench"
+   editandcontinue "Off"
+   characterset "ASCII"
+   links {
+       "SDL2",
+       "OpenGL32",
+       "Advapi32",
+   }
+
+   libdirs {
+       "Contrib/SDL/lib/%{cfg.platform}/",
+       "Contrib/imgui",
+       "Contrib/tracy-master",
+   }
+   includedirs {
+       "Source",
+       "Contrib",
+       "Contrib/imgui",
+       "Contrib/SDL/include",
+       "Contrib/tracy-master/public/tracy",
+       "Contrib/json.hpp",
+   }
+   flags {
+       "MultiProcessorCompile",
+       "FatalWarnings",
+       "NoPCH",
+   }
+   defines {
+       "_CRT_SECURE_NO_WARNINGS",
+       "SDL_MAIN_HANDLED",
+       "TRACK_ALLOCATIONS",
+   }
+   files {
+       "Benchmarks/**",
+       "Source/**",
+       "Contrib/tracy-master/public/TracyClient.cpp",
+       "Contrib/imgui/*.cpp",
+       "Contrib/imgui/*.h",
+       "Contrib/imgui/backends/imgui_impl_opengl3.*",
+       "contrib/ImGui/backends/imgui_impl_sdl2.*",
+   }
+   removefiles {
+       "Source/main.cpp",
+   }
+
+    postbuildcommands
+    {
+        "{COPY} Contrib/SDL/lib/%{cfg.platform}/SDL2.dll %{cfg.targetdir}"
+    }
+
    filter "configurations:Debug"
       defines { "DEBUG", "TRACY_ENABLE"}
       symbols  "On"